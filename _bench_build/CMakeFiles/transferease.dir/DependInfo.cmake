@@ -0,0 +1,47 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/logs/abstractlogger.cpp" "CMakeFiles/transferease.dir/src/logs/abstractlogger.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/logs/abstractlogger.cpp.o.d"
+  "/root/repo/src/net/bytesarray.cpp" "CMakeFiles/transferease.dir/src/net/bytesarray.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/bytesarray.cpp.o.d"
+  "/root/repo/src/net/callbackdispatcher.cpp" "CMakeFiles/transferease.dir/src/net/callbackdispatcher.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/callbackdispatcher.cpp.o.d"
+  "/root/repo/src/net/concurrencycontroller.cpp" "CMakeFiles/transferease.dir/src/net/concurrencycontroller.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/concurrencycontroller.cpp.o.d"
+  "/root/repo/src/net/contentstore.cpp" "CMakeFiles/transferease.dir/src/net/contentstore.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/contentstore.cpp.o.d"
+  "/root/repo/src/net/directorycache.cpp" "CMakeFiles/transferease.dir/src/net/directorycache.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/directorycache.cpp.o.d"
+  "/root/repo/src/net/dnscache.cpp" "CMakeFiles/transferease.dir/src/net/dnscache.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/dnscache.cpp.o.d"
+  "/root/repo/src/net/handle.cpp" "CMakeFiles/transferease.dir/src/net/handle.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/handle.cpp.o.d"
+  "/root/repo/src/net/handletemplates.cpp" "CMakeFiles/transferease.dir/src/net/handletemplates.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/handletemplates.cpp.o.d"
+  "/root/repo/src/net/httpcache.cpp" "CMakeFiles/transferease.dir/src/net/httpcache.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/httpcache.cpp.o.d"
+  "/root/repo/src/net/latencytracker.cpp" "CMakeFiles/transferease.dir/src/net/latencytracker.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/latencytracker.cpp.o.d"
+  "/root/repo/src/net/mappedfile.cpp" "CMakeFiles/transferease.dir/src/net/mappedfile.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/mappedfile.cpp.o.d"
+  "/root/repo/src/net/progressaggregator.cpp" "CMakeFiles/transferease.dir/src/net/progressaggregator.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/progressaggregator.cpp.o.d"
+  "/root/repo/src/net/request.cpp" "CMakeFiles/transferease.dir/src/net/request.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/request.cpp.o.d"
+  "/root/repo/src/net/sharehandle.cpp" "CMakeFiles/transferease.dir/src/net/sharehandle.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/sharehandle.cpp.o.d"
+  "/root/repo/src/net/streamencoder.cpp" "CMakeFiles/transferease.dir/src/net/streamencoder.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/streamencoder.cpp.o.d"
+  "/root/repo/src/net/url.cpp" "CMakeFiles/transferease.dir/src/net/url.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/net/url.cpp.o.d"
+  "/root/repo/src/tools/digest.cpp" "CMakeFiles/transferease.dir/src/tools/digest.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/tools/digest.cpp.o.d"
+  "/root/repo/src/tools/filesystemhelper.cpp" "CMakeFiles/transferease.dir/src/tools/filesystemhelper.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/tools/filesystemhelper.cpp.o.d"
+  "/root/repo/src/tools/stringhelper.cpp" "CMakeFiles/transferease.dir/src/tools/stringhelper.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/tools/stringhelper.cpp.o.d"
+  "/root/repo/src/transfermanager.cpp" "CMakeFiles/transferease.dir/src/transfermanager.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/transfermanager.cpp.o.d"
+  "/root/repo/src/version/semver.cpp" "CMakeFiles/transferease.dir/src/version/semver.cpp.o" "gcc" "CMakeFiles/transferease.dir/src/version/semver.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/build/output/lib/libtransferease.so" "/root/repo/build/output/lib/libtransferease.so.0.0.1"
+  "/root/repo/build/output/lib/libtransferease.so.0" "/root/repo/build/output/lib/libtransferease.so.0.0.1"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/lib/libtransferease.pdb"
+  "/root/repo/build/output/lib/libtransferease.so"
+  "/root/repo/build/output/lib/libtransferease.so.0"
+  "/root/repo/build/output/lib/libtransferease.so.0.0.1"
+  "CMakeFiles/transferease.dir/src/logs/abstractlogger.cpp.o"
+  "CMakeFiles/transferease.dir/src/logs/abstractlogger.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/bytesarray.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/bytesarray.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/callbackdispatcher.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/callbackdispatcher.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/concurrencycontroller.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/concurrencycontroller.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/contentstore.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/contentstore.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/directorycache.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/directorycache.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/dnscache.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/dnscache.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/handle.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/handle.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/handletemplates.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/handletemplates.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/httpcache.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/httpcache.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/latencytracker.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/latencytracker.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/mappedfile.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/mappedfile.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/progressaggregator.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/progressaggregator.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/request.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/request.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/sharehandle.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/sharehandle.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/streamencoder.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/streamencoder.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/net/url.cpp.o"
+  "CMakeFiles/transferease.dir/src/net/url.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/tools/digest.cpp.o"
+  "CMakeFiles/transferease.dir/src/tools/digest.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/tools/filesystemhelper.cpp.o"
+  "CMakeFiles/transferease.dir/src/tools/filesystemhelper.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/tools/stringhelper.cpp.o"
+  "CMakeFiles/transferease.dir/src/tools/stringhelper.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/transfermanager.cpp.o"
+  "CMakeFiles/transferease.dir/src/transfermanager.cpp.o.d"
+  "CMakeFiles/transferease.dir/src/version/semver.cpp.o"
+  "CMakeFiles/transferease.dir/src/version/semver.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/transferease.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/bin/bench_ftp_batch"
+  "/root/repo/build/output/bin/bench_ftp_batch.pdb"
+  "CMakeFiles/bench_ftp_batch.dir/bench_ftp_batch.cpp.o"
+  "CMakeFiles/bench_ftp_batch.dir/bench_ftp_batch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_ftp_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
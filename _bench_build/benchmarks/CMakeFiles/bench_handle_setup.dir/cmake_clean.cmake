@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/bin/bench_handle_setup"
+  "/root/repo/build/output/bin/bench_handle_setup.pdb"
+  "CMakeFiles/bench_handle_setup.dir/bench_handle_setup.cpp.o"
+  "CMakeFiles/bench_handle_setup.dir/bench_handle_setup.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_handle_setup.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
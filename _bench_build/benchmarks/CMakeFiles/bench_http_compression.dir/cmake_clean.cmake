@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/bin/bench_http_compression"
+  "/root/repo/build/output/bin/bench_http_compression.pdb"
+  "CMakeFiles/bench_http_compression.dir/bench_http_compression.cpp.o"
+  "CMakeFiles/bench_http_compression.dir/bench_http_compression.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_http_compression.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
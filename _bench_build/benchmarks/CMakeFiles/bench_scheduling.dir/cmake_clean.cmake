@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/bin/bench_scheduling"
+  "/root/repo/build/output/bin/bench_scheduling.pdb"
+  "CMakeFiles/bench_scheduling.dir/bench_scheduling.cpp.o"
+  "CMakeFiles/bench_scheduling.dir/bench_scheduling.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_scheduling.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/net/bytesarray_tests.cpp" "tests/CMakeFiles/transferease-tests.dir/net/bytesarray_tests.cpp.o" "gcc" "tests/CMakeFiles/transferease-tests.dir/net/bytesarray_tests.cpp.o.d"
+  "/root/repo/tests/net/url_tests.cpp" "tests/CMakeFiles/transferease-tests.dir/net/url_tests.cpp.o" "gcc" "tests/CMakeFiles/transferease-tests.dir/net/url_tests.cpp.o.d"
+  "/root/repo/tests/testshelper.cpp" "tests/CMakeFiles/transferease-tests.dir/testshelper.cpp.o" "gcc" "tests/CMakeFiles/transferease-tests.dir/testshelper.cpp.o.d"
+  "/root/repo/tests/tools/enumflag_tests.cpp" "tests/CMakeFiles/transferease-tests.dir/tools/enumflag_tests.cpp.o" "gcc" "tests/CMakeFiles/transferease-tests.dir/tools/enumflag_tests.cpp.o.d"
+  "/root/repo/tests/version/semver_tests.cpp" "tests/CMakeFiles/transferease-tests.dir/version/semver_tests.cpp.o" "gcc" "tests/CMakeFiles/transferease-tests.dir/version/semver_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/CMakeFiles/transferease.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/output/bin/transferease-tests"
+  "/root/repo/build/output/bin/transferease-tests.pdb"
+  "CMakeFiles/transferease-tests.dir/net/bytesarray_tests.cpp.o"
+  "CMakeFiles/transferease-tests.dir/net/bytesarray_tests.cpp.o.d"
+  "CMakeFiles/transferease-tests.dir/net/url_tests.cpp.o"
+  "CMakeFiles/transferease-tests.dir/net/url_tests.cpp.o.d"
+  "CMakeFiles/transferease-tests.dir/testshelper.cpp.o"
+  "CMakeFiles/transferease-tests.dir/testshelper.cpp.o.d"
+  "CMakeFiles/transferease-tests.dir/tools/enumflag_tests.cpp.o"
+  "CMakeFiles/transferease-tests.dir/tools/enumflag_tests.cpp.o.d"
+  "CMakeFiles/transferease-tests.dir/version/semver_tests.cpp.o"
+  "CMakeFiles/transferease-tests.dir/version/semver_tests.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/transferease-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
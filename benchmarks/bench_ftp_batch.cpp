@@ -0,0 +1,117 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "benchhelper.h"
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define DEFAULT_NB_FILES    200
+#define DEFAULT_DEPTH       4
+#define FILE_SIZE           1024 /**< Unit in bytes */
+
+/*****************************/
+/* Benchmark description     */
+/*****************************/
+
+/*
+ * Measure cost of FTP methods on a batch of small files located in a deep
+ * directory (so that each directory change cost several round trips).
+ *
+ * Usage: bench_ftp_batch <ftp-url> <username> <password> [nb-files] [depth]
+ * - ftp-url: Base URL where files will be uploaded (example: ftp://127.0.0.1:2121/bench)
+ *
+ * Files are first uploaded (with directories creation), then downloaded
+ * with each available FTP method.
+ */
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+static std::string createDirPath(const std::string &urlBase, int depth)
+{
+    std::string path = urlBase;
+    for(int i = 0; i < depth; ++i){
+        path += "/dir" + std::to_string(i);
+    }
+
+    return path;
+}
+
+static tease::Request::List createRequests(tease::Request::TypeTransfer typeTransfer, const std::string &dirPath, int nbFiles)
+{
+    tease::Request::List listReqs;
+    for(int i = 0; i < nbFiles; ++i){
+        const tease::Url url(dirPath + "/file" + std::to_string(i) + ".bin");
+
+        auto req = std::make_shared<tease::Request>();
+        if(typeTransfer == tease::Request::TRANSFER_UPLOAD){
+            req->configureUpload(url, tease::BytesArray(FILE_SIZE, static_cast<tease::BytesArray::Byte>(i)));
+        }else{
+            req->configureDownload(url);
+        }
+
+        listReqs.push_back(req);
+    }
+
+    return listReqs;
+}
+
+static void printResult(const std::string &name, const BenchRunner::Result &result, int nbFiles)
+{
+    if(result.idErr != tease::TransferManager::ERR_NO_ERROR){
+        std::cout << name << ": failed [" << tease::TransferManager::idErrorToStr(result.idErr) << "]" << std::endl;
+        return;
+    }
+
+    std::cout << name << ": " << result.duration << " s (" << nbFiles / result.duration << " files/s)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    /* Parse arguments */
+    if(argc < 4){
+        std::cerr << "Usage: " << argv[0] << " <ftp-url> <username> <password> [nb-files] [depth]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string urlBase = argv[1];
+    const int nbFiles = (argc > 4) ? std::atoi(argv[4]) : DEFAULT_NB_FILES;
+    const int depth = (argc > 5) ? std::atoi(argv[5]) : DEFAULT_DEPTH;
+    const std::string dirPath = createDirPath(urlBase, depth);
+
+    tease::TransferManager manager;
+    manager.setUserInfos(argv[2], argv[3]);
+    manager.setNbMaxTransfersPerHost(4);
+
+    BenchRunner runner(manager);
+
+    /* Upload files */
+    manager.setOptions(tease::TransferManager::OPT_FTP_CREATE_DIRS);
+
+    const BenchRunner::Result resUpload = runner.run(tease::Request::TRANSFER_UPLOAD, createRequests(tease::Request::TRANSFER_UPLOAD, dirPath, nbFiles));
+    printResult("upload (create dirs)", resUpload, nbFiles);
+    if(resUpload.idErr != tease::TransferManager::ERR_NO_ERROR){
+        return EXIT_FAILURE;
+    }
+
+    manager.setOptions(tease::TransferManager::OPT_NONE);
+
+    /* Download files with each method */
+    const std::pair<tease::TransferManager::TypeFtpMethod, const char*> listMethods[] = {
+        {tease::TransferManager::FTP_METHOD_MULTICWD,  "download (multi-cwd)"},
+        {tease::TransferManager::FTP_METHOD_SINGLECWD, "download (single-cwd)"},
+        {tease::TransferManager::FTP_METHOD_NOCWD,     "download (no-cwd)"}
+    };
+
+    for(const auto &method : listMethods){
+        manager.setFtpMethod(method.first);
+
+        const BenchRunner::Result result = runner.run(tease::Request::TRANSFER_DOWNLOAD, createRequests(tease::Request::TRANSFER_DOWNLOAD, dirPath, nbFiles));
+        printResult(method.second, result, nbFiles);
+    }
+
+    return EXIT_SUCCESS;
+}
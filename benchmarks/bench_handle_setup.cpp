@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <curl/curl.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "transferease/transfermanager.h"
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define DEFAULT_NB_REQUESTS 10000
+#define DEFAULT_NB_ROUNDS   5
+#define NB_TRANSFERS        1000
+
+/*****************************/
+/* Benchmark description     */
+/*****************************/
+
+/*
+ * Measure cost of easy handles setup per batch of requests, when each
+ * handle is fully configured and when it is cloned from a template
+ * handle (as done by the transfer manager).
+ *
+ * Usage: bench_handle_setup [url] [nb-requests] [nb-rounds]
+ * - url: URL of a small ressource served by an HTTP server (example:
+ * http://127.0.0.1:8080/small.bin). If set, this ressource is also
+ * downloaded with TransferManager::transferNow() to compare setup cost
+ * with whole transfer cost.
+ *
+ * Setup applies the same options than the transfer manager for HTTP
+ * downloads. Handles are created, configured and cleaned without being
+ * performed, median duration of the rounds is printed.
+ */
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+static size_t curlCbWrite(TEASE_VAR_UNUSED char *ptr, size_t size, size_t nmemb, TEASE_VAR_UNUSED void *userdata)
+{
+    return size * nmemb;
+}
+
+static int curlCbProgress(TEASE_VAR_UNUSED void *clientp, TEASE_VAR_UNUSED curl_off_t dltotal, TEASE_VAR_UNUSED curl_off_t dlnow, TEASE_VAR_UNUSED curl_off_t ultotal, TEASE_VAR_UNUSED curl_off_t ulnow)
+{
+    return 0;
+}
+
+static void configureCommon(CURL *handle)
+{
+    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, 60L);
+    curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlCbWrite);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+    curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, curlCbProgress);
+    curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 10L);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, 30L);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, 10L);
+}
+
+static void configureRequest(CURL *handle, CURLSH *share, const tease::Url &url, void *userdata)
+{
+    curl_easy_setopt(handle, CURLOPT_URL, url.toString().c_str());
+    curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, userdata);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, userdata);
+    curl_easy_setopt(handle, CURLOPT_XFERINFODATA, userdata);
+}
+
+static double measureSetup(const std::vector<tease::Url> &listUrls, CURLSH *share, CURL *handleTemplate)
+{
+    int userdata = 0;
+    const auto tsStart = std::chrono::steady_clock::now();
+
+    for(const tease::Url &url : listUrls){
+        CURL *handle = nullptr;
+        if(handleTemplate){
+            handle = curl_easy_duphandle(handleTemplate);
+        }else{
+            handle = curl_easy_init();
+            configureCommon(handle);
+        }
+
+        configureRequest(handle, share, url, &userdata);
+        curl_easy_cleanup(handle);
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - tsStart).count();
+}
+
+static void printSetup(const std::string &name, std::vector<double> &listDurations, size_t nbRequests)
+{
+    std::sort(listDurations.begin(), listDurations.end());
+    const double median = listDurations[listDurations.size() / 2];
+
+    std::cout << name << ": " << median * 1e3 * 10000 / nbRequests << " ms per 10k requests, "
+              << median * 1e6 / nbRequests << " us per request" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    /* Parse arguments */
+    const std::string urlRes = (argc > 1) ? argv[1] : "";
+    const int nbRequests = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_NB_REQUESTS;
+    const int nbRounds = (argc > 3) ? std::atoi(argv[3]) : DEFAULT_NB_ROUNDS;
+
+    if(nbRequests <= 0 || nbRounds <= 0){
+        std::cerr << "Usage: " << argv[0] << " [url] [nb-requests] [nb-rounds]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* Prepare requests URLs */
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    std::vector<tease::Url> listUrls;
+    listUrls.reserve(nbRequests);
+    for(int i = 0; i < nbRequests; ++i){
+        listUrls.emplace_back("http://127.0.0.1:8080/bench/file" + std::to_string(i) + ".bin");
+    }
+
+    CURLSH *share = curl_share_init();
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+
+    CURL *handleTemplate = curl_easy_init();
+    configureCommon(handleTemplate);
+
+    /* Measure setup cost (rounds are interleaved to share same conditions) */
+    std::vector<double> listFull, listTemplate;
+    for(int i = 0; i < nbRounds; ++i){
+        listFull.push_back(measureSetup(listUrls, share, nullptr));
+        listTemplate.push_back(measureSetup(listUrls, share, handleTemplate));
+    }
+
+    printSetup("setup (full configuration)", listFull, listUrls.size());
+    printSetup("setup (cloned from template)", listTemplate, listUrls.size());
+
+    curl_easy_cleanup(handleTemplate);
+    curl_share_cleanup(share);
+
+    /* Compare with cost of whole transfers */
+    if(!urlRes.empty()){
+        tease::TransferManager manager;
+
+        auto req = std::make_shared<tease::Request>();
+        req->configureDownload(tease::Url(urlRes));
+
+        // Open connection before measuring
+        tease::TransferManager::IdError idErr = manager.transferNow(req);
+
+        const auto tsStart = std::chrono::steady_clock::now();
+        for(int i = 0; i < NB_TRANSFERS && idErr == tease::TransferManager::ERR_NO_ERROR; ++i){
+            idErr = manager.transferNow(req);
+        }
+        const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - tsStart).count();
+
+        if(idErr != tease::TransferManager::ERR_NO_ERROR){
+            std::cout << "transfer: failed [" << tease::TransferManager::idErrorToStr(idErr) << "]" << std::endl;
+        }else{
+            std::cout << "transfer: " << duration * 1e6 / NB_TRANSFERS << " us per request" << std::endl;
+        }
+    }
+
+    curl_global_cleanup();
+    return EXIT_SUCCESS;
+}
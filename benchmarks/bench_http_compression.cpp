@@ -0,0 +1,137 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "benchhelper.h"
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define DEFAULT_NB_FILES    20
+#define UPLOAD_NB_ROWS      20000
+
+/*****************************/
+/* Benchmark description     */
+/*****************************/
+
+/*
+ * Measure compression ratio and throughput of HTTP transfers, with and
+ * without compression.
+ *
+ * Usage: bench_http_compression <download-url> <upload-url> [nb-files]
+ * - download-url: URL of a text ressource (JSON, CSV, logs, etc...) served by an
+ * HTTP server supporting compressed responses (example: http://127.0.0.1:8080/data.json)
+ * - upload-url: Base URL where files will be uploaded with PUT method, server
+ * must decode Content-Encoding of requests (example: http://127.0.0.1:8080/upload)
+ *
+ * Raw size is the size of datas, wire size is the number of bytes really
+ * transferred, throughput is computed on raw datas.
+ */
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+static tease::BytesArray createTextData()
+{
+    tease::BytesArray data;
+    for(int i = 0; i < UPLOAD_NB_ROWS; ++i){
+        const std::string row = "{\"id\":" + std::to_string(i) + ",\"name\":\"item" + std::to_string(i) + "\",\"value\":" + std::to_string((i * 7919) % 10007) + "}\n";
+        data.pushBack(row);
+    }
+
+    return data;
+}
+
+static tease::Request::List createRequests(tease::Request::TypeTransfer typeTransfer, const std::string &url, int nbFiles)
+{
+    const tease::BytesArray data = (typeTransfer == tease::Request::TRANSFER_UPLOAD) ? createTextData() : tease::BytesArray();
+
+    tease::Request::List listReqs;
+    for(int i = 0; i < nbFiles; ++i){
+        auto req = std::make_shared<tease::Request>();
+        if(typeTransfer == tease::Request::TRANSFER_UPLOAD){
+            req->configureUpload(tease::Url(url + "/file" + std::to_string(i) + ".json"), data);
+        }else{
+            req->configureDownload(tease::Url(url));
+        }
+
+        listReqs.push_back(req);
+    }
+
+    return listReqs;
+}
+
+static void printResult(const std::string &name, const BenchRunner::Result &result, const tease::Request::List &listReqs)
+{
+    if(result.idErr != tease::TransferManager::ERR_NO_ERROR){
+        std::cout << name << ": failed [" << tease::TransferManager::idErrorToStr(result.idErr) << "]" << std::endl;
+        return;
+    }
+
+    size_t sizeRaw = 0, sizeWire = 0;
+    for(const auto &req : listReqs){
+        sizeRaw += req->getData().getSize();
+        sizeWire += req->ioGetSizeWire();
+    }
+
+    const double ratio = sizeWire > 0 ? static_cast<double>(sizeRaw) / sizeWire : 0.0;
+    const double throughput = sizeRaw / result.duration / (1024.0 * 1024.0);
+
+    std::cout << name << ": raw " << sizeRaw << " bytes, wire " << sizeWire << " bytes, ratio " << ratio
+              << ", " << result.duration << " s (" << throughput << " MiB/s)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    /* Parse arguments */
+    if(argc < 3){
+        std::cerr << "Usage: " << argv[0] << " <download-url> <upload-url> [nb-files]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string urlDownload = argv[1];
+    const std::string urlUpload = argv[2];
+    const int nbFiles = (argc > 3) ? std::atoi(argv[3]) : DEFAULT_NB_FILES;
+
+    tease::TransferManager manager;
+    manager.setNbMaxTransfersPerHost(4);
+
+    BenchRunner runner(manager);
+
+    /* Download with and without compression */
+    const std::pair<tease::TransferManager::FlagOption, const char*> listOptions[] = {
+        {tease::TransferManager::OPT_NONE,             "download (identity)"},
+        {tease::TransferManager::OPT_HTTP_COMPRESSION, "download (compressed)"}
+    };
+
+    for(const auto &option : listOptions){
+        manager.setOptions(option.first);
+
+        const tease::Request::List listReqs = createRequests(tease::Request::TRANSFER_DOWNLOAD, urlDownload, nbFiles);
+        printResult(option.second, runner.run(tease::Request::TRANSFER_DOWNLOAD, listReqs), listReqs);
+    }
+
+    manager.setOptions(tease::TransferManager::OPT_NONE);
+
+    /* Upload with each available encoding */
+    const std::pair<tease::TransferManager::TypeEncoding, const char*> listEncodings[] = {
+        {tease::TransferManager::ENCODING_NONE, "upload (identity)"},
+        {tease::TransferManager::ENCODING_GZIP, "upload (gzip)"},
+        {tease::TransferManager::ENCODING_ZSTD, "upload (zstd)"}
+    };
+
+    for(const auto &encoding : listEncodings){
+        if(!tease::TransferManager::encodingIsSupported(encoding.first)){
+            std::cout << encoding.second << ": not supported by this build" << std::endl;
+            continue;
+        }
+
+        manager.setUploadEncoding(encoding.first);
+
+        const tease::Request::List listReqs = createRequests(tease::Request::TRANSFER_UPLOAD, urlUpload, nbFiles);
+        printResult(encoding.second, runner.run(tease::Request::TRANSFER_UPLOAD, listReqs), listReqs);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "benchhelper.h"
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define DEFAULT_NB_SMALL    200
+#define DEFAULT_NB_LARGE    4
+#define SMALL_SIZE          (16 * 1024)         /**< Unit in bytes */
+#define LARGE_SIZE          (16 * 1024 * 1024)  /**< Unit in bytes */
+#define NB_MAX_PER_HOST     2
+
+/*****************************/
+/* Benchmark description     */
+/*****************************/
+
+/*
+ * Measure effect of scheduling policies on a batch with a skewed size
+ * distribution: few large files listed first, then many small ones.
+ *
+ * Usage: bench_scheduling <url> [username] [password] [nb-small] [nb-large]
+ * - url: Base URL where files will be uploaded then downloaded, server must
+ * serve uploaded files (example: ftp://127.0.0.1:2121/bench)
+ *
+ * Files are uploaded, then downloaded (with sizes prefetched) with each
+ * scheduling policy. Number of simultaneous transfers is limited, so that
+ * requests have to wait for a slot. Mean completion time is the mean of
+ * the durations after which each request is completed, total duration is
+ * the completion time of the last one.
+ */
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+class CompletionTracker
+{
+public:
+    explicit CompletionTracker(tease::TransferManager &manager)
+    {
+        manager.setCbProgressInfos([this](tease::Request::TypeTransfer, const tease::TransferManager::Progress &progress){
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_tsStart).count();
+            if(progress.nbCompleted > m_nbCompleted){
+                m_sumCompletion += elapsed * (progress.nbCompleted - m_nbCompleted);
+                m_nbCompleted = progress.nbCompleted;
+            }
+        });
+    }
+
+public:
+    void reset()
+    {
+        m_tsStart = std::chrono::steady_clock::now();
+        m_nbCompleted = 0;
+        m_sumCompletion = 0.0;
+    }
+
+    double getMeanCompletion() const
+    {
+        return m_nbCompleted > 0 ? m_sumCompletion / m_nbCompleted : 0.0;
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_tsStart;
+    size_t m_nbCompleted = 0;
+    double m_sumCompletion = 0.0;
+};
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+static tease::Request::List createRequests(tease::Request::TypeTransfer typeTransfer, const std::string &urlBase, int nbSmall, int nbLarge)
+{
+    tease::Request::List listReqs;
+    for(int i = 0; i < nbLarge + nbSmall; ++i){
+        const bool isLarge = (i < nbLarge);
+        const tease::Url url(urlBase + (isLarge ? "/large" : "/small") + std::to_string(i) + ".bin");
+
+        auto req = std::make_shared<tease::Request>();
+        if(typeTransfer == tease::Request::TRANSFER_UPLOAD){
+            req->configureUpload(url, tease::BytesArray(isLarge ? LARGE_SIZE : SMALL_SIZE, static_cast<tease::BytesArray::Byte>(i)));
+        }else{
+            req->configureDownload(url);
+        }
+
+        listReqs.push_back(req);
+    }
+
+    return listReqs;
+}
+
+static void printResult(const std::string &name, const BenchRunner::Result &result, const CompletionTracker &tracker)
+{
+    if(result.idErr != tease::TransferManager::ERR_NO_ERROR){
+        std::cout << name << ": failed [" << tease::TransferManager::idErrorToStr(result.idErr) << "]" << std::endl;
+        return;
+    }
+
+    std::cout << name << ": mean completion " << tracker.getMeanCompletion() << " s, total " << result.duration << " s" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    /* Parse arguments */
+    if(argc < 2){
+        std::cerr << "Usage: " << argv[0] << " <url> [username] [password] [nb-small] [nb-large]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string urlBase = argv[1];
+    const std::string username = (argc > 2) ? argv[2] : "";
+    const std::string password = (argc > 3) ? argv[3] : "";
+    const int nbSmall = (argc > 4) ? std::atoi(argv[4]) : DEFAULT_NB_SMALL;
+    const int nbLarge = (argc > 5) ? std::atoi(argv[5]) : DEFAULT_NB_LARGE;
+
+    tease::TransferManager manager;
+    manager.setUserInfos(username, password);
+    manager.setOptions(tease::TransferManager::OPT_FTP_CREATE_DIRS | tease::TransferManager::OPT_PREFETCH_SIZES);
+    manager.setNbMaxTransfersPerHost(NB_MAX_PER_HOST);
+
+    BenchRunner runner(manager);
+    CompletionTracker tracker(manager);
+
+    /* Run each policy on uploads (sizes known from datas) and downloads (sizes prefetched) */
+    const std::pair<tease::TransferManager::TypeScheduling, const char*> listPolicies[] = {
+        {tease::TransferManager::SCHEDULING_GROUPED,            "grouped"},
+        {tease::TransferManager::SCHEDULING_SHORTEST_FIRST,     "shortest-first"},
+        {tease::TransferManager::SCHEDULING_LARGEST_FIRST,      "largest-first"},
+        {tease::TransferManager::SCHEDULING_ROUND_ROBIN_HOSTS,  "round-robin-hosts"}
+    };
+
+    for(const auto &policy : listPolicies){
+        manager.setSchedulingPolicy(policy.first);
+
+        const tease::Request::List listUploads = createRequests(tease::Request::TRANSFER_UPLOAD, urlBase, nbSmall, nbLarge);
+        tracker.reset();
+        printResult(std::string("upload (") + policy.second + ")", runner.run(tease::Request::TRANSFER_UPLOAD, listUploads), tracker);
+
+        const tease::Request::List listDownloads = createRequests(tease::Request::TRANSFER_DOWNLOAD, urlBase, nbSmall, nbLarge);
+        tracker.reset();
+        printResult(std::string("download (") + policy.second + ")", runner.run(tease::Request::TRANSFER_DOWNLOAD, listDownloads), tracker);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#ifndef TEASE_BENCHMARKS_BENCHHELPER_H
+#define TEASE_BENCHMARKS_BENCHHELPER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "transferease/transfermanager.h"
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \brief Helper used to perform a batch of requests
+ * synchronously and measure its duration
+ */
+class BenchRunner
+{
+public:
+    struct Result
+    {
+        tease::TransferManager::IdError idErr = tease::TransferManager::ERR_NO_ERROR;
+        double duration = 0.0; /**< Unit in seconds */
+    };
+
+public:
+    explicit BenchRunner(tease::TransferManager &manager) : m_manager(manager)
+    {
+        m_manager.setCbProgress([](tease::Request::TypeTransfer, size_t, size_t){});
+        m_manager.setCbCompleted([this](tease::Request::TypeTransfer){
+            notify(tease::TransferManager::ERR_NO_ERROR);
+        });
+        m_manager.setCbFailed([this](tease::Request::TypeTransfer, tease::TransferManager::IdError idErr){
+            notify(idErr);
+        });
+    }
+
+public:
+    Result run(tease::Request::TypeTransfer typeTransfer, const tease::Request::List &listReqs)
+    {
+        Result result;
+        const auto tsStart = std::chrono::steady_clock::now();
+
+        /* Start transfer */
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_done = false;
+        }
+
+        result.idErr = (typeTransfer == tease::Request::TRANSFER_UPLOAD) ? m_manager.startUpload(listReqs) : m_manager.startDownload(listReqs);
+        if(result.idErr != tease::TransferManager::ERR_NO_ERROR){
+            return result;
+        }
+
+        /* Wait for its completion */
+        std::unique_lock<std::mutex> locker(m_mutex);
+        m_cond.wait(locker, [this]{ return m_done; });
+
+        result.idErr = m_idErr;
+        result.duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - tsStart).count();
+        locker.unlock();
+
+        /* Callbacks are called from transfer thread, wait for it to be finished */
+        while(m_manager.transferIsInProgress()){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return result;
+    }
+
+private:
+    void notify(tease::TransferManager::IdError idErr)
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        m_idErr = idErr;
+        m_done = true;
+        m_cond.notify_all();
+    }
+
+private:
+    tease::TransferManager &m_manager;
+
+    tease::TransferManager::IdError m_idErr = tease::TransferManager::ERR_NO_ERROR;
+    bool m_done = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+#endif // TEASE_BENCHMARKS_BENCHHELPER_H
@@ -0,0 +1,17 @@
+#include <transferease/transferawaitable.h>
+
+/*
+ * "Task" is the coroutine type of the application (asio awaitable, cppcoro task, etc...)
+ * and "executor" its scheduling function.
+ */
+Task downloadRessource(tease::TransferManager &manager, tease::Request::PtrShared req, std::stop_token token)
+{
+    const tease::TransferManager::BatchResult result = co_await tease::download(manager, req, executor, token);
+    if(result.idErr != tease::TransferManager::ERR_NO_ERROR){
+        std::cerr << "Failed to download ressource [id-err: " << result.idErr << "]" << std::endl;
+        co_return;
+    }
+
+    /* Coroutine is resumed on executor, request content can be used */
+    useDatas(req->getData());
+}
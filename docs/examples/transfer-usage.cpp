@@ -1,6 +1,6 @@
+#include <future>
 #include <iostream>
 #include <map>
-#include <thread>
 
 #include <transferease/transfermanager.h>
 
@@ -107,23 +107,19 @@ int main(int argc, char *argv[])
     /* Create requests and start transfer */
 #if RUN_DL_ENABLE
     prepareRequestsDl(listReqs);
-    Manager::IdError idErr = manager.startDownload(listReqs);
 #else
     prepareRequestsUp(listReqs);
-    Manager::IdError idErr = manager.startUpload(listReqs);
 #endif
-
-    if(idErr != Manager::ERR_NO_ERROR){
-        std::cerr << "Failed to start transfer [id-err: " << idErr << "]" << std::endl;
-        return 1;
-    }
+    std::future<Manager::BatchResult> result = manager.submit(listReqs);
 
     /*
-     * Placeholder loop used to wait for the transfer to finish before exiting application.
+     * Wait for the transfer to finish before exiting application.
      * In a real application, prefer to use callbacks methods !
      */
-    while(manager.transferIsInProgress()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const Manager::IdError idErr = result.get().idErr;
+    if(idErr != Manager::ERR_NO_ERROR){
+        std::cerr << "Transfer failed [id-err: " << idErr << "]" << std::endl;
+        return 1;
     }
 
     std::cout << "Done" << std::endl;
@@ -0,0 +1,37 @@
+#ifndef TEASE_NET_MAPPEDFILE_H
+#define TEASE_NET_MAPPEDFILE_H
+
+#include "bytesarray.h"
+
+namespace tease
+{
+
+class TEASE_EXPORT MappedFile
+{
+    TEASE_DISABLE_COPY_MOVE(MappedFile)
+
+public:
+    MappedFile();
+    virtual ~MappedFile();
+
+public:
+    bool open(const std::string &pathFile, size_t offset = 0);
+    void close();
+
+public:
+    bool isOpen() const;
+    bool isEmpty() const;
+    std::size_t getSize() const;
+
+    const BytesArray::Byte* dataConst() const;
+
+    BytesArray toBytesArray() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> d_ptr;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_MAPPEDFILE_H
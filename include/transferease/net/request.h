@@ -2,8 +2,14 @@
 #define TEASE_NET_REQUEST_H
 
 #include "bytesarray.h"
+#include "mappedfile.h"
 #include "url.h"
 
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+
 namespace tease
 {
 
@@ -24,9 +30,15 @@ public:
     };
 
 public:
+    using Id = std::uint64_t;                   /**< Unique identifier of a request */
     using PtrShared = std::shared_ptr<Request>; /**< Request shared pointer type alias */
     using List = std::vector<PtrShared>;        /**< Alias representing a list of requests */
 
+    using Clock = std::chrono::steady_clock;    /**< Clock used by request deadlines */
+    using TimePoint = Clock::time_point;        /**< Alias representing a point in time of \c Request::Clock */
+
+    using DataSink = std::function<bool(size_t offset, const BytesArray::Byte *data, size_t size)>;
+
 public:
     Request();
     virtual ~Request();
@@ -39,26 +51,59 @@ public:
     void configureUpload(const Url &dstUrl, const BytesArray &inputData);
     void configureUpload(const Url &dstUrl, BytesArray &&inputData);
 
+    void setDeadline(const TimePoint &deadline);
+    void setMirrors(const std::vector<Url> &listMirrors);
+    void setExpectedDigest(const std::string &digest);
+    void setModificationTime(std::time_t time);
+    void setDataSink(const DataSink &sink);
+
 public:
+    Id getId() const;
     TypeTransfer getTypeTransfer() const;
     const Url& getUrl() const;
+    const std::vector<Url>& getMirrors() const;
+    bool hasMirrors() const;
+    const TimePoint& getDeadline() const;
+    bool hasDeadline() const;
+    const std::string& getExpectedDigest() const;
+    std::time_t getModificationTime() const;
+    const DataSink& getDataSink() const;
+    bool hasDataSink() const;
 
     BytesArray& getData();
     const BytesArray& getData() const;
 
+    MappedFile& getMappedData();
+    const MappedFile& getMappedData() const;
+
 public:
     size_t ioRead(char *buffer, size_t nbBytes);
 
     void ioSetSizeTotal(size_t size);
     void ioSetSizeCurrent(size_t size);
+    void ioSetSizeWire(size_t size);
+    void ioSetSizeExpected(size_t size);
+    void ioSetDigest(const std::string &digest);
+    void ioSetSkipped(bool skipped);
     void ioRegisterTry();
+    void ioSelectMirror(size_t idMirror);
+    bool ioFailover();
     void ioAbort();
+    void ioSetPaused(bool paused);
     void ioReset();
 
     size_t ioGetSizeTotal() const;
     size_t ioGetSizeCurrent() const;
+    size_t ioGetSizeWire() const;
+    size_t ioGetSizeExpected() const;
+    const std::string& ioGetDigest() const;
+    bool ioIsSkipped() const;
     int ioGetNbTrials() const;
+    const Url& ioGetUrl() const;
+    size_t ioGetIdMirror() const;
+    int ioGetNbFailovers() const;
     bool ioIsAbort() const;
+    bool ioIsPaused() const;
 
 private:
     class Impl;
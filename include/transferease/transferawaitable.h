@@ -0,0 +1,223 @@
+#ifndef TEASE_TRANSFERAWAITABLE_H
+#define TEASE_TRANSFERAWAITABLE_H
+
+/*
+ * Only available when compiling with C++20 coroutines support,
+ * library itself doesn't depend on it
+ */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && __has_include(<stop_token>)
+
+#include "transfermanager.h"
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <stop_token>
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+namespace tease
+{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \class tease::TransferAwaitable
+ * \brief Use to await transfer of requests from
+ * a C++20 coroutine
+ * \details
+ * Transfer is submitted to the manager when awaited (see
+ * TransferManager::submit(const Request::List&, TransferManager::CbDone)),
+ * coroutine is resumed once transfer is finished, from the
+ * manager completion path (no thread is dedicated to the wait):
+ * - On the caller-supplied executor if any
+ * - Otherwise directly on the transfer thread of the manager
+ *
+ * If transfer can't be started (\c TransferManager::ERR_BUSY,
+ * \c TransferManager::ERR_INVALID_REQUEST, etc...), coroutine
+ * is not suspended. \n
+ * Stop token allow to cancel the transfer: requests are cancelled
+ * (see TransferManager::cancel()) and result is \c TransferManager::ERR_USER_ABORT.
+ *
+ * Prefer to use helpers download() and upload():
+ * \include coroutine-usage.cpp
+ *
+ * \note
+ * Transfer manager and requests must remain valid until
+ * coroutine is resumed.
+ * \warning
+ * Without executor, coroutine must not destroy the transfer
+ * manager before being suspended again (its transfer thread
+ * is still running it).
+ */
+class TransferAwaitable
+{
+public:
+    TransferAwaitable(TransferManager &manager, Request::List listReqs, Request::TypeTransfer typeTransfer, TransferManager::Executor executor = nullptr, std::stop_token token = {}) :
+        m_manager(manager), m_listReqs(std::move(listReqs)), m_typeTransfer(typeTransfer), m_executor(std::move(executor)), m_token(std::move(token))
+    {
+        m_result = TransferManager::BatchResult{typeTransfer, TransferManager::ERR_NO_ERROR};
+    }
+
+public:
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        /* Verify that awaited transfer type is respected by all requests */
+        for(const auto &req : m_listReqs){
+            if(req->getTypeTransfer() != m_typeTransfer){
+                m_result.idErr = TransferManager::ERR_INVALID_REQUEST;
+                return false;
+            }
+        }
+
+        /* Transfer cancelled before being started */
+        if(m_token.stop_requested()){
+            m_result.idErr = TransferManager::ERR_USER_ABORT;
+            return false;
+        }
+
+        /* Propagate cancellation to requests (must be registered before continuation can resume coroutine) */
+        m_handle = handle;
+        m_cbStop.emplace(m_token, Aborter{&m_manager, &m_listReqs});
+
+        /* Start transfer, continuation is called right away if transfer can't be started */
+        m_manager.submit(m_listReqs, [this](const TransferManager::BatchResult &result){
+            m_result = result;
+
+            // Coroutine is only resumed once suspended
+            if(m_state.exchange(STATE_DONE, std::memory_order_acq_rel) == STATE_SUSPENDED){
+                resume();
+            }
+        });
+
+        /* Transfer may already be finished, coroutine then continues right away */
+        return m_state.exchange(STATE_SUSPENDED, std::memory_order_acq_rel) != STATE_DONE;
+    }
+
+    TransferManager::BatchResult await_resume()
+    {
+        m_cbStop.reset();
+        return m_result;
+    }
+
+private:
+    enum State
+    {
+        STATE_SUBMITTING = 0,
+        STATE_SUSPENDED,
+        STATE_DONE
+    };
+
+private:
+    void resume()
+    {
+        if(m_executor){
+            m_executor([handle = m_handle](){ handle.resume(); });
+        }else{
+            m_handle.resume();
+        }
+    }
+
+private:
+    struct Aborter
+    {
+        TransferManager *manager;
+        const Request::List *listReqs;
+
+        void operator()() const
+        {
+            std::vector<Request::Id> listIds;
+            listIds.reserve(listReqs->size());
+
+            // Requests are flagged too, transfer may not be started yet
+            for(const auto &req : *listReqs){
+                req->ioAbort();
+                listIds.push_back(req->getId());
+            }
+
+            manager->cancel(listIds);
+        }
+    };
+
+private:
+    TransferManager &m_manager;
+    Request::List m_listReqs;
+    Request::TypeTransfer m_typeTransfer;
+    TransferManager::Executor m_executor;
+    std::stop_token m_token;
+
+    std::coroutine_handle<> m_handle;
+    std::atomic<int> m_state{STATE_SUBMITTING};
+    std::optional<std::stop_callback<Aborter>> m_cbStop;
+    TransferManager::BatchResult m_result;
+};
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+/*!
+ * \brief Use to await download of a request
+ *
+ * \param[in] manager
+ * Transfer manager to use.
+ * \param[in, out] req
+ * Request to download.
+ * \param[in] executor
+ * Executor on which coroutine is resumed. \n
+ * Can be \c nullptr to resume on the transfer thread of the manager.
+ * \param[in] token
+ * Stop token used to cancel the download.
+ *
+ * \return
+ * Returns awaitable which result is a \c TransferManager::BatchResult.
+ */
+inline TransferAwaitable download(TransferManager &manager, const Request::PtrShared &req, TransferManager::Executor executor = nullptr, std::stop_token token = {})
+{
+    return TransferAwaitable(manager, Request::List{req}, Request::TRANSFER_DOWNLOAD, std::move(executor), std::move(token));
+}
+
+/*!
+ * \brief Use to await download of a list of requests
+ * \sa download(TransferManager&, const Request::PtrShared&, TransferManager::Executor, std::stop_token)
+ */
+inline TransferAwaitable download(TransferManager &manager, const Request::List &listReqs, TransferManager::Executor executor = nullptr, std::stop_token token = {})
+{
+    return TransferAwaitable(manager, listReqs, Request::TRANSFER_DOWNLOAD, std::move(executor), std::move(token));
+}
+
+/*!
+ * \brief Use to await upload of a request
+ * \sa download(TransferManager&, const Request::PtrShared&, TransferManager::Executor, std::stop_token)
+ */
+inline TransferAwaitable upload(TransferManager &manager, const Request::PtrShared &req, TransferManager::Executor executor = nullptr, std::stop_token token = {})
+{
+    return TransferAwaitable(manager, Request::List{req}, Request::TRANSFER_UPLOAD, std::move(executor), std::move(token));
+}
+
+/*!
+ * \brief Use to await upload of a list of requests
+ * \sa download(TransferManager&, const Request::PtrShared&, TransferManager::Executor, std::stop_token)
+ */
+inline TransferAwaitable upload(TransferManager &manager, const Request::List &listReqs, TransferManager::Executor executor = nullptr, std::stop_token token = {})
+{
+    return TransferAwaitable(manager, listReqs, Request::TRANSFER_UPLOAD, std::move(executor), std::move(token));
+}
+
+/*****************************/
+/* End namespaces            */
+/*****************************/
+
+} // namespace tease
+
+#endif // Coroutines support
+
+#endif // TEASE_TRANSFERAWAITABLE_H
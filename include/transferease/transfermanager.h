@@ -6,6 +6,7 @@
 #include "tools/enumflag.h"
 
 #include <functional>
+#include <future>
 
 /*****************************/
 /* Namespace instructions    */
@@ -39,7 +40,9 @@ public:
         ERR_MEMORY_FULL_REMOTE, /**< Trying to upload a ressource to remote which have his memory full */
         ERR_HOST_NOT_FOUND,     /**< Host server informations are either invalid or unreachable */
         ERR_HOST_REFUSED,       /**< Host server refused connection */
-        ERR_CONTENT_NOT_FOUND   /**< Ressource could not be found */
+        ERR_CONTENT_NOT_FOUND,  /**< Ressource could not be found */
+        ERR_DEADLINE_EXCEEDED,  /**< Request deadline or batch timeout has been reached (or can't be met at current transfer speed) */
+        ERR_INTEGRITY           /**< Digest of transferred datas doesn't match expected one */
     };
 
     /*!
@@ -53,7 +56,237 @@ public:
         OPT_NONE = 0,                   /**< No options defined, use this value to reset flags */
 
         OPT_VERBOSE         = 1 << 0,   /**< Enable to provide a lot of verbose informations, you hardly ever want this enabled in production use, you almost always want this used when you debug/report problems. */
-        OPT_FTP_CREATE_DIRS = 1 << 1    /**< When uploading ressource via FTP protocol, missing directories will be automatically created. \n Note that this option will be ignored for any other protocol. */
+        OPT_FTP_CREATE_DIRS = 1 << 1,   /**< When uploading ressource via FTP protocol, missing directories will be automatically created. \n Each unique directory of a batch is created once before uploads start, and created directories are remembered so that uploads into them skip directories creation. \n Note that this option will be ignored for any other protocol. */
+        OPT_ADAPTIVE_CONCURRENCY = 1 << 2, /**< Number of simultaneous transfers per host is adjusted according to measured throughput, latency and errors. \n See setNbMaxTransfersPerHost() to bound it. */
+        OPT_MIRROR_BY_THROUGHPUT = 1 << 3, /**< For requests having mirrors, first used URL is the one with the best measured throughput (hosts without measures are tried first) instead of the configured URL. \n See Request::setMirrors(). */
+        OPT_HTTP_COMPRESSION = 1 << 4,  /**< When downloading ressource via HTTP(S) protocol, all encodings supported by the underlying library (gzip, deflate, br, zstd) are advertised and responses are transparently decoded. \n Note that this option will be ignored for any other protocol. */
+        OPT_SKIP_UNCHANGED  = 1 << 5,   /**< Before uploading, remote metadata of all ressources are retrieved in parallel (FTP: \c SIZE and \c MDTM, HTTP: \c HEAD) and uploads which remote ressource is already up to date are skipped. \n See Request::setModificationTime(), Request::setExpectedDigest() and getSkipStats(). */
+        OPT_PREFETCH_SIZES  = 1 << 6    /**< Before downloading, sizes of all ressources are retrieved in parallel (FTP: \c SIZE, HTTP: \c HEAD), so that progress total is exact from the start and downloaded datas are stored in buffers allocated once. \n This costs one more request per ressource, it is mostly useful for batches of big ressources. \n See Request::ioGetSizeExpected(). */
+    };
+
+    /*!
+     * \brief List of hedging policies
+     * \details
+     * Hedging allow to reduce tail latency: when a request
+     * is slower than most of observed requests, a duplicate
+     * request is started, first one to complete is kept and
+     * the other one is cancelled.
+     *
+     * \note
+     * Hedging is only applied to downloads.
+     *
+     * \sa setHedgingPolicy()
+     */
+    enum TypeHedging
+    {
+        HEDGING_DISABLED = 0,   /**< Never duplicate requests */
+
+        HEDGING_FIRST_BYTE,     /**< Duplicate requests which haven't received their first byte after the configured percentile of observed time to first byte */
+        HEDGING_COMPLETION      /**< Duplicate requests which haven't completed after the configured percentile of observed completion time */
+    };
+
+    /*!
+     * \brief List of methods used to reach a file
+     * on FTP servers
+     * \details
+     * By default, a \c CWD command is performed for each
+     * component of the file path, which cost several round
+     * trips per file for deep directories.
+     *
+     * \note
+     * Transfers reusing a connection already located in the
+     * file directory don't perform any \c CWD command.
+     *
+     * \sa setFtpMethod()
+     */
+    enum TypeFtpMethod
+    {
+        FTP_METHOD_MULTICWD = 0,    /**< Perform one \c CWD per path component, this is the most compatible method (curl default) */
+
+        FTP_METHOD_AUTO,            /**< Use \c FTP_METHOD_SINGLECWD, except when missing directories must be created (see \c OPT_FTP_CREATE_DIRS) which require \c FTP_METHOD_MULTICWD */
+        FTP_METHOD_SINGLECWD,       /**< Perform one \c CWD to the full directory path */
+        FTP_METHOD_NOCWD            /**< Don't perform any \c CWD, full path is given to commands (fastest, but not supported by all servers) */
+    };
+
+    /*!
+     * \brief List of encodings used to compress
+     * uploaded datas
+     * \details
+     * Datas are compressed on the fly while being sent,
+     * and header \c Content-Encoding is set accordingly: remote
+     * server must be able to decode it.
+     *
+     * \note
+     * Encoding is only applied to HTTP(S) uploads. Available
+     * encodings depend on libraries found at build time,
+     * see encodingIsSupported().
+     *
+     * \sa setUploadEncoding()
+     */
+    enum TypeEncoding
+    {
+        ENCODING_NONE = 0,  /**< Datas are sent as is */
+
+        ENCODING_GZIP,      /**< Datas are compressed with gzip (require CMake option TEASE_WITH_ZLIB) */
+        ENCODING_ZSTD       /**< Datas are compressed with zstd (require CMake option TEASE_WITH_ZSTD) */
+    };
+
+    /*!
+     * \brief List of algorithms used to compute
+     * digest of transferred datas
+     * \details
+     * Digest is computed while datas are transferred, and
+     * hardware acceleration is used when available.
+     *
+     * \sa setDigestAlgorithm(), Request::setExpectedDigest()
+     */
+    enum TypeDigest
+    {
+        DIGEST_NONE = 0,    /**< No digest is computed */
+
+        DIGEST_SHA256,      /**< SHA-256, digests are formatted as <tt>sha256:<64 hex digits></tt> */
+        DIGEST_CRC32C       /**< CRC-32C (Castagnoli), digests are formatted as <tt>crc32c:<8 hex digits></tt> */
+    };
+
+    /*!
+     * \brief List of methods used to deliver downloads
+     * served from content cache
+     *
+     * \sa setContentCache()
+     */
+    enum TypeCacheDelivery
+    {
+        CACHE_DELIVERY_COPY = 0,    /**< Cached content is copied into Request::getData() */
+        CACHE_DELIVERY_MAP          /**< Cached content is mapped in memory without copy, available with Request::getMappedData() */
+    };
+
+    /*!
+     * \brief List of policies used to order requests
+     * before starting them
+     * \details
+     * Requests with shortest deadline are always started
+     * first, policy is used to order requests having the
+     * same deadline.
+     *
+     * \note
+     * Policies based on size use size of uploaded datas, sizes
+     * of downloaded ressources are only known before transfer
+     * with option \c OPT_PREFETCH_SIZES. Requests which size is
+     * unknown are started last.
+     *
+     * \sa setSchedulingPolicy()
+     */
+    enum TypeScheduling
+    {
+        SCHEDULING_GROUPED = 0,         /**< Requests are grouped by host and directory, allowing connections reuse */
+
+        SCHEDULING_SHORTEST_FIRST,      /**< Smallest requests are started first, minimizing mean completion time */
+        SCHEDULING_LARGEST_FIRST,       /**< Biggest requests are started first, minimizing total duration of the batch (big transfers don't end alone) */
+        SCHEDULING_ROUND_ROBIN_HOSTS    /**< Requests of each host are interleaved, so that all hosts are used from the start */
+    };
+
+    /*!
+     * \brief List of methods used to call user callbacks
+     * \details
+     * With default method, callbacks are called from transfer
+     * threads: a slow callback delays all transfers. Other methods
+     * queue callbacks events, transfer threads never wait for
+     * user code (progress events are coalesced, only latest
+     * progress is given to callback).
+     *
+     * \sa setCallbackDispatch()
+     */
+    enum TypeDispatch
+    {
+        DISPATCH_DIRECT = 0,    /**< Callbacks are called from transfer threads */
+
+        DISPATCH_THREAD,        /**< Callbacks are called from a dedicated thread owned by the manager */
+        DISPATCH_EXECUTOR       /**< Callbacks are called from tasks given to a user executor */
+    };
+
+    /*!
+     * \brief Statistics of transfers performed on a host
+     *
+     * \sa getHostsStats()
+     */
+    struct HostStats
+    {
+        std::string host;   /**< Host name */
+
+        int nbActive;       /**< Number of transfers currently running */
+        int nbMaxActive;    /**< Concurrency limit currently applied, \c 0 means unlimited */
+
+        size_t nbSucceed;   /**< Number of transfers which succeed */
+        size_t nbFailed;    /**< Number of transfers which failed (retries included) */
+
+        double throughput;  /**< Achieved throughput in bytes/sec (measured while host had running transfers) */
+        double latency;     /**< Smoothed time to first byte in seconds */
+    };
+
+    /*!
+     * \brief Progress of current (or last) transfer
+     *
+     * \sa getProgress()
+     */
+    struct Progress
+    {
+        size_t sizeTotal;   /**< Total size of the transfer in bytes (requests which size is not known yet are estimated with biggest known size) */
+        size_t sizeCurrent; /**< Number of bytes transferred */
+
+        double throughput;  /**< Smoothed throughput in bytes/sec (exponentially weighted moving average over a few seconds) */
+        double eta;         /**< Estimated remaining time in seconds, \c -1 if unknown */
+
+        size_t nbActive;    /**< Number of requests being transferred */
+        size_t nbQueued;    /**< Number of requests waiting to be started */
+        size_t nbCompleted; /**< Number of requests completed */
+    };
+
+    /*!
+     * \brief Progress of a request of current transfer
+     *
+     * \sa getRequestsProgress()
+     */
+    struct RequestProgress
+    {
+        Request::PtrShared req; /**< Request */
+        size_t sizeTotal;       /**< Total size of the request in bytes, \c 0 if unknown */
+        size_t sizeCurrent;     /**< Number of bytes transferred */
+    };
+
+    /*!
+     * \brief Statistics of HTTP cache
+     *
+     * \sa setHttpCache(), getHttpCacheStats()
+     */
+    struct HttpCacheStats
+    {
+        size_t nbHits;          /**< Number of requests served from cache (remote answered <tt>304 Not Modified</tt>) */
+        size_t nbMisses;        /**< Number of requests which body has been downloaded */
+        size_t nbRevalidations; /**< Number of conditional requests sent (hits and outdated entries) */
+        size_t nbBytesSaved;    /**< Number of bytes served from cache instead of being downloaded */
+    };
+
+    /*!
+     * \brief Statistics of incremental uploads
+     *
+     * \sa OPT_SKIP_UNCHANGED, getSkipStats()
+     */
+    struct SkipStats
+    {
+        size_t nbChecked;       /**< Number of uploads which remote ressource has been checked */
+        size_t nbSkipped;       /**< Number of uploads skipped since remote ressource was up to date */
+        size_t nbBytesSkipped;  /**< Number of bytes which didn't need to be uploaded */
+    };
+
+    /*!
+     * \brief Result of a batch of requests
+     *
+     * \sa submit()
+     */
+    struct BatchResult
+    {
+        Request::TypeTransfer typeTransfer; /**< Type of transfer performed */
+        IdError idErr;                      /**< \c TransferManager::ERR_NO_ERROR if all requests succeed */
     };
 
 public:
@@ -61,6 +294,10 @@ public:
     using CbProgress = std::function<void(Request::TypeTransfer typeTransfer, size_t transferTotal, size_t transferNow)>;
     using CbCompleted = std::function<void(Request::TypeTransfer typeTransfer)>;
     using CbFailed = std::function<void(Request::TypeTransfer typeTransfer, IdError idErr)>;
+    using CbProgressInfos = std::function<void(Request::TypeTransfer typeTransfer, const Progress &progress)>;
+    using CbDone = std::function<void(const BatchResult &result)>;
+
+    using Executor = std::function<void(std::function<void()> task)>;
 
 public:
     TransferManager();
@@ -69,31 +306,81 @@ public:
 public:
     IdError startDownload(const Request::List &listReqs);
     IdError startUpload(const Request::List &listReqs);
+    std::future<BatchResult> submit(const Request::List &listReqs);
+    std::future<BatchResult> submit(const Request::List &listReqs, std::vector<std::future<IdError>> &listFutures);
+    std::future<BatchResult> submit(const Request::PtrShared &req);
+    void submit(const Request::List &listReqs, CbDone cbDone);
+    IdError transferNow(const Request::PtrShared &req);
+    IdError prewarm(const std::vector<Url> &listHosts, bool openConnections = false);
     void abortTransfer();
+    void cancel(Request::Id idReq);
+    void cancel(const std::vector<Request::Id> &listIds);
+    void pauseTransfer();
+    void resumeTransfer();
+    void pause(Request::Id idReq);
+    void pause(const std::vector<Request::Id> &listIds);
+    void resume(Request::Id idReq);
+    void resume(const std::vector<Request::Id> &listIds);
     bool transferIsInProgress() const;
+    bool transferIsPaused() const;
 
     const std::string& getUserLogin() const;
     const std::string& getUserPasswd() const;
     int getNbMaxTrials() const;
     long getTimeoutConnection() const;
     long getTimeoutTransfer() const;
+    long getTimeoutBatch() const;
+    long getDnsCacheTimeout() const;
     FlagOption getOptions() const;
+    int getNbMaxTransfersPerHost() const;
+    int getNbWorkers() const;
+    TypeHedging getHedgingPolicy() const;
+    double getHedgingPercentile() const;
+    TypeFtpMethod getFtpMethod() const;
+    TypeEncoding getUploadEncoding() const;
+    TypeDigest getDigestAlgorithm() const;
+    TypeScheduling getSchedulingPolicy() const;
+    TypeDispatch getCallbackDispatch() const;
+
+    long getProgressInterval() const;
+    size_t getProgressThreshold() const;
+
+    Progress getProgress() const;
+    std::vector<RequestProgress> getRequestsProgress() const;
+    std::vector<HostStats> getHostsStats() const;
+    HttpCacheStats getHttpCacheStats() const;
+    SkipStats getSkipStats() const;
 
 public:
     void setUserInfos(const std::string &username, const std::string &passwd);
     void setNbMaxTrials(int nbTrials);
     void setTimeoutConnection(long timeout);
     void setTimeoutTransfer(long timeout);
+    void setTimeoutBatch(long timeout);
+    void setDnsCacheTimeout(long timeout);
     void setOptions(FlagOption options);
+    void setNbMaxTransfersPerHost(int nbMax);
+    void setNbWorkers(int nbWorkers);
+    void setHedgingPolicy(TypeHedging policy, double percentile = 95.0);
+    void setFtpMethod(TypeFtpMethod method);
+    void setUploadEncoding(TypeEncoding encoding);
+    void setDigestAlgorithm(TypeDigest algorithm);
+    void setSchedulingPolicy(TypeScheduling policy);
+    void setHttpCache(const std::string &pathDir, bool inMemory = false, size_t sizeMax = 0);
+    void setContentCache(const std::string &pathDir, size_t sizeMax = 0, TypeCacheDelivery delivery = CACHE_DELIVERY_COPY);
+    void setProgressInterval(long interval, size_t threshold = 0);
 
 public:
     void setCbStarted(CbStarted fct);
     void setCbProgress(CbProgress fct);
     void setCbCompleted(CbCompleted fct);
     void setCbFailed(CbFailed fct);
+    void setCbProgressInfos(CbProgressInfos fct);
+    void setCallbackDispatch(TypeDispatch dispatch, Executor executor = nullptr);
 
 public:
     static double transferProgressToPercent(size_t transferTotal, size_t transferNow);
+    static bool encodingIsSupported(TypeEncoding encoding);
 
     static std::string flagOptionToStr(FlagOption options, char separator = '|');
     static const std::string &idErrorToStr(IdError idErr);
@@ -0,0 +1,558 @@
+#include "callbackdispatcher.h"
+
+#include "transferease/logs/abstractlogger.h"
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::CallbackDispatcher
+ * \brief Dispatch transfer events to user callbacks
+ * \details
+ * With \c TransferManager::DISPATCH_DIRECT, events are given
+ * to handler directly from the thread posting them. \n
+ * Otherwise, events are pushed to a bounded lock-free queue
+ * (multiple producers, single consumer) and handler is called
+ * from a dedicated thread (\c TransferManager::DISPATCH_THREAD)
+ * or from tasks given to user executor (\c TransferManager::DISPATCH_EXECUTOR).
+ * Transfer threads never wait for user code:
+ * - Progress events are coalesced: only latest progress is kept
+ * and at most one progress event is queued at a time, which keep
+ * the queue bounded whatever the speed of user callbacks.
+ * - Other events are never dropped: when queue is full, they are
+ * kept in an overflow list (protected by a mutex) until the consumer
+ * catch up. Once this list is used, following events are appended to it
+ * to preserve their order.
+ * - At most one task is given to executor at a time, this task
+ * dispatch all queued events.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define QUEUE_CAPACITY      256     /**< Must be a power of 2 */
+
+#define PROGRESS_IDX_MASK   0x3
+#define PROGRESS_DIRTY      0x4
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions definitions     */
+/*      Private Class        */
+/*****************************/
+
+/*!
+ * \brief Bounded lock-free queue
+ * \details
+ * Each cell hold a sequence number telling if it can
+ * be written or read for a given position, so that producers
+ * only compete on the enqueue position.
+ */
+class CallbackDispatcher::Queue final
+{
+public:
+    Queue();
+
+public:
+    bool push(const Event &event);
+    bool pop(Event &event);
+    bool isEmpty() const;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Event event;
+    };
+
+private:
+    std::vector<Cell> m_listCells;
+
+    alignas(64) std::atomic<size_t> m_posEnqueue;
+    alignas(64) std::atomic<size_t> m_posDequeue;
+};
+
+class CallbackDispatcher::State final : public std::enable_shared_from_this<State>
+{
+public:
+    explicit State(Handler handler);
+
+public:
+    bool post(const Event &event);
+    bool pop(Event &event);
+    bool isEmpty() const;
+    void publishProgress(const Event &event);
+    void wakeUp();
+
+    void run();
+    void drain();
+    void dispatch(Event &event);
+    bool consumeProgress(Event &event);
+
+public:
+    Handler m_handler;
+    Queue m_queue;
+
+    /* Events which could not be queued (never used for progress events) */
+    std::mutex m_mutexOverflow;
+    std::deque<Event> m_listOverflow;
+    std::atomic<bool> m_hasOverflow;
+
+    std::atomic<TransferManager::TypeDispatch> m_idDispatch;
+    TransferManager::Executor m_executor;
+
+    /* Latest progress, exchanged between producer and consumer without copy of any intermediate value */
+    Event m_listProgress[3];
+    std::uint8_t m_idxProgressBack;
+    std::uint8_t m_idxProgressFront;
+    std::atomic<std::uint8_t> m_idxProgressMiddle;
+    std::atomic<bool> m_progressQueued;
+
+    std::atomic<bool> m_scheduled;
+    std::atomic<bool> m_draining;
+    std::atomic<bool> m_closed;
+
+    bool m_stopThread;
+    std::mutex m_mutexWake;
+    std::condition_variable m_condWake;
+};
+
+/*****************************/
+/* Functions implementation  */
+/*      Private Class        */
+/*****************************/
+
+CallbackDispatcher::Queue::Queue() :
+    m_listCells(QUEUE_CAPACITY)
+{
+    for(size_t i = 0; i < m_listCells.size(); ++i){
+        m_listCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_posEnqueue.store(0, std::memory_order_relaxed);
+    m_posDequeue.store(0, std::memory_order_relaxed);
+}
+
+bool CallbackDispatcher::Queue::push(const Event &event)
+{
+    const size_t mask = m_listCells.size() - 1;
+
+    Cell *cell = nullptr;
+    size_t pos = m_posEnqueue.load(std::memory_order_relaxed);
+
+    for(;;){
+        cell = &m_listCells[pos & mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+        // Cell is free, try to reserve it
+        if(diff == 0){
+            if(m_posEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+
+        // Cell still hold an event not consumed yet: queue is full
+        }else if(diff < 0){
+            return false;
+
+        // Another producer reserved it
+        }else{
+            pos = m_posEnqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool CallbackDispatcher::Queue::pop(Event &event)
+{
+    const size_t mask = m_listCells.size() - 1;
+
+    Cell *cell = nullptr;
+    size_t pos = m_posDequeue.load(std::memory_order_relaxed);
+
+    for(;;){
+        cell = &m_listCells[pos & mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if(diff == 0){
+            if(m_posDequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                break;
+            }
+
+        }else if(diff < 0){
+            return false;
+
+        }else{
+            pos = m_posDequeue.load(std::memory_order_relaxed);
+        }
+    }
+
+    event = cell->event;
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool CallbackDispatcher::Queue::isEmpty() const
+{
+    return m_posDequeue.load(std::memory_order_acquire) == m_posEnqueue.load(std::memory_order_acquire);
+}
+
+CallbackDispatcher::State::State(Handler handler) :
+    m_handler(std::move(handler))
+{
+    m_idDispatch = TransferManager::DISPATCH_DIRECT;
+
+    m_listProgress[0] = m_listProgress[1] = m_listProgress[2] = Event{};
+    m_idxProgressBack = 0;
+    m_idxProgressFront = 1;
+    m_idxProgressMiddle = 2;
+    m_progressQueued = false;
+    m_hasOverflow = false;
+
+    m_scheduled = false;
+    m_draining = false;
+    m_closed = false;
+
+    m_stopThread = false;
+}
+
+/*!
+ * \brief Use to post an event to the consumer
+ * \details
+ * Only progress events can be dropped (when queue is full),
+ * other events are moved to overflow list instead.
+ *
+ * \param[in] event
+ * Event to post.
+ *
+ * \return
+ * Returns \c false if event was dropped.
+ */
+bool CallbackDispatcher::State::post(const Event &event)
+{
+    /* Keep order of events once overflow list is used */
+    const bool isProgress = event.idType == EVENT_PROGRESS;
+    if(isProgress || !m_hasOverflow){
+        if(m_queue.push(event)){
+            wakeUp();
+            return true;
+        }
+
+        if(isProgress){
+            TEASE_LOG_WARN("Callbacks queue is full, progress event is dropped");
+            return false;
+        }
+    }
+
+    /* Queue is full, event must not be lost */
+    {
+        std::lock_guard<std::mutex> locker(m_mutexOverflow);
+        m_listOverflow.push_back(event);
+        m_hasOverflow = true;
+    }
+
+    wakeUp();
+    return true;
+}
+
+/*!
+ * \brief Use to retrieve next event to dispatch
+ * \details
+ * Queued events are always older than events
+ * of overflow list (except progress events).
+ *
+ * \param[out] event
+ * Next event to dispatch.
+ *
+ * \return
+ * Returns \c false if no event is available.
+ */
+bool CallbackDispatcher::State::pop(Event &event)
+{
+    if(m_queue.pop(event)){
+        return true;
+    }
+
+    if(!m_hasOverflow){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> locker(m_mutexOverflow);
+    if(m_listOverflow.empty()){
+        return false;
+    }
+
+    event = m_listOverflow.front();
+    m_listOverflow.pop_front();
+    m_hasOverflow = !m_listOverflow.empty();
+
+    return true;
+}
+
+bool CallbackDispatcher::State::isEmpty() const
+{
+    return m_queue.isEmpty() && !m_hasOverflow;
+}
+
+/*!
+ * \brief Use to publish latest progress
+ * \details
+ * Progress is written to a slot owned by producer, which
+ * is then swapped with the shared slot: consumer always
+ * read a complete progress and never wait for producer.
+ *
+ * \param[in] event
+ * Progress event to publish.
+ *
+ * \warning
+ * Must not be called concurrently.
+ */
+void CallbackDispatcher::State::publishProgress(const Event &event)
+{
+    m_listProgress[m_idxProgressBack] = event;
+    m_idxProgressBack = m_idxProgressMiddle.exchange(m_idxProgressBack | PROGRESS_DIRTY, std::memory_order_acq_rel) & PROGRESS_IDX_MASK;
+}
+
+bool CallbackDispatcher::State::consumeProgress(Event &event)
+{
+    if(!(m_idxProgressMiddle.load(std::memory_order_relaxed) & PROGRESS_DIRTY)){
+        return false;
+    }
+
+    m_idxProgressFront = m_idxProgressMiddle.exchange(m_idxProgressFront, std::memory_order_acq_rel) & PROGRESS_IDX_MASK;
+    event = m_listProgress[m_idxProgressFront];
+
+    return true;
+}
+
+void CallbackDispatcher::State::wakeUp()
+{
+    switch(m_idDispatch)
+    {
+        case TransferManager::DISPATCH_THREAD:{
+            // Lock only prevent consumer to miss the notification, it never hold it while calling user code
+            { std::lock_guard<std::mutex> locker(m_mutexWake); }
+            m_condWake.notify_one();
+        }break;
+
+        case TransferManager::DISPATCH_EXECUTOR:{
+            if(!m_scheduled.exchange(true)){
+                std::shared_ptr<State> state = shared_from_this();
+                m_executor([state](){
+                    state->drain();
+                });
+            }
+        }break;
+
+        default: break;
+    }
+}
+
+void CallbackDispatcher::State::run()
+{
+    for(;;){
+        Event event;
+        while(pop(event)){
+            dispatch(event);
+        }
+
+        std::unique_lock<std::mutex> locker(m_mutexWake);
+        if(m_stopThread && isEmpty()){
+            break;
+        }
+
+        m_condWake.wait(locker, [this](){
+            return m_stopThread || !isEmpty();
+        });
+    }
+}
+
+void CallbackDispatcher::State::drain()
+{
+    do{
+        m_draining = true;
+        if(!m_closed){
+            Event event;
+            while(pop(event)){
+                dispatch(event);
+            }
+        }
+        m_draining = false;
+        m_scheduled = false;
+
+    // Events posted while draining may not have scheduled a task
+    }while(!m_closed && !isEmpty() && !m_scheduled.exchange(true));
+}
+
+void CallbackDispatcher::State::dispatch(Event &event)
+{
+    /* Progress events only signal that a new progress is available */
+    if(event.idType == EVENT_PROGRESS){
+        m_progressQueued = false;
+        if(!consumeProgress(event)){
+            return;
+        }
+    }
+
+    m_handler(event);
+}
+
+/*****************************/
+/* Functions implementation  */
+/*      Public Class         */
+/*****************************/
+
+CallbackDispatcher::CallbackDispatcher(Handler handler) :
+    m_state(std::make_shared<State>(std::move(handler)))
+{
+
+}
+
+CallbackDispatcher::~CallbackDispatcher()
+{
+    stop();
+}
+
+/*!
+ * \brief Use to configure how events are dispatched
+ * \details
+ * Events still queued by previous dispatcher thread
+ * are dispatched before switching.
+ *
+ * \param[in] idDispatch
+ * Dispatch method to use.
+ * \param[in] executor
+ * Executor to use with \c TransferManager::DISPATCH_EXECUTOR.
+ *
+ * \warning
+ * Must not be called while events are posted.
+ */
+void CallbackDispatcher::configure(TransferManager::TypeDispatch idDispatch, TransferManager::Executor executor)
+{
+    /* Stop current thread (remaining events are dispatched) */
+    if(m_thread.joinable()){
+        {
+            std::lock_guard<std::mutex> locker(m_state->m_mutexWake);
+            m_state->m_stopThread = true;
+        }
+        m_state->m_condWake.notify_one();
+        m_thread.join();
+
+        m_state->m_stopThread = false;
+    }
+
+    /* Apply new configuration */
+    m_state->m_executor = std::move(executor);
+    m_state->m_idDispatch = idDispatch;
+
+    if(idDispatch == TransferManager::DISPATCH_THREAD){
+        std::shared_ptr<State> state = m_state;
+        m_thread = std::thread([state](){
+            state->run();
+        });
+    }
+}
+
+/*!
+ * \brief Use to stop dispatching events
+ * \details
+ * Events queued for dispatcher thread are dispatched
+ * before stopping. \n
+ * Once this method returns, handler will never be
+ * called anymore: tasks given to executor and executed
+ * later will simply do nothing.
+ */
+void CallbackDispatcher::stop()
+{
+    configure(TransferManager::DISPATCH_DIRECT, nullptr);
+
+    m_state->m_closed = true;
+    while(m_state->m_draining){
+        std::this_thread::yield();
+    }
+}
+
+TransferManager::TypeDispatch CallbackDispatcher::getTypeDispatch() const
+{
+    return m_state->m_idDispatch;
+}
+
+void CallbackDispatcher::postStarted(Request::TypeTransfer typeTransfer)
+{
+    post(Event{EVENT_STARTED, typeTransfer, TransferManager::ERR_NO_ERROR, {}});
+}
+
+/*!
+ * \brief Use to post a progress event
+ * \details
+ * Only latest progress is kept until dispatched.
+ *
+ * \param[in] typeTransfer
+ * Type of transfer.
+ * \param[in] progress
+ * Progress of the transfer.
+ *
+ * \warning
+ * Must not be called concurrently.
+ */
+void CallbackDispatcher::postProgress(Request::TypeTransfer typeTransfer, const TransferManager::Progress &progress)
+{
+    const Event event{EVENT_PROGRESS, typeTransfer, TransferManager::ERR_NO_ERROR, progress};
+    if(m_state->m_idDispatch == TransferManager::DISPATCH_DIRECT){
+        m_state->m_handler(event);
+        return;
+    }
+
+    m_state->publishProgress(event);
+    if(!m_state->m_progressQueued.exchange(true) && !m_state->post(event)){
+        m_state->m_progressQueued = false;
+    }
+}
+
+void CallbackDispatcher::postCompleted(Request::TypeTransfer typeTransfer)
+{
+    post(Event{EVENT_COMPLETED, typeTransfer, TransferManager::ERR_NO_ERROR, {}});
+}
+
+void CallbackDispatcher::postFailed(Request::TypeTransfer typeTransfer, TransferManager::IdError idErr)
+{
+    post(Event{EVENT_FAILED, typeTransfer, idErr, {}});
+}
+
+void CallbackDispatcher::post(const Event &event)
+{
+    if(m_state->m_idDispatch == TransferManager::DISPATCH_DIRECT){
+        m_state->m_handler(event);
+        return;
+    }
+
+    m_state->post(event);
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
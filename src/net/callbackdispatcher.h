@@ -0,0 +1,69 @@
+#ifndef TEASE_NET_CALLBACKDISPATCHER_H
+#define TEASE_NET_CALLBACKDISPATCHER_H
+
+#include "transferease/transfermanager.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tease
+{
+
+class CallbackDispatcher final
+{
+    TEASE_DISABLE_COPY_MOVE(CallbackDispatcher)
+
+public:
+    enum TypeEvent : std::uint8_t
+    {
+        EVENT_STARTED = 0,
+        EVENT_PROGRESS,
+        EVENT_COMPLETED,
+        EVENT_FAILED
+    };
+
+    struct Event
+    {
+        TypeEvent idType;
+        Request::TypeTransfer typeTransfer;
+        TransferManager::IdError idErr;
+        TransferManager::Progress progress;
+    };
+
+    using Handler = std::function<void(const Event &event)>;
+
+public:
+    explicit CallbackDispatcher(Handler handler);
+    ~CallbackDispatcher();
+
+public:
+    void configure(TransferManager::TypeDispatch idDispatch, TransferManager::Executor executor);
+    void stop();
+
+    TransferManager::TypeDispatch getTypeDispatch() const;
+
+public:
+    void postStarted(Request::TypeTransfer typeTransfer);
+    void postProgress(Request::TypeTransfer typeTransfer, const TransferManager::Progress &progress);
+    void postCompleted(Request::TypeTransfer typeTransfer);
+    void postFailed(Request::TypeTransfer typeTransfer, TransferManager::IdError idErr);
+
+private:
+    class Queue;
+    class State;
+
+private:
+    void post(const Event &event);
+
+private:
+    std::shared_ptr<State> m_state;
+    std::thread m_thread;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_CALLBACKDISPATCHER_H
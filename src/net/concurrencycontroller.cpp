@@ -0,0 +1,312 @@
+#include "concurrencycontroller.h"
+
+#include <algorithm>
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::ConcurrencyController
+ * \brief Manage number of transfers allowed
+ * to run simultaneously on each host
+ * \details
+ * When adaptive mode is disabled, controller simply apply
+ * the fixed limit per host (if any). \n
+ * When adaptive mode is enabled, limit of each host is
+ * adjusted with an AIMD scheme (<em>Additive Increase,
+ * Multiplicative Decrease</em>):
+ * - Each succeeded transfer increase the limit (by \c 1 during
+ * slow-start phase, by <tt>1 / limit</tt> afterward, which roughly
+ * represent one more transfer per "round" of transfers)
+ * - A transfer failure divide the limit by two
+ * - A latency gradient (time to first byte much higher than the best
+ * observed one) or a drop of aggregated throughput while concurrency
+ * grows slightly decrease the limit, since this mean that remote
+ * (or the link) start to be saturated.
+ *
+ * \note
+ * This class is \em thread-safe, statistics can be read from
+ * any thread while transfers are running.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define ADAPTIVE_LIMIT_INIT         2.0
+#define ADAPTIVE_LIMIT_MIN          1.0
+#define ADAPTIVE_LIMIT_MAX          32      /**< Used when no maximum limit per host is set */
+
+#define FACTOR_DECREASE_FAILURE     0.5
+#define FACTOR_DECREASE_GRADIENT    0.9
+#define FACTOR_EWMA                 0.2
+
+#define TOLERANCE_LATENCY_RATIO     2.0
+#define TOLERANCE_LATENCY_ABS       0.05    /**< Unit in seconds */
+#define TOLERANCE_THROUGHPUT        0.8
+#define DECAY_THROUGHPUT_BEST       0.99
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+ConcurrencyController::ConcurrencyController()
+{
+    m_adaptive = false;
+    m_nbMaxPerHost = 0;
+}
+
+/*!
+ * \brief Use to configure controller behaviour
+ *
+ * \param[in] adaptive
+ * Set to \c true to enable adaptive limits.
+ * \param[in] nbMaxPerHost
+ * Maximum number of simultaneous transfers per host. \n
+ * Use \c 0 to disable the limit (adaptive mode will then
+ * use an internal maximum).
+ */
+void ConcurrencyController::configure(bool adaptive, int nbMaxPerHost)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    m_adaptive = adaptive;
+    m_nbMaxPerHost = std::max(0, nbMaxPerHost);
+}
+
+/*!
+ * \brief Reset number of active transfers of each host.
+ * \details
+ * Learned limits and statistics are kept, so that a new
+ * batch can directly start with previous knowledge of hosts.
+ */
+void ConcurrencyController::resetActive()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    for(auto &pair : m_mapHosts){
+        pair.second.nbActive = 0;
+    }
+}
+
+/*!
+ * \brief Try to reserve a transfer slot for a host
+ *
+ * \param[in] host
+ * Host to use.
+ *
+ * \return
+ * Returns \c true if transfer can be started. \n
+ * Slot must then be released with release().
+ */
+bool ConcurrencyController::tryAcquire(const std::string &host)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    HostState &state = getHostState(host);
+
+    /* Verify host limit */
+    const int limit = getHostLimit(state);
+    if(limit > 0 && state.nbActive >= limit){
+        return false;
+    }
+
+    /* Register new active transfer */
+    if(state.nbActive == 0){
+        state.busyStart = Clock::now();
+    }
+    ++state.nbActive;
+
+    return true;
+}
+
+void ConcurrencyController::release(const std::string &host)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    HostState &state = getHostState(host);
+    if(state.nbActive <= 0){
+        return;
+    }
+
+    --state.nbActive;
+    if(state.nbActive == 0){
+        state.busyTime += Clock::now() - state.busyStart;
+    }
+}
+
+/*!
+ * \brief Register a transfer which succeed
+ *
+ * \param[in] host
+ * Host used by the transfer.
+ * \param[in] latency
+ * Time to first byte in seconds.
+ * \param[in] duration
+ * Total duration of the transfer in seconds.
+ * \param[in] nbBytes
+ * Number of bytes transferred.
+ */
+void ConcurrencyController::registerSuccess(const std::string &host, double latency, double duration, size_t nbBytes)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    HostState &state = getHostState(host);
+
+    /* Update statistics */
+    ++state.nbSucceed;
+    state.nbBytes += nbBytes;
+
+    const double rate = duration > 0.0 ? nbBytes / duration : 0.0;
+    if(state.nbSucceed == 1){
+        state.latencyMin = latency;
+        state.latencyAvg = latency;
+        state.rateAvg = rate;
+    }else{
+        state.latencyMin = std::min(state.latencyMin, latency);
+        state.latencyAvg += FACTOR_EWMA * (latency - state.latencyAvg);
+        state.rateAvg += FACTOR_EWMA * (rate - state.rateAvg);
+    }
+
+    /* Adjust limit */
+    if(!m_adaptive){
+        return;
+    }
+
+    const double rateAggregate = state.rateAvg * std::max(1, state.nbActive);
+    const bool latencyGrows = latency > state.latencyMin * TOLERANCE_LATENCY_RATIO && (latency - state.latencyMin) > TOLERANCE_LATENCY_ABS;
+    const bool rateDrops = rateAggregate < state.rateBest * TOLERANCE_THROUGHPUT;
+
+    if(latencyGrows || rateDrops){
+        state.limit *= FACTOR_DECREASE_GRADIENT;
+        state.slowStart = false;
+
+    }else if(state.slowStart){
+        state.limit += 1.0;
+
+    }else{
+        state.limit += 1.0 / state.limit;
+    }
+
+    state.limit = std::clamp(state.limit, ADAPTIVE_LIMIT_MIN, static_cast<double>(getLimitMax()));
+    state.rateBest = std::max(rateAggregate, state.rateBest * DECAY_THROUGHPUT_BEST);
+}
+
+void ConcurrencyController::registerFailure(const std::string &host)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    HostState &state = getHostState(host);
+    ++state.nbFailed;
+
+    if(m_adaptive){
+        state.limit = std::max(ADAPTIVE_LIMIT_MIN, state.limit * FACTOR_DECREASE_FAILURE);
+        state.slowStart = false;
+    }
+}
+
+/*!
+ * \brief Retrieve average throughput of transfers
+ * performed on a host
+ *
+ * \param[in] host
+ * Host to use.
+ *
+ * \return
+ * Returns throughput in bytes per second, \c -1 if no
+ * transfer succeed on this host yet.
+ */
+double ConcurrencyController::getThroughput(const std::string &host) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapHosts.find(host);
+    if(it == m_mapHosts.end() || it->second.nbSucceed == 0){
+        return -1.0;
+    }
+
+    return it->second.rateAvg;
+}
+
+std::vector<TransferManager::HostStats> ConcurrencyController::getStats() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    std::vector<TransferManager::HostStats> listStats;
+    listStats.reserve(m_mapHosts.size());
+
+    const Clock::time_point now = Clock::now();
+    for(const auto &pair : m_mapHosts){
+        const HostState &state = pair.second;
+
+        // Compute time during which host was busy
+        Clock::duration busyTime = state.busyTime;
+        if(state.nbActive > 0){
+            busyTime += now - state.busyStart;
+        }
+        const double busySecs = std::chrono::duration<double>(busyTime).count();
+
+        // Fill host statistics
+        TransferManager::HostStats stats;
+        stats.host = pair.first;
+        stats.nbActive = state.nbActive;
+        stats.nbMaxActive = getHostLimit(state);
+        stats.nbSucceed = state.nbSucceed;
+        stats.nbFailed = state.nbFailed;
+        stats.throughput = busySecs > 0.0 ? state.nbBytes / busySecs : 0.0;
+        stats.latency = state.latencyAvg;
+
+        listStats.push_back(stats);
+    }
+
+    return listStats;
+}
+
+ConcurrencyController::HostState& ConcurrencyController::getHostState(const std::string &host)
+{
+    auto it = m_mapHosts.find(host);
+    if(it != m_mapHosts.end()){
+        return it->second;
+    }
+
+    HostState state{};
+    state.limit = ADAPTIVE_LIMIT_INIT;
+    state.slowStart = true;
+
+    return m_mapHosts.emplace(host, state).first->second;
+}
+
+int ConcurrencyController::getHostLimit(const HostState &state) const
+{
+    if(!m_adaptive){
+        return m_nbMaxPerHost;
+    }
+
+    return std::min(static_cast<int>(state.limit), getLimitMax());
+}
+
+int ConcurrencyController::getLimitMax() const
+{
+    return m_nbMaxPerHost > 0 ? m_nbMaxPerHost : ADAPTIVE_LIMIT_MAX;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
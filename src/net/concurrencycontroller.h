@@ -0,0 +1,71 @@
+#ifndef TEASE_NET_CONCURRENCYCONTROLLER_H
+#define TEASE_NET_CONCURRENCYCONTROLLER_H
+
+#include "transferease/transfermanager.h"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace tease
+{
+
+class ConcurrencyController final
+{
+    TEASE_DISABLE_COPY_MOVE(ConcurrencyController)
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    ConcurrencyController();
+
+public:
+    void configure(bool adaptive, int nbMaxPerHost);
+    void resetActive();
+
+    bool tryAcquire(const std::string &host);
+    void release(const std::string &host);
+
+    void registerSuccess(const std::string &host, double latency, double duration, size_t nbBytes);
+    void registerFailure(const std::string &host);
+
+    double getThroughput(const std::string &host) const;
+    std::vector<TransferManager::HostStats> getStats() const;
+
+private:
+    struct HostState
+    {
+        double limit;
+        bool slowStart;
+        int nbActive;
+
+        size_t nbSucceed;
+        size_t nbFailed;
+        size_t nbBytes;
+
+        double latencyMin;
+        double latencyAvg;
+        double rateAvg;
+        double rateBest;
+
+        Clock::duration busyTime;
+        Clock::time_point busyStart;
+    };
+
+private:
+    HostState& getHostState(const std::string &host);
+    int getHostLimit(const HostState &state) const;
+    int getLimitMax() const;
+
+private:
+    bool m_adaptive;
+    int m_nbMaxPerHost;
+
+    std::unordered_map<std::string, HostState> m_mapHosts;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_CONCURRENCYCONTROLLER_H
@@ -0,0 +1,447 @@
+#include "contentstore.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "transferease/logs/abstractlogger.h"
+
+#include "tools/digest.h"
+#include "tools/filesystemhelper.h"
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::ContentStore
+ * \brief Local store of downloaded contents
+ * \details
+ * Contents are addressed by a key built from their expected
+ * digest when known (so identical contents downloaded from
+ * different URLs share the same entry), from their URL otherwise.
+ * Each entry is a file named from the SHA-256 hash of its key (so
+ * that names are the same for any build sharing the store), which
+ * start with a header holding the key: it is verified on each read
+ * and an entry is never delivered for another key. \n
+ * Store can be shared by several managers and processes:
+ * - Entries are written atomically, readers never observe
+ * a partially written entry
+ * - Last use of an entry is its file modification time, updated
+ * on each read, so that LRU eviction take into account reads
+ * performed by any process.
+ *
+ * When store size exceed the configured maximum, least recently
+ * used entries are removed (directory is scanned again before
+ * eviction, to take into account entries of other processes).
+ *
+ * \note
+ * This class is \em thread-safe.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define EXT_DATA        ".data"
+
+#define HEADER_MAGIC    "TEASECS1"
+#define HEADER_SIZE_LEN 4
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+ContentStore::ContentStore() :
+    m_sizeMax(0), m_sizeTotal(0)
+{
+
+}
+
+/*!
+ * \brief Use to configure store
+ *
+ * \param[in] pathDir
+ * Directory of the store, created if needed. \n
+ * Use an empty path to disable the store.
+ * \param[in] sizeMax
+ * Maximum size of the store in bytes, \c 0 for
+ * no limit.
+ */
+void ContentStore::configure(const std::string &pathDir, size_t sizeMax)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    m_pathDir = pathDir;
+    m_sizeMax = sizeMax;
+
+    m_mapEntries.clear();
+    m_sizeTotal = 0;
+
+    if(m_pathDir.empty()){
+        return;
+    }
+
+    FileSystemHelper::createDirectories(m_pathDir);
+    scan();
+    evict();
+}
+
+bool ContentStore::isEnabled() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return !m_pathDir.empty();
+}
+
+/*!
+ * \brief Use to copy an entry
+ *
+ * \param[in] key
+ * Key of the entry, see createKey().
+ * \param[out] data
+ * Content of the entry.
+ *
+ * \return
+ * Returns \c true if entry exist and has been read.
+ */
+bool ContentStore::load(const std::string &key, BytesArray &data)
+{
+    std::filesystem::path pathFile;
+    if(!prepareRead(key, pathFile)){
+        return false;
+    }
+
+    /* Verify entry key */
+    std::ifstream inFile(pathFile, std::ios::in | std::ios::binary);
+    const BytesArray header = createHeader(key);
+    if(!matchHeader(inFile, header)){
+        return false;
+    }
+
+    /* Read content */
+    inFile.seekg(0, std::ios::end);
+    const std::streamoff sizeFile = inFile.tellg();
+    inFile.seekg(static_cast<std::streamoff>(header.getSize()), std::ios::beg);
+
+    data.resize(static_cast<size_t>(sizeFile) - header.getSize());
+    inFile.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.getSize()));
+    if(!inFile){
+        data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to map an entry in memory
+ *
+ * \param[in] key
+ * Key of the entry, see createKey().
+ * \param[out] file
+ * Mapped content of the entry.
+ *
+ * \return
+ * Returns \c true if entry exist and has been mapped.
+ */
+bool ContentStore::map(const std::string &key, MappedFile &file)
+{
+    std::filesystem::path pathFile;
+    if(!prepareRead(key, pathFile)){
+        return false;
+    }
+
+    /* Verify entry key, header is not part of mapped content */
+    const BytesArray header = createHeader(key);
+    {
+        std::ifstream inFile(pathFile, std::ios::in | std::ios::binary);
+        if(!matchHeader(inFile, header)){
+            return false;
+        }
+    }
+
+    return file.open(pathFile.string(), header.getSize());
+}
+
+/*!
+ * \brief Use to insert an entry
+ * \details
+ * Any entry using the same key is replaced. \n
+ * Least recently used entries are evicted if
+ * store maximum size is exceeded.
+ *
+ * \param[in] key
+ * Key of the entry, see createKey().
+ * \param[in] data
+ * Content of the entry. \n
+ * Contents bigger than store maximum size are
+ * not inserted.
+ *
+ * \return
+ * Returns \c true if succeed.
+ */
+bool ContentStore::insert(const std::string &key, const BytesArray &data)
+{
+    const std::filesystem::path pathFile = createPath(key);
+    if(pathFile.empty()){
+        return false;
+    }
+
+    const BytesArray header = createHeader(key);
+    const size_t sizeEntry = header.getSize() + data.getSize();
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        if(m_sizeMax > 0 && sizeEntry > m_sizeMax){
+            return false;
+        }
+    }
+
+    /* Write entry */
+    if(!FileSystemHelper::writeFileAtomic(pathFile, header, data)){
+        return false;
+    }
+
+    /* Register it */
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    Entry &entry = m_mapEntries[pathFile.filename().string()];
+    m_sizeTotal = m_sizeTotal - entry.size + sizeEntry;
+
+    entry.size = sizeEntry;
+    entry.lastUse = std::filesystem::file_time_type::clock::now();
+
+    if(m_sizeMax > 0 && m_sizeTotal > m_sizeMax){
+        scan();
+        evict();
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to create key of an entry
+ *
+ * \param[in] url
+ * URL of the content.
+ * \param[in] digest
+ * Expected digest of the content, can be empty. \n
+ * When set, URL is not used: contents are addressed
+ * by their digest only.
+ *
+ * \return
+ * Returns key to use.
+ */
+std::string ContentStore::createKey(const Url &url, const std::string &digest)
+{
+    if(!digest.empty()){
+        return "digest:" + StringHelper::toLower(digest);
+    }
+
+    return "url:" + url.toString();
+}
+
+/*!
+ * \brief Use to prepare reading of an entry
+ * \details
+ * Entry last use is updated.
+ *
+ * \param[in] key
+ * Key of the entry.
+ * \param[out] pathFile
+ * Path of the entry file.
+ *
+ * \return
+ * Returns \c true if entry exist.
+ */
+bool ContentStore::prepareRead(const std::string &key, std::filesystem::path &pathFile)
+{
+    pathFile = createPath(key);
+    if(pathFile.empty()){
+        return false;
+    }
+
+    /* Update last use (also used by other processes) */
+    const auto now = std::filesystem::file_time_type::clock::now();
+
+    std::error_code errId;
+    std::filesystem::last_write_time(pathFile, now, errId);
+    if(errId){
+        return false; // Entry doesn't exist (or has just been evicted)
+    }
+
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapEntries.find(pathFile.filename().string());
+    if(it != m_mapEntries.end()){
+        it->second.lastUse = now;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to index entries of store directory
+ * \details
+ * Mutex must be locked before calling this method.
+ */
+void ContentStore::scan()
+{
+    m_mapEntries.clear();
+    m_sizeTotal = 0;
+
+    std::error_code errId;
+    for(const auto &item : std::filesystem::directory_iterator(m_pathDir, errId)){
+        const std::filesystem::path &pathFile = item.path();
+        if(pathFile.extension() != EXT_DATA){
+            continue; // Temporary files are ignored
+        }
+
+        Entry entry;
+        entry.size = static_cast<size_t>(item.file_size(errId));
+        entry.lastUse = item.last_write_time(errId);
+        if(errId){
+            continue; // Entry has been removed meanwhile
+        }
+
+        m_sizeTotal += entry.size;
+        m_mapEntries.emplace(pathFile.filename().string(), entry);
+    }
+}
+
+/*!
+ * \brief Use to remove least recently used entries
+ * until store size is below its maximum
+ * \details
+ * Mutex must be locked before calling this method.
+ */
+void ContentStore::evict()
+{
+    if(m_sizeMax == 0 || m_sizeTotal <= m_sizeMax){
+        return;
+    }
+
+    /* Sort entries by last use */
+    std::vector<std::pair<std::filesystem::file_time_type, std::string>> listEntries;
+    listEntries.reserve(m_mapEntries.size());
+
+    for(const auto &pair : m_mapEntries){
+        listEntries.emplace_back(pair.second.lastUse, pair.first);
+    }
+    std::sort(listEntries.begin(), listEntries.end());
+
+    /* Remove oldest ones */
+    for(const auto &item : listEntries){
+        if(m_sizeTotal <= m_sizeMax){
+            break;
+        }
+
+        std::error_code errId;
+        std::filesystem::remove(m_pathDir / item.second, errId);
+
+        auto it = m_mapEntries.find(item.second);
+        m_sizeTotal -= it->second.size;
+        m_mapEntries.erase(it);
+    }
+}
+
+/*!
+ * \brief Use to create path of an entry
+ *
+ * \param[in] key
+ * Key of the entry.
+ *
+ * \return
+ * Returns path of the entry file, empty path
+ * if store is disabled.
+ */
+std::filesystem::path ContentStore::createPath(const std::string &key) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    if(m_pathDir.empty()){
+        return std::filesystem::path();
+    }
+
+    Digest::PtrUnique digest = Digest::create(TransferManager::DIGEST_SHA256);
+    digest->update(key.data(), key.size());
+
+    TransferManager::TypeDigest idDigest;
+    std::string hash;
+    Digest::parse(digest->finalize(), idDigest, hash);
+
+    return m_pathDir / (hash + EXT_DATA);
+}
+
+/*!
+ * \brief Use to create header of an entry
+ * \details
+ * Header is made of a magic value, size of the key
+ * (4 bytes, little-endian) and the key itself.
+ *
+ * \param[in] key
+ * Key of the entry.
+ *
+ * \return
+ * Returns header to write before entry content.
+ */
+BytesArray ContentStore::createHeader(const std::string &key)
+{
+    BytesArray header;
+    header.reserve(sizeof(HEADER_MAGIC) - 1 + HEADER_SIZE_LEN + key.size());
+
+    header.pushBack(HEADER_MAGIC);
+    for(int i = 0; i < HEADER_SIZE_LEN; ++i){
+        header.pushBack(static_cast<BytesArray::Byte>((key.size() >> (8 * i)) & 0xFF));
+    }
+    header.pushBack(key);
+
+    return header;
+}
+
+/*!
+ * \brief Use to verify that an entry file start
+ * with expected header
+ *
+ * \param[in, out] inFile
+ * Entry file, read position is moved after the header.
+ * \param[in] header
+ * Expected header, see createHeader().
+ *
+ * \return
+ * Returns \c true if header match.
+ */
+bool ContentStore::matchHeader(std::ifstream &inFile, const BytesArray &header)
+{
+    BytesArray headerFile(header.getSize());
+    if(!inFile || !inFile.read(reinterpret_cast<char*>(headerFile.data()), static_cast<std::streamsize>(headerFile.getSize()))){
+        return false;
+    }
+
+    // Different keys can share the same file name, or entry may have been altered
+    if(headerFile != header){
+        TEASE_LOG_WARN("Content cache entry doesn't match its key, entry is ignored");
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
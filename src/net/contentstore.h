@@ -0,0 +1,61 @@
+#ifndef TEASE_NET_CONTENTSTORE_H
+#define TEASE_NET_CONTENTSTORE_H
+
+#include "transferease/net/mappedfile.h"
+#include "transferease/net/url.h"
+
+#include <filesystem>
+#include <iosfwd>
+#include <mutex>
+#include <unordered_map>
+
+namespace tease
+{
+
+class ContentStore final
+{
+    TEASE_DISABLE_COPY_MOVE(ContentStore)
+
+public:
+    ContentStore();
+
+public:
+    void configure(const std::string &pathDir, size_t sizeMax);
+    bool isEnabled() const;
+
+    bool load(const std::string &key, BytesArray &data);
+    bool map(const std::string &key, MappedFile &file);
+    bool insert(const std::string &key, const BytesArray &data);
+
+public:
+    static std::string createKey(const Url &url, const std::string &digest);
+
+private:
+    struct Entry
+    {
+        size_t size;
+        std::filesystem::file_time_type lastUse;
+    };
+
+private:
+    bool prepareRead(const std::string &key, std::filesystem::path &pathFile);
+    void scan();
+    void evict();
+
+    std::filesystem::path createPath(const std::string &key) const;
+
+    static BytesArray createHeader(const std::string &key);
+    static bool matchHeader(std::ifstream &inFile, const BytesArray &header);
+
+private:
+    std::filesystem::path m_pathDir;
+    size_t m_sizeMax;
+    size_t m_sizeTotal;
+
+    std::unordered_map<std::string, Entry> m_mapEntries; /* Entries indexed by file name */
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_CONTENTSTORE_H
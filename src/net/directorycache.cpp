@@ -0,0 +1,149 @@
+#include "directorycache.h"
+
+#include "net/dnscache.h"
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::DirectoryCache
+ * \brief Keep track of remote directories known
+ * to exist
+ * \details
+ * Used by uploads which must create missing directories:
+ * files uploaded into a known directory can skip creation
+ * of each path component (and associated round trips).
+ *
+ * \note
+ * This class is \em thread-safe
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+/*!
+ * \brief Register directory of a file as existing
+ *
+ * \param[in] url
+ * URL of the file.
+ */
+void DirectoryCache::insert(const Url &url)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_setDirs.insert(createKey(url));
+}
+
+/*!
+ * \brief Forget directory of a file
+ * \details
+ * Should be used when directory may have been
+ * removed from remote.
+ *
+ * \param[in] url
+ * URL of the file.
+ */
+void DirectoryCache::remove(const Url &url)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_setDirs.erase(createKey(url));
+}
+
+void DirectoryCache::clear()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_setDirs.clear();
+}
+
+/*!
+ * \brief Verify if directory of a file is known
+ * to exist
+ *
+ * \param[in] url
+ * URL of the file.
+ *
+ * \return
+ * Returns \c true if directory exist.
+ */
+bool DirectoryCache::contains(const Url &url) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_setDirs.count(createKey(url)) > 0;
+}
+
+/*!
+ * \brief Retrieve files located in unique directories
+ * which are not known yet
+ *
+ * \param[in] listUrls
+ * List of URLs of files.
+ *
+ * \return
+ * Returns one file URL per unknown directory.
+ *
+ * \sa createKey()
+ */
+std::vector<Url> DirectoryCache::listMissing(const std::vector<Url> &listUrls) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    std::vector<Url> listFiles;
+    std::unordered_set<std::string> setSeen;
+
+    for(const Url &url : listUrls){
+        std::string key = createKey(url);
+        if(m_setDirs.count(key) > 0 || !setSeen.insert(std::move(key)).second){
+            continue;
+        }
+
+        listFiles.push_back(url);
+    }
+
+    return listFiles;
+}
+
+/*!
+ * \brief Create key identifying directory of a file
+ *
+ * \param[in] url
+ * URL of the file.
+ *
+ * \return
+ * Returns URL of the directory, with a trailing slash. \n
+ * Port is always set, so that equivalent URLs use the same key.
+ */
+std::string DirectoryCache::createKey(const Url &url)
+{
+    const std::string &path = url.getPath();
+    const size_t posSep = path.rfind('/');
+
+    const std::string dir = (posSep == std::string::npos) ? std::string("/") : path.substr(0, posSep + 1);
+    return StringHelper::format("%s://%s:%u%s", Url::idSchemeToString(url.getIdScheme()).c_str(), url.getHost().c_str(), DnsCache::getPortEffective(url), dir.c_str());
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,38 @@
+#ifndef TEASE_NET_DIRECTORYCACHE_H
+#define TEASE_NET_DIRECTORYCACHE_H
+
+#include "transferease/net/url.h"
+
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace tease
+{
+
+class DirectoryCache final
+{
+    TEASE_DISABLE_COPY_MOVE(DirectoryCache)
+
+public:
+    DirectoryCache() = default;
+
+public:
+    void insert(const Url &url);
+    void remove(const Url &url);
+    void clear();
+
+    bool contains(const Url &url) const;
+    std::vector<Url> listMissing(const std::vector<Url> &listUrls) const;
+
+public:
+    static std::string createKey(const Url &url);
+
+private:
+    std::unordered_set<std::string> m_setDirs;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_DIRECTORYCACHE_H
@@ -0,0 +1,364 @@
+#include "dnscache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#endif
+
+#include "transferease/logs/abstractlogger.h"
+
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::DnsCache
+ * \brief Cache of resolved hosts addresses
+ * \details
+ * Hosts are resolved in parallel by a small pool of resolvers,
+ * resolved addresses are then provided to curl via resolve overrides (see \c CURLOPT_RESOLVE),
+ * so that transfers don't have to wait for DNS lookups. \n
+ * Each entry is only used until its time-to-live expire. \n
+ * Host lookups can't be cancelled: resolvers still running once
+ * wait delay is over are kept (and waited at destruction), they
+ * count in pool capacity until they finish so that unresponsive
+ * DNS servers can't multiply threads.
+ *
+ * \note
+ * This class is \em thread-safe
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define DEFAULT_TIMEOUT     60L /**< Unit in seconds */
+#define NB_MAX_RESOLVERS    4
+
+#define PORT_FTP            21
+#define PORT_FTPS           990
+#define PORT_HTTP           80
+#define PORT_HTTPS          443
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+DnsCache::DnsCache()
+{
+    m_timeout = DEFAULT_TIMEOUT;
+}
+
+/*!
+ * \brief Use to set time-to-live of resolved entries
+ *
+ * \param[in] timeout
+ * Time-to-live in seconds. \n
+ * Use \c 0 to disable the cache.
+ */
+void DnsCache::setTimeout(long timeout)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_timeout = std::max(0L, timeout);
+}
+
+long DnsCache::getTimeout() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_timeout;
+}
+
+/*!
+ * \brief Use to resolve hosts of a list of URLs
+ * \details
+ * Unique hosts are resolved in parallel by at most
+ * \c NB_MAX_RESOLVERS threads, this method return once all
+ * hosts have been resolved or once wait delay is over (remaining
+ * hosts are then ignored, transfers will resolve them themselves).
+ * Hosts already represented by an address are ignored.
+ *
+ * \param[in] listUrls
+ * List of URLs to use.
+ * \param[in] timeoutWait
+ * Maximum wait delay in seconds. \n
+ * Use \c 0 to wait until all hosts are resolved.
+ *
+ * \return
+ * Returns number of hosts which have been resolved.
+ */
+size_t DnsCache::resolve(const std::vector<Url> &listUrls, long timeoutWait)
+{
+    /* List unique hosts to resolve */
+    auto batch = std::make_shared<Batch>();
+    batch->idxNext = 0;
+    batch->abandoned = false;
+
+    for(const Url &url : listUrls){
+        const std::string &host = url.getHost();
+        const uint16_t port = getPortEffective(url);
+
+        const std::string key = createKey(host, port);
+        if(host.empty() || hostIsAddress(host)){
+            continue;
+        }
+
+        auto itFound = std::find_if(batch->listLookups.cbegin(), batch->listLookups.cend(), [&key](const Lookup &lookup){
+            return lookup.key == key;
+        });
+        if(itFound == batch->listLookups.cend()){
+            batch->listLookups.push_back(Lookup{key, host, port, {}, false});
+        }
+    }
+
+    if(batch->listLookups.empty()){
+        return 0;
+    }
+
+    /* Start resolvers (those still blocked by previous calls use pool capacity) */
+    std::vector<std::future<void>> listResolvers;
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        m_listResolvers.erase(std::remove_if(m_listResolvers.begin(), m_listResolvers.end(), [](const std::future<void> &resolver){
+            return resolver.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }), m_listResolvers.end());
+
+        const size_t nbAvailables = NB_MAX_RESOLVERS - std::min<size_t>(NB_MAX_RESOLVERS, m_listResolvers.size());
+        const size_t nbResolvers = std::min(nbAvailables, batch->listLookups.size());
+        for(size_t i = 0; i < nbResolvers; ++i){
+            listResolvers.push_back(std::async(std::launch::async, runLookups, batch));
+        }
+    }
+
+    if(listResolvers.empty()){
+        TEASE_LOG_WARN("All host resolvers are busy, hosts are not resolved");
+        return 0;
+    }
+
+    /* Wait for resolvers, without exceeding wait delay */
+    const Clock::time_point tsLimit = Clock::now() + std::chrono::seconds(timeoutWait);
+    for(auto it = listResolvers.begin(); it != listResolvers.end(); ++it){
+        if(timeoutWait <= 0){
+            it->wait();
+
+        }else if(it->wait_until(tsLimit) != std::future_status::ready){
+            // Resolvers can't be cancelled, keep them until they finish
+            std::lock_guard<std::mutex> locker(m_mutex);
+            std::move(it, listResolvers.end(), std::back_inserter(m_listResolvers));
+
+            const std::string err = StringHelper::format("Hosts resolution takes too long, remaining hosts are ignored [timeout: %ld]", timeoutWait);
+            TEASE_LOG_WARN(err);
+            break;
+        }
+    }
+
+    /* Register resolved addresses */
+    std::lock_guard<std::mutex> lockerBatch(batch->mutex);
+    batch->abandoned = true;
+
+    size_t nbResolved = 0;
+    for(Lookup &lookup : batch->listLookups){
+        if(!lookup.done || lookup.listAddrs.empty()){
+            continue;
+        }
+
+        Entry entry;
+        entry.host = lookup.host;
+        entry.port = lookup.port;
+        entry.listAddrs = std::move(lookup.listAddrs);
+
+        std::lock_guard<std::mutex> locker(m_mutex);
+        entry.tsExpire = Clock::now() + std::chrono::seconds(m_timeout);
+        m_mapEntries[lookup.key] = std::move(entry);
+
+        ++nbResolved;
+    }
+
+    return nbResolved;
+}
+
+/*!
+ * \brief Use to retrieve resolve override to use
+ * for an URL
+ *
+ * \param[in] url
+ * URL to use.
+ *
+ * \return
+ * Returns resolve entry, with format <tt>+host:port:addr1,addr2</tt>
+ * (\c + prefix allowing curl to expire the entry like any other
+ * resolved host). \n
+ * Returns an empty string if host hasn't been resolved or if
+ * entry has expired.
+ */
+std::string DnsCache::getResolveEntry(const Url &url) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapEntries.find(createKey(url.getHost(), getPortEffective(url)));
+    if(it == m_mapEntries.end() || it->second.tsExpire <= Clock::now()){
+        return std::string();
+    }
+
+    const Entry &entry = it->second;
+
+    std::string resolve = StringHelper::format("+%s:%u:", entry.host.c_str(), entry.port);
+    for(size_t i = 0; i < entry.listAddrs.size(); ++i){
+        if(i > 0){
+            resolve += ',';
+        }
+        resolve += entry.listAddrs[i];
+    }
+
+    return resolve;
+}
+
+/*!
+ * \brief Retrieve port used by an URL
+ *
+ * \param[in] url
+ * URL to use.
+ *
+ * \return
+ * Returns URL port, or default port of scheme
+ * if not set.
+ */
+uint16_t DnsCache::getPortEffective(const Url &url)
+{
+    if(url.getPort() != 0){
+        return url.getPort();
+    }
+
+    switch(url.getIdScheme())
+    {
+        case Url::SCHEME_FTP:   return PORT_FTP;
+        case Url::SCHEME_FTPS:  return PORT_FTPS;
+        case Url::SCHEME_HTTP:  return PORT_HTTP;
+        case Url::SCHEME_HTTPS: return PORT_HTTPS;
+
+        default: break;
+    }
+
+    return 0;
+}
+
+std::string DnsCache::createKey(const std::string &host, uint16_t port)
+{
+    return host + ":" + std::to_string(port);
+}
+
+bool DnsCache::hostIsAddress(const std::string &host)
+{
+    unsigned char buffer[sizeof(struct in6_addr)];
+    return inet_pton(AF_INET, host.c_str(), buffer) == 1
+        || inet_pton(AF_INET6, host.c_str(), buffer) == 1;
+}
+
+std::vector<std::string> DnsCache::resolveHost(const std::string &host, uint16_t port)
+{
+    std::vector<std::string> listAddrs;
+
+    /* Resolve host */
+    struct addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo *listInfos = nullptr;
+    const int idErr = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &listInfos);
+    if(idErr != 0){
+        const std::string err = StringHelper::format("Failed to resolve host [host: %s, id-err: %d]", host.c_str(), idErr);
+        TEASE_LOG_WARN(err);
+        return listAddrs;
+    }
+
+    /* Convert addresses (IPv6 ones must use brackets) */
+    for(const struct addrinfo *info = listInfos; info; info = info->ai_next){
+        char buffer[INET6_ADDRSTRLEN] = {};
+        std::string addr;
+
+        if(info->ai_family == AF_INET){
+            const auto *sockAddr = reinterpret_cast<const struct sockaddr_in*>(info->ai_addr);
+            if(inet_ntop(AF_INET, &sockAddr->sin_addr, buffer, sizeof(buffer))){
+                addr = buffer;
+            }
+
+        }else if(info->ai_family == AF_INET6){
+            const auto *sockAddr = reinterpret_cast<const struct sockaddr_in6*>(info->ai_addr);
+            if(inet_ntop(AF_INET6, &sockAddr->sin6_addr, buffer, sizeof(buffer))){
+                addr = std::string("[") + buffer + "]";
+            }
+        }
+
+        if(!addr.empty() && std::find(listAddrs.begin(), listAddrs.end(), addr) == listAddrs.end()){
+            listAddrs.push_back(addr);
+        }
+    }
+
+    freeaddrinfo(listInfos);
+    return listAddrs;
+}
+
+/*!
+ * \brief Resolve hosts of a batch until none remains
+ * \details
+ * Run by each resolver of the batch, stop once batch
+ * is abandoned by caller.
+ *
+ * \param[in] batch
+ * Batch to use.
+ */
+void DnsCache::runLookups(std::shared_ptr<Batch> batch)
+{
+    for(;;){
+        std::string host;
+        uint16_t port;
+        size_t idxLookup;
+        {
+            std::lock_guard<std::mutex> locker(batch->mutex);
+            if(batch->abandoned || batch->idxNext >= batch->listLookups.size()){
+                return;
+            }
+
+            idxLookup = batch->idxNext++;
+            host = batch->listLookups[idxLookup].host;
+            port = batch->listLookups[idxLookup].port;
+        }
+
+        std::vector<std::string> listAddrs = resolveHost(host, port);
+
+        std::lock_guard<std::mutex> locker(batch->mutex);
+        if(!batch->abandoned){
+            batch->listLookups[idxLookup].listAddrs = std::move(listAddrs);
+            batch->listLookups[idxLookup].done = true;
+        }
+    }
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,82 @@
+#ifndef TEASE_NET_DNSCACHE_H
+#define TEASE_NET_DNSCACHE_H
+
+#include "transferease/net/url.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tease
+{
+
+class DnsCache final
+{
+    TEASE_DISABLE_COPY_MOVE(DnsCache)
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    DnsCache();
+
+public:
+    void setTimeout(long timeout);
+    long getTimeout() const;
+
+    size_t resolve(const std::vector<Url> &listUrls, long timeoutWait);
+    std::string getResolveEntry(const Url &url) const;
+
+public:
+    static uint16_t getPortEffective(const Url &url);
+
+private:
+    struct Entry
+    {
+        std::string host;
+        uint16_t port;
+
+        std::vector<std::string> listAddrs;
+        Clock::time_point tsExpire;
+    };
+
+    struct Lookup
+    {
+        std::string key;
+        std::string host;
+        uint16_t port;
+
+        std::vector<std::string> listAddrs;
+        bool done;
+    };
+
+    struct Batch
+    {
+        std::vector<Lookup> listLookups;
+        size_t idxNext;
+        bool abandoned;
+
+        std::mutex mutex;
+    };
+
+private:
+    static std::string createKey(const std::string &host, uint16_t port);
+    static bool hostIsAddress(const std::string &host);
+    static std::vector<std::string> resolveHost(const std::string &host, uint16_t port);
+    static void runLookups(std::shared_ptr<Batch> batch);
+
+private:
+    std::unordered_map<std::string, Entry> m_mapEntries;
+    long m_timeout;
+
+    std::vector<std::future<void>> m_listResolvers;
+
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_DNSCACHE_H
@@ -0,0 +1,72 @@
+#include "ftphelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::FtpHelper
+ * \brief Helpers used to configure FTP transfers
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+/*!
+ * \brief Use to retrieve curl FTP file method
+ * to use
+ *
+ * \param[in] method
+ * Method configured on the manager.
+ * \param[in] createDirs
+ * Set to \c true if missing directories must be created,
+ * which can only be performed one by one.
+ *
+ * \return
+ * Returns value to use with \c CURLOPT_FTP_FILEMETHOD.
+ *
+ * \sa TransferManager::setFtpMethod()
+ */
+long FtpHelper::getFileMethod(TransferManager::TypeFtpMethod method, bool createDirs)
+{
+    if(createDirs){
+        return CURLFTPMETHOD_MULTICWD;
+    }
+
+    switch(method)
+    {
+        case TransferManager::FTP_METHOD_AUTO:
+        case TransferManager::FTP_METHOD_SINGLECWD: return CURLFTPMETHOD_SINGLECWD;
+        case TransferManager::FTP_METHOD_NOCWD:     return CURLFTPMETHOD_NOCWD;
+
+        default: break;
+    }
+
+    return CURLFTPMETHOD_MULTICWD;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,19 @@
+#ifndef TEASE_NET_FTPHELPER_H
+#define TEASE_NET_FTPHELPER_H
+
+#include "transferease/transfermanager.h"
+
+#include <curl/curl.h>
+
+namespace tease
+{
+
+class FtpHelper final
+{
+public:
+    static long getFileMethod(TransferManager::TypeFtpMethod method, bool createDirs);
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_FTPHELPER_H
@@ -0,0 +1,245 @@
+#include "handletemplates.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::HandleTemplates
+ * \brief Easy handles configured once and
+ * cloned for each transfer
+ * \details
+ * Options which only depend on manager configuration
+ * (credentials, timeouts, callbacks, etc...) are set on
+ * a template handle per scheme and type of transfer. \n
+ * Handles of transfers are duplicated from it, so that only
+ * options specific to the request (URL, private datas, I/O
+ * pointers, etc...) have to be set. \n
+ * Handles of transfers performed one at a time can also be
+ * kept idle after use (see acquireHandle()), avoiding any
+ * duplication while scheme and type of transfer don't change. \n
+ * Configuration is retrieved by callers along with current
+ * generation (see getGeneration()), a template is only kept
+ * if no invalidation occurred meanwhile.
+ *
+ * \note
+ * Curl doesn't copy share handle nor lists (\c curl_slist)
+ * when duplicating a handle: those must not be set on
+ * templates.
+ *
+ * \note
+ * This class is \em thread-safe
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+HandleTemplates::~HandleTemplates()
+{
+    invalidate();
+}
+
+/*!
+ * \brief Use to retrieve current generation of templates
+ * \details
+ * Generation must be read along with the configuration
+ * given to createHandle() or acquireHandle(): templates
+ * are only kept when both still match.
+ *
+ * \return
+ * Returns current generation, incremented at
+ * each invalidate().
+ */
+int HandleTemplates::getGeneration() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_generation;
+}
+
+/*!
+ * \brief Use to create a configured handle
+ *
+ * \param[in] idScheme
+ * Scheme of the transfer URL.
+ * \param[in] typeTransfer
+ * Type of the transfer.
+ * \param[in] generation
+ * Generation read with getGeneration() when
+ * configuration used by \c fctConfigure was retrieved.
+ * \param[in] fctConfigure
+ * Function used to configure the template if it
+ * must be built.
+ *
+ * \return
+ * Returns handle to use, caller owns it. \n
+ * Returns \c nullptr if failed to create it.
+ */
+CURL* HandleTemplates::createHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation, const FctConfigure &fctConfigure)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return duplicate(Key(idScheme, typeTransfer), generation, fctConfigure);
+}
+
+/*!
+ * \brief Use to retrieve a configured handle which
+ * will be given back once used
+ * \details
+ * Idle handle of same scheme and type of transfer is
+ * used if any, otherwise a new one is created. \n
+ * Options specific to previous request are kept, so
+ * they must all be set again (lists and pointers
+ * included, even to \c nullptr).
+ *
+ * \param[in] idScheme
+ * Scheme of the transfer URL.
+ * \param[in] typeTransfer
+ * Type of the transfer.
+ * \param[in] generation
+ * Generation read with getGeneration() when
+ * configuration used by \c fctConfigure was retrieved,
+ * it must also be given to releaseHandle().
+ * \param[in] fctConfigure
+ * Function used to configure the template if it
+ * must be built.
+ *
+ * \return
+ * Returns handle to use, it must be given back with
+ * releaseHandle(). \n
+ * Returns \c nullptr if failed to create it.
+ */
+CURL* HandleTemplates::acquireHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation, const FctConfigure &fctConfigure)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    const Key key(idScheme, typeTransfer);
+    auto it = m_mapTemplates.find(key);
+    if(generation == m_generation && it != m_mapTemplates.end() && !it->second.listIdle.empty()){
+        CURL *handle = it->second.listIdle.back();
+        it->second.listIdle.pop_back();
+
+        return handle;
+    }
+
+    return duplicate(key, generation, fctConfigure);
+}
+
+/*!
+ * \brief Use to give back a handle retrieved
+ * with acquireHandle()
+ * \details
+ * Handle is kept idle, unless templates have been
+ * invalidated since it was acquired: it is then
+ * destroyed since its configuration is outdated.
+ *
+ * \param[in] handle
+ * Handle to give back.
+ * \param[in] idScheme
+ * Scheme used to acquire the handle.
+ * \param[in] typeTransfer
+ * Type of transfer used to acquire the handle.
+ * \param[in] generation
+ * Generation given to acquireHandle().
+ */
+void HandleTemplates::releaseHandle(CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapTemplates.find(Key(idScheme, typeTransfer));
+    if(generation != m_generation || it == m_mapTemplates.end()){
+        curl_easy_cleanup(handle);
+        return;
+    }
+
+    it->second.listIdle.push_back(handle);
+}
+
+/*!
+ * \brief Use to remove all templates
+ * \details
+ * Must be called each time configuration used by templates
+ * is modified, templates will be built again when needed. \n
+ * Idle handles are destroyed, handles already created are
+ * not impacted.
+ */
+void HandleTemplates::invalidate()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    for(const auto &entry : m_mapTemplates){
+        for(CURL *handle : entry.second.listIdle){
+            curl_easy_cleanup(handle);
+        }
+        curl_easy_cleanup(entry.second.handleTemplate);
+    }
+    m_mapTemplates.clear();
+    ++m_generation;
+}
+
+/*!
+ * \brief Use to duplicate template of a scheme and
+ * type of transfer, template is built if needed
+ * \details
+ * Caller must hold \c m_mutex. \n
+ * When templates have been invalidated since configuration
+ * was retrieved, handle is configured on its own and no
+ * template is kept: it would be outdated.
+ *
+ * \param[in] key
+ * Scheme and type of transfer.
+ * \param[in] generation
+ * Generation of the configuration used by \c fctConfigure.
+ * \param[in] fctConfigure
+ * Function used to configure the template.
+ *
+ * \return
+ * Returns handle to use, caller owns it. \n
+ * Returns \c nullptr if failed to create it.
+ */
+CURL* HandleTemplates::duplicate(const Key &key, int generation, const FctConfigure &fctConfigure)
+{
+    /* Build template if needed */
+    auto it = m_mapTemplates.find(key);
+    if(generation != m_generation || it == m_mapTemplates.end()){
+        CURL *handle = curl_easy_init();
+        if(!handle){
+            return nullptr;
+        }
+
+        fctConfigure(handle, key.first, key.second);
+        if(generation != m_generation){
+            return handle;
+        }
+
+        it = m_mapTemplates.emplace(key, Entry()).first;
+        it->second.handleTemplate = handle;
+    }
+
+    /* Clone it */
+    return curl_easy_duphandle(it->second.handleTemplate);
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
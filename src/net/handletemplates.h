@@ -0,0 +1,54 @@
+#ifndef TEASE_NET_HANDLETEMPLATES_H
+#define TEASE_NET_HANDLETEMPLATES_H
+
+#include "transferease/net/request.h"
+
+#include <curl/curl.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace tease
+{
+
+class HandleTemplates final
+{
+    TEASE_DISABLE_COPY_MOVE(HandleTemplates)
+
+public:
+    using FctConfigure = std::function<void(CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer)>;
+
+public:
+    HandleTemplates() = default;
+    ~HandleTemplates();
+
+public:
+    int getGeneration() const;
+
+    CURL* createHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation, const FctConfigure &fctConfigure);
+    CURL* acquireHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation, const FctConfigure &fctConfigure);
+    void releaseHandle(CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int generation);
+    void invalidate();
+
+private:
+    using Key = std::pair<Url::IdScheme, Request::TypeTransfer>;
+
+    struct Entry
+    {
+        CURL *handleTemplate = nullptr;
+        std::vector<CURL*> listIdle;    /* Handles given back, ready to be used again */
+    };
+
+private:
+    CURL* duplicate(const Key &key, int generation, const FctConfigure &fctConfigure);
+
+private:
+    std::map<Key, Entry> m_mapTemplates;
+    int m_generation = 0;               /* Incremented at each invalidation */
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_HANDLETEMPLATES_H
@@ -0,0 +1,646 @@
+#include "httpcache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "transferease/logs/abstractlogger.h"
+
+#include "tools/digest.h"
+#include "tools/filesystemhelper.h"
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::HttpCache
+ * \brief Store HTTP responses bodies with
+ * their validators
+ * \details
+ * Validators (\c ETag and \c Last-Modified) are used to send
+ * conditional requests: if remote answer <tt>304 Not Modified</tt>,
+ * stored body is used instead of downloading it again. \n
+ * Entries can be stored on disk (kept between sessions), in memory,
+ * or both (memory is then used as a first level cache). \n
+ * On disk, each entry is a single file named from the SHA-256 hash
+ * of its key (stable across builds sharing the directory). It starts
+ * with a header holding the key, the validators and the digest of
+ * the body: key and digest are verified on each read, so an entry is
+ * never delivered for another key nor with an altered body. Files are
+ * written atomically, readers never observe a partially written entry. \n
+ * When a maximum size is configured, least recently used entries
+ * are removed once it is exceeded (memory and disk storages are
+ * limited separately).
+ *
+ * \note
+ * This class is \em thread-safe.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define EXT_ENTRY       ".entry"
+
+#define HEADER_MAGIC    "TEASEHC1"
+#define HEADER_SIZE_LEN 4
+#define HEADER_SIZE_MAX 65536   /**< Unit in bytes, bigger headers are considered altered */
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+bool HttpCache::Validators::isEmpty() const
+{
+    return etag.empty() && lastModified.empty();
+}
+
+HttpCache::HttpCache() :
+    m_inMemory(false), m_sizeMax(0),
+    m_sizeMemory(0), m_nbUses(0), m_sizeFiles(0),
+    m_nbHits(0), m_nbMisses(0), m_nbRevalidations(0), m_nbBytesSaved(0)
+{
+
+}
+
+/*!
+ * \brief Use to configure cache storage
+ *
+ * \param[in] pathDir
+ * Directory where entries are stored, use an
+ * empty path to disable disk storage. \n
+ * Directory is created if needed.
+ * \param[in] inMemory
+ * Set to \c true to keep entries in memory.
+ * \param[in] sizeMax
+ * Maximum size in bytes of each storage, \c 0
+ * for no limit.
+ *
+ * \note
+ * Entries kept in memory are cleared.
+ */
+void HttpCache::configure(const std::string &pathDir, bool inMemory, size_t sizeMax)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    m_pathDir = pathDir;
+    m_inMemory = inMemory;
+    m_sizeMax = sizeMax;
+
+    m_mapEntries.clear();
+    m_sizeMemory = 0;
+    m_mapFiles.clear();
+    m_sizeFiles = 0;
+
+    if(m_pathDir.empty()){
+        return;
+    }
+
+    FileSystemHelper::createDirectories(m_pathDir);
+    scan();
+    evictFiles();
+}
+
+bool HttpCache::isEnabled() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_inMemory || !m_pathDir.empty();
+}
+
+/*!
+ * \brief Retrieve validators of a stored entry
+ *
+ * \param[in] key
+ * Key of the entry (usually its URL).
+ * \param[out] validators
+ * Validators of the entry.
+ *
+ * \return
+ * Returns \c true if entry exist and has validators.
+ */
+bool HttpCache::getValidators(const std::string &key, Validators &validators) const
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        auto it = m_mapEntries.find(key);
+        if(it != m_mapEntries.end()){
+            validators = it->second.validators;
+            return true;
+        }
+    }
+
+    const std::filesystem::path pathFile = createPath(key);
+    if(pathFile.empty()){
+        return false;
+    }
+
+    std::ifstream inFile(pathFile, std::ios::in | std::ios::binary);
+    std::string digest;
+
+    return readHeader(inFile, key, validators, digest);
+}
+
+/*!
+ * \brief Use to load body of a stored entry
+ * \details
+ * Entry last use is updated.
+ *
+ * \param[in] key
+ * Key of the entry.
+ * \param[out] body
+ * Stored body.
+ *
+ * \return
+ * Returns \c true if succeed, \c false if entry
+ * doesn't exist or has been altered.
+ */
+bool HttpCache::load(const std::string &key, BytesArray &body)
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        auto it = m_mapEntries.find(key);
+        if(it != m_mapEntries.end()){
+            it->second.lastUse = ++m_nbUses;
+            body = it->second.body;
+            return true;
+        }
+    }
+
+    const std::filesystem::path pathFile = createPath(key);
+    if(pathFile.empty()){
+        return false;
+    }
+
+    /* Update last use (also used by other processes) */
+    const auto now = std::filesystem::file_time_type::clock::now();
+
+    std::error_code errId;
+    std::filesystem::last_write_time(pathFile, now, errId);
+    if(errId){
+        return false; // Entry doesn't exist (or has just been evicted)
+    }
+
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        auto it = m_mapFiles.find(pathFile.filename().string());
+        if(it != m_mapFiles.end()){
+            it->second.lastUse = now;
+        }
+    }
+
+    /* Read body */
+    std::ifstream inFile(pathFile, std::ios::in | std::ios::binary);
+    Validators validators;
+    std::string digest;
+    if(!readHeader(inFile, key, validators, digest)){
+        return false;
+    }
+
+    const std::streamoff posBody = inFile.tellg();
+    inFile.seekg(0, std::ios::end);
+    const std::streamoff sizeFile = inFile.tellg();
+    inFile.seekg(posBody, std::ios::beg);
+
+    body.resize(static_cast<size_t>(sizeFile - posBody));
+    inFile.read(reinterpret_cast<char*>(body.data()), static_cast<std::streamsize>(body.getSize()));
+    if(!inFile || computeDigest(body) != digest){
+        TEASE_LOG_WARN("HTTP cache entry body doesn't match its digest, entry is ignored");
+        body.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to store an entry
+ * \details
+ * Any previous entry using the same key is replaced. \n
+ * Least recently used entries are evicted if
+ * maximum size is exceeded.
+ *
+ * \param[in] key
+ * Key of the entry.
+ * \param[in] validators
+ * Validators received with the body. \n
+ * If empty, entry is not stored (it could never be revalidated)
+ * and any previous entry is removed.
+ * \param[in] body
+ * Body to store. \n
+ * Bodies bigger than maximum size are not stored
+ * (any previous entry is removed).
+ */
+void HttpCache::store(const std::string &key, const Validators &validators, const BytesArray &body)
+{
+    if(validators.isEmpty()){
+        remove(key);
+        return;
+    }
+
+    const std::filesystem::path pathFile = createPath(key);
+
+    BytesArray header;
+    if(!pathFile.empty()){
+        header = createHeader(key, validators, computeDigest(body));
+    }
+
+    /* Entries bigger than cache are never stored */
+    bool isTooBig = false;
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        isTooBig = m_sizeMax > 0 && header.getSize() + body.getSize() > m_sizeMax;
+    }
+
+    if(isTooBig){
+        remove(key);
+        return;
+    }
+
+    /* Store in memory */
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        if(m_inMemory){
+            Entry &entry = m_mapEntries[key];
+            m_sizeMemory = m_sizeMemory - entry.body.getSize() + body.getSize();
+
+            entry.validators = validators;
+            entry.body = body;
+            entry.lastUse = ++m_nbUses;
+
+            evictMemory();
+        }
+    }
+
+    /* Store on disk */
+    if(pathFile.empty() || !FileSystemHelper::writeFileAtomic(pathFile, header, body)){
+        return;
+    }
+
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    const size_t sizeEntry = header.getSize() + body.getSize();
+    File &file = m_mapFiles[pathFile.filename().string()];
+    m_sizeFiles = m_sizeFiles - file.size + sizeEntry;
+
+    file.size = sizeEntry;
+    file.lastUse = std::filesystem::file_time_type::clock::now();
+
+    if(m_sizeMax > 0 && m_sizeFiles > m_sizeMax){
+        scan();
+        evictFiles();
+    }
+}
+
+void HttpCache::remove(const std::string &key)
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        auto it = m_mapEntries.find(key);
+        if(it != m_mapEntries.end()){
+            m_sizeMemory -= it->second.body.getSize();
+            m_mapEntries.erase(it);
+        }
+    }
+
+    const std::filesystem::path pathFile = createPath(key);
+    if(pathFile.empty()){
+        return;
+    }
+
+    std::error_code errId;
+    std::filesystem::remove(pathFile, errId);
+
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapFiles.find(pathFile.filename().string());
+    if(it != m_mapFiles.end()){
+        m_sizeFiles -= it->second.size;
+        m_mapFiles.erase(it);
+    }
+}
+
+/*!
+ * \brief Register a request served from cache
+ *
+ * \param[in] nbBytes
+ * Size of the body served from cache.
+ */
+void HttpCache::registerHit(size_t nbBytes)
+{
+    ++m_nbHits;
+    ++m_nbRevalidations;
+    m_nbBytesSaved += nbBytes;
+}
+
+/*!
+ * \brief Register a request which body has been downloaded
+ *
+ * \param[in] revalidated
+ * Set to \c true if a conditional request was sent
+ * (meaning that stored entry was outdated).
+ */
+void HttpCache::registerMiss(bool revalidated)
+{
+    ++m_nbMisses;
+    if(revalidated){
+        ++m_nbRevalidations;
+    }
+}
+
+TransferManager::HttpCacheStats HttpCache::getStats() const
+{
+    TransferManager::HttpCacheStats stats;
+    stats.nbHits = m_nbHits;
+    stats.nbMisses = m_nbMisses;
+    stats.nbRevalidations = m_nbRevalidations;
+    stats.nbBytesSaved = m_nbBytesSaved;
+
+    return stats;
+}
+
+/*!
+ * \brief Use to know if a response can be stored
+ *
+ * \param[in] cacheControl
+ * Value of header \c Cache-Control of the response.
+ *
+ * \return
+ * Returns \c false if response use directive
+ * \c no-store or \c private.
+ */
+bool HttpCache::isStorable(const std::string &cacheControl)
+{
+    for(const std::string &directive : StringHelper::split(cacheControl, ",")){
+        // Field names given to "private" are ignored, the whole response is considered private
+        const std::string name = StringHelper::toLower(StringHelper::trim(directive.substr(0, directive.find('='))));
+        if(name == "no-store" || name == "private"){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to index entries of cache directory
+ * \details
+ * Mutex must be locked before calling this method.
+ */
+void HttpCache::scan()
+{
+    m_mapFiles.clear();
+    m_sizeFiles = 0;
+
+    std::error_code errId;
+    for(const auto &item : std::filesystem::directory_iterator(m_pathDir, errId)){
+        const std::filesystem::path &pathFile = item.path();
+        if(pathFile.extension() != EXT_ENTRY){
+            continue; // Temporary files are ignored
+        }
+
+        File file;
+        file.size = static_cast<size_t>(item.file_size(errId));
+        file.lastUse = item.last_write_time(errId);
+        if(errId){
+            continue; // Entry has been removed meanwhile
+        }
+
+        m_sizeFiles += file.size;
+        m_mapFiles.emplace(pathFile.filename().string(), file);
+    }
+}
+
+/*!
+ * \brief Use to remove least recently used entries
+ * kept in memory until their size is below maximum
+ * \details
+ * Mutex must be locked before calling this method.
+ */
+void HttpCache::evictMemory()
+{
+    if(m_sizeMax == 0 || m_sizeMemory <= m_sizeMax){
+        return;
+    }
+
+    /* Sort entries by last use */
+    std::vector<std::pair<size_t, std::string>> listEntries;
+    listEntries.reserve(m_mapEntries.size());
+
+    for(const auto &pair : m_mapEntries){
+        listEntries.emplace_back(pair.second.lastUse, pair.first);
+    }
+    std::sort(listEntries.begin(), listEntries.end());
+
+    /* Remove oldest ones */
+    for(const auto &item : listEntries){
+        if(m_sizeMemory <= m_sizeMax){
+            break;
+        }
+
+        auto it = m_mapEntries.find(item.second);
+        m_sizeMemory -= it->second.body.getSize();
+        m_mapEntries.erase(it);
+    }
+}
+
+/*!
+ * \brief Use to remove least recently used entries
+ * stored on disk until their size is below maximum
+ * \details
+ * Mutex must be locked before calling this method.
+ */
+void HttpCache::evictFiles()
+{
+    if(m_sizeMax == 0 || m_sizeFiles <= m_sizeMax){
+        return;
+    }
+
+    /* Sort entries by last use */
+    std::vector<std::pair<std::filesystem::file_time_type, std::string>> listEntries;
+    listEntries.reserve(m_mapFiles.size());
+
+    for(const auto &pair : m_mapFiles){
+        listEntries.emplace_back(pair.second.lastUse, pair.first);
+    }
+    std::sort(listEntries.begin(), listEntries.end());
+
+    /* Remove oldest ones */
+    for(const auto &item : listEntries){
+        if(m_sizeFiles <= m_sizeMax){
+            break;
+        }
+
+        std::error_code errId;
+        std::filesystem::remove(m_pathDir / item.second, errId);
+
+        auto it = m_mapFiles.find(item.second);
+        m_sizeFiles -= it->second.size;
+        m_mapFiles.erase(it);
+    }
+}
+
+/*!
+ * \brief Use to create path of an entry file
+ *
+ * \param[in] key
+ * Key of the entry.
+ *
+ * \return
+ * Returns path of the file, empty path if disk
+ * storage is disabled.
+ */
+std::filesystem::path HttpCache::createPath(const std::string &key) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    if(m_pathDir.empty()){
+        return std::filesystem::path();
+    }
+
+    Digest::PtrUnique digest = Digest::create(TransferManager::DIGEST_SHA256);
+    digest->update(key.data(), key.size());
+
+    TransferManager::TypeDigest idDigest;
+    std::string hash;
+    Digest::parse(digest->finalize(), idDigest, hash);
+
+    return m_pathDir / (hash + EXT_ENTRY);
+}
+
+/*!
+ * \brief Use to create header of an entry file
+ * \details
+ * Header is made of a magic value, size of the
+ * metadatas (4 bytes, little-endian) and the metadatas
+ * themselves: one line for the key, each validator and
+ * the digest of the body.
+ *
+ * \param[in] key
+ * Key of the entry.
+ * \param[in] validators
+ * Validators of the entry.
+ * \param[in] digest
+ * Digest of the body, see computeDigest().
+ *
+ * \return
+ * Returns header to write before entry body.
+ */
+BytesArray HttpCache::createHeader(const std::string &key, const Validators &validators, const std::string &digest)
+{
+    const std::string meta = key + '\n' + validators.etag + '\n' + validators.lastModified + '\n' + digest + '\n';
+
+    BytesArray header;
+    header.reserve(sizeof(HEADER_MAGIC) - 1 + HEADER_SIZE_LEN + meta.size());
+
+    header.pushBack(HEADER_MAGIC);
+    for(int i = 0; i < HEADER_SIZE_LEN; ++i){
+        header.pushBack(static_cast<BytesArray::Byte>((meta.size() >> (8 * i)) & 0xFF));
+    }
+    header.pushBack(meta);
+
+    return header;
+}
+
+/*!
+ * \brief Use to read header of an entry file
+ *
+ * \param[in, out] inFile
+ * Entry file, read position is moved after the header.
+ * \param[in] key
+ * Key of the entry.
+ * \param[out] validators
+ * Validators of the entry.
+ * \param[out] digest
+ * Digest of the entry body.
+ *
+ * \return
+ * Returns \c true if header is valid and belongs
+ * to the entry key.
+ */
+bool HttpCache::readHeader(std::ifstream &inFile, const std::string &key, Validators &validators, std::string &digest)
+{
+    /* Read metadatas */
+    constexpr size_t sizeMagic = sizeof(HEADER_MAGIC) - 1;
+
+    char prefix[sizeMagic + HEADER_SIZE_LEN];
+    if(!inFile || !inFile.read(prefix, sizeof(prefix)) || std::memcmp(prefix, HEADER_MAGIC, sizeMagic) != 0){
+        return false;
+    }
+
+    size_t sizeMeta = 0;
+    for(int i = 0; i < HEADER_SIZE_LEN; ++i){
+        sizeMeta |= static_cast<size_t>(static_cast<unsigned char>(prefix[sizeMagic + i])) << (8 * i);
+    }
+    if(sizeMeta > HEADER_SIZE_MAX){
+        return false;
+    }
+
+    std::string meta(sizeMeta, '\0');
+    if(!inFile.read(meta.data(), static_cast<std::streamsize>(meta.size()))){
+        return false;
+    }
+
+    /* Parse lines: key, etag, last-modified, digest */
+    const size_t posKey = meta.find('\n');
+    const size_t posEtag = meta.find('\n', posKey + 1);
+    const size_t posDate = meta.find('\n', posEtag + 1);
+    const size_t posDigest = meta.find('\n', posDate + 1);
+    if(posKey == std::string::npos || posEtag == std::string::npos || posDate == std::string::npos || posDigest == std::string::npos){
+        TEASE_LOG_WARN("HTTP cache entry header is invalid, entry is ignored");
+        return false;
+    }
+
+    // Different keys can share the same file name
+    if(meta.compare(0, posKey, key) != 0){
+        return false;
+    }
+
+    validators.etag = meta.substr(posKey + 1, posEtag - posKey - 1);
+    validators.lastModified = meta.substr(posEtag + 1, posDate - posEtag - 1);
+    digest = meta.substr(posDate + 1, posDigest - posDate - 1);
+
+    return true;
+}
+
+/*!
+ * \brief Use to compute digest of an entry body
+ *
+ * \param[in] body
+ * Body to use.
+ *
+ * \return
+ * Returns SHA-256 digest of the body.
+ */
+std::string HttpCache::computeDigest(const BytesArray &body)
+{
+    Digest::PtrUnique digest = Digest::create(TransferManager::DIGEST_SHA256);
+    digest->update(body.dataConst(), body.getSize());
+
+    return digest->finalize();
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
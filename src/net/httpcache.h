@@ -0,0 +1,94 @@
+#ifndef TEASE_NET_HTTPCACHE_H
+#define TEASE_NET_HTTPCACHE_H
+
+#include "transferease/transfermanager.h"
+
+#include <atomic>
+#include <filesystem>
+#include <iosfwd>
+#include <mutex>
+#include <unordered_map>
+
+namespace tease
+{
+
+class HttpCache final
+{
+    TEASE_DISABLE_COPY_MOVE(HttpCache)
+
+public:
+    struct Validators
+    {
+        std::string etag;           /* Value of header "ETag" */
+        std::string lastModified;   /* Value of header "Last-Modified" */
+
+        bool isEmpty() const;
+    };
+
+public:
+    HttpCache();
+
+public:
+    void configure(const std::string &pathDir, bool inMemory, size_t sizeMax = 0);
+    bool isEnabled() const;
+
+    bool getValidators(const std::string &key, Validators &validators) const;
+    bool load(const std::string &key, BytesArray &body);
+    void store(const std::string &key, const Validators &validators, const BytesArray &body);
+    void remove(const std::string &key);
+
+    void registerHit(size_t nbBytes);
+    void registerMiss(bool revalidated);
+    TransferManager::HttpCacheStats getStats() const;
+
+public:
+    static bool isStorable(const std::string &cacheControl);
+
+private:
+    struct Entry
+    {
+        Validators validators;
+        BytesArray body;
+        size_t lastUse;                 /* Value of use counter */
+    };
+
+    struct File
+    {
+        size_t size;
+        std::filesystem::file_time_type lastUse;
+    };
+
+private:
+    void scan();
+    void evictMemory();
+    void evictFiles();
+
+    std::filesystem::path createPath(const std::string &key) const;
+
+    static BytesArray createHeader(const std::string &key, const Validators &validators, const std::string &digest);
+    static bool readHeader(std::ifstream &inFile, const std::string &key, Validators &validators, std::string &digest);
+    static std::string computeDigest(const BytesArray &body);
+
+private:
+    std::filesystem::path m_pathDir;
+    bool m_inMemory;
+    size_t m_sizeMax;
+
+    std::unordered_map<std::string, Entry> m_mapEntries; /* Entries kept in memory, indexed by key */
+    size_t m_sizeMemory;
+    size_t m_nbUses;
+
+    std::unordered_map<std::string, File> m_mapFiles;    /* Entries stored on disk, indexed by file name */
+    size_t m_sizeFiles;
+
+    mutable std::mutex m_mutex;
+
+    std::atomic<size_t> m_nbHits;
+    std::atomic<size_t> m_nbMisses;
+    std::atomic<size_t> m_nbRevalidations;
+    std::atomic<size_t> m_nbBytesSaved;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_HTTPCACHE_H
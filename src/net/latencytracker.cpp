@@ -0,0 +1,112 @@
+#include "latencytracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::LatencyTracker
+ * \brief Keep track of latest observed
+ * latencies in order to compute percentiles
+ * \details
+ * Only the latest samples are kept (older ones
+ * are overwritten), so that percentiles follow
+ * current behaviour of remotes.
+ *
+ * \note
+ * This class is \em thread-safe
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+LatencyTracker::LatencyTracker(size_t nbSamplesMax)
+{
+    m_nbSamplesMax = std::max<size_t>(1, nbSamplesMax);
+    m_idxNext = 0;
+    m_sortedIsValid = false;
+
+    m_listSamples.reserve(m_nbSamplesMax);
+}
+
+void LatencyTracker::addSample(double latency)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    if(m_listSamples.size() < m_nbSamplesMax){
+        m_listSamples.push_back(latency);
+    }else{
+        m_listSamples[m_idxNext] = latency;
+    }
+
+    m_idxNext = (m_idxNext + 1) % m_nbSamplesMax;
+    m_sortedIsValid = false;
+}
+
+size_t LatencyTracker::getNbSamples() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_listSamples.size();
+}
+
+/*!
+ * \brief Use to compute percentile of registered samples
+ * \details
+ * Sorted samples are cached until a new sample is
+ * registered, so calling this method often is cheap.
+ *
+ * \param[in] percentile
+ * Percentile to compute, in range <tt>[0, 100]</tt>.
+ *
+ * \return
+ * Returns associated latency (using nearest-rank method). \n
+ * Returns \c 0 if no samples are available.
+ */
+double LatencyTracker::getPercentile(double percentile) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    if(m_listSamples.empty()){
+        return 0.0;
+    }
+
+    if(!m_sortedIsValid){
+        m_listSorted = m_listSamples;
+        std::sort(m_listSorted.begin(), m_listSorted.end());
+        m_sortedIsValid = true;
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * m_listSorted.size()));
+
+    return m_listSorted[std::max<size_t>(rank, 1) - 1];
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,36 @@
+#ifndef TEASE_NET_LATENCYTRACKER_H
+#define TEASE_NET_LATENCYTRACKER_H
+
+#include "transferease/transferease_global.h"
+
+#include <mutex>
+#include <vector>
+
+namespace tease
+{
+
+class LatencyTracker final
+{
+    TEASE_DISABLE_COPY_MOVE(LatencyTracker)
+
+public:
+    explicit LatencyTracker(size_t nbSamplesMax);
+
+public:
+    void addSample(double latency);
+    size_t getNbSamples() const;
+    double getPercentile(double percentile) const;
+
+private:
+    std::vector<double> m_listSamples;
+    size_t m_nbSamplesMax;
+    size_t m_idxNext;
+
+    mutable std::vector<double> m_listSorted;
+    mutable bool m_sortedIsValid;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_LATENCYTRACKER_H
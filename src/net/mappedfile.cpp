@@ -0,0 +1,319 @@
+#include "transferease/net/mappedfile.h"
+
+#include <cerrno>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "transferease/logs/abstractlogger.h"
+
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::MappedFile
+ * \brief Give read-only access to a file
+ * mapped in memory
+ * \details
+ * File content is accessed without being copied: pages are
+ * loaded by the operating system when they are read. \n
+ * This class is used to deliver content cached on disk
+ * (see TransferManager::setContentCache()), use
+ * toBytesArray() if a copy is needed.
+ *
+ * \note
+ * Mapping stay valid until close() is called, even if
+ * file is removed in the meantime (except on Windows, where
+ * mapped files can't be removed).
+ *
+ * \sa Request::getMappedData()
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions definitions     */
+/*      Private Class        */
+/*****************************/
+
+class MappedFile::Impl final
+{
+public:
+    Impl() = default;
+    ~Impl();
+
+public:
+    bool open(const std::string &pathFile, size_t offset);
+    void close();
+
+private:
+    void setView(const BytesArray::Byte *base, size_t sizeMapped, size_t offset);
+
+public:
+    const BytesArray::Byte *m_base = nullptr;
+    size_t m_sizeMapped = 0;
+
+    const BytesArray::Byte *m_data = nullptr;
+    size_t m_size = 0;
+    bool m_isOpen = false;
+
+#if defined(_WIN32)
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+/*****************************/
+/* Functions implementation  */
+/*      Private Class        */
+/*****************************/
+
+MappedFile::Impl::~Impl()
+{
+    close();
+}
+
+void MappedFile::Impl::setView(const BytesArray::Byte *base, size_t sizeMapped, size_t offset)
+{
+    m_base = base;
+    m_sizeMapped = sizeMapped;
+
+    m_size = sizeMapped - offset;
+    m_data = (m_size > 0) ? base + offset : nullptr;
+    m_isOpen = true;
+}
+
+#if defined(_WIN32)
+bool MappedFile::Impl::open(const std::string &pathFile, size_t offset)
+{
+    /* Open file */
+    HANDLE file = CreateFileA(pathFile.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE){
+        const std::string err = StringHelper::format("Failed to open file to map [path: %s, id-err: %lu]", pathFile.c_str(), GetLastError());
+        TEASE_LOG_ERROR(err);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < offset){
+        CloseHandle(file);
+        return false;
+    }
+
+    /* Empty files can't be mapped */
+    if(size.QuadPart == 0){
+        CloseHandle(file);
+
+        m_isOpen = true;
+        return true;
+    }
+
+    /* Map file (mapping keep its own reference to the file) */
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if(!m_mapping){
+        const std::string err = StringHelper::format("Failed to map file [path: %s, id-err: %lu]", pathFile.c_str(), GetLastError());
+        TEASE_LOG_ERROR(err);
+        return false;
+    }
+
+    const void *addr = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!addr){
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+
+    setView(static_cast<const BytesArray::Byte*>(addr), static_cast<size_t>(size.QuadPart), offset);
+    return true;
+}
+
+void MappedFile::Impl::close()
+{
+    if(m_base){
+        UnmapViewOfFile(m_base);
+    }
+
+    if(m_mapping){
+        CloseHandle(m_mapping);
+    }
+
+    m_base = nullptr;
+    m_sizeMapped = 0;
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+}
+#else
+bool MappedFile::Impl::open(const std::string &pathFile, size_t offset)
+{
+    /* Open file */
+    const int fd = ::open(pathFile.c_str(), O_RDONLY);
+    if(fd < 0){
+        const std::string err = StringHelper::format("Failed to open file to map [path: %s, id-err: %d]", pathFile.c_str(), errno);
+        TEASE_LOG_ERROR(err);
+        return false;
+    }
+
+    struct stat infos;
+    if(fstat(fd, &infos) != 0 || static_cast<size_t>(infos.st_size) < offset){
+        ::close(fd);
+        return false;
+    }
+
+    /* Empty files can't be mapped */
+    if(infos.st_size == 0){
+        ::close(fd);
+
+        m_isOpen = true;
+        return true;
+    }
+
+    /* Map file (mapping keep its own reference to the file) */
+    void *addr = mmap(nullptr, static_cast<size_t>(infos.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(addr == MAP_FAILED){
+        const std::string err = StringHelper::format("Failed to map file [path: %s, id-err: %d]", pathFile.c_str(), errno);
+        TEASE_LOG_ERROR(err);
+        return false;
+    }
+
+    setView(static_cast<const BytesArray::Byte*>(addr), static_cast<size_t>(infos.st_size), offset);
+    return true;
+}
+
+void MappedFile::Impl::close()
+{
+    if(m_base){
+        munmap(const_cast<BytesArray::Byte*>(m_base), m_sizeMapped);
+    }
+
+    m_base = nullptr;
+    m_sizeMapped = 0;
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+}
+#endif
+
+/*****************************/
+/* Functions implementation  */
+/*      Public Class         */
+/*****************************/
+
+MappedFile::MappedFile() :
+    d_ptr(std::make_unique<Impl>())
+{
+
+}
+
+MappedFile::~MappedFile() = default;
+
+/*!
+ * \brief Use to map a file
+ * \details
+ * Any previously mapped file is closed.
+ *
+ * \param[in] pathFile
+ * Path of the file to map.
+ * \param[in] offset
+ * Position of the first byte to give access to,
+ * previous bytes are ignored. \n
+ * Must not be greater than file size.
+ *
+ * \return
+ * Returns \c true if succeed.
+ */
+bool MappedFile::open(const std::string &pathFile, size_t offset)
+{
+    d_ptr->close();
+    return d_ptr->open(pathFile, offset);
+}
+
+/*!
+ * \brief Use to unmap the file
+ * \details
+ * Pointers retrieved with dataConst() are
+ * invalid once closed.
+ */
+void MappedFile::close()
+{
+    d_ptr->close();
+}
+
+bool MappedFile::isOpen() const
+{
+    return d_ptr->m_isOpen;
+}
+
+bool MappedFile::isEmpty() const
+{
+    return d_ptr->m_size == 0;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return d_ptr->m_size;
+}
+
+/*!
+ * \brief Retrieve mapped content
+ *
+ * \return
+ * Returns pointer to mapped content, \c nullptr
+ * if no file is mapped or if file is empty.
+ */
+const BytesArray::Byte* MappedFile::dataConst() const
+{
+    return d_ptr->m_data;
+}
+
+/*!
+ * \brief Use to copy mapped content
+ *
+ * \return
+ * Returns copy of mapped content.
+ */
+BytesArray MappedFile::toBytesArray() const
+{
+    BytesArray data;
+    if(d_ptr->m_data){
+        data.pushBack(d_ptr->m_data, d_ptr->m_size);
+    }
+
+    return data;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
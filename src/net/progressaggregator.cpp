@@ -0,0 +1,165 @@
+#include "progressaggregator.h"
+
+#include <algorithm>
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::ProgressAggregator
+ * \brief Aggregate progress of all requests of a job
+ * \details
+ * Each size update of a request is applied as a delta to
+ * job totals, so that job progress is available in constant
+ * time whatever the number of requests. \n
+ * Requests which total size is not known yet (\c 0) are
+ * estimated with the biggest known total size.
+ *
+ * \note
+ * Totals are read lock-free from any thread. Since each total
+ * is updated independently, a read may mix values of two
+ * successive updates: number of bytes transferred is bounded
+ * to the total size.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+ProgressAggregator::ProgressAggregator()
+{
+    m_sizeKnownTotal = 0;
+    m_sizeKnownCurrent = 0;
+    m_sizeRef = 0;
+    m_nbUnknowns = 0;
+}
+
+/*!
+ * \brief Reset totals with current sizes
+ * of job requests
+ *
+ * \param[in] listReqs
+ * Requests of the job.
+ *
+ * \warning
+ * Must not be called while requests are updated.
+ */
+void ProgressAggregator::reset(const Request::List &listReqs)
+{
+    size_t sizeTotal = 0, sizeCurrent = 0, sizeRef = 0, nbUnknowns = 0;
+    for(const auto &req : listReqs){
+        if(req->ioGetSizeTotal() == 0){
+            ++nbUnknowns;
+            continue;
+        }
+
+        sizeTotal += req->ioGetSizeTotal();
+        sizeCurrent += req->ioGetSizeCurrent();
+        sizeRef = std::max(sizeRef, req->ioGetSizeTotal());
+    }
+
+    m_sizeKnownTotal = sizeTotal;
+    m_sizeKnownCurrent = sizeCurrent;
+    m_sizeRef = sizeRef;
+    m_nbUnknowns = nbUnknowns;
+}
+
+/*!
+ * \brief Use to set sizes of a request and
+ * update totals accordingly
+ *
+ * \param[in, out] req
+ * Request to update, it must belong to the job.
+ * \param[in] sizeTotal
+ * Total size of the request in bytes, \c 0 if unknown.
+ * \param[in] sizeCurrent
+ * Number of bytes transferred.
+ *
+ * \warning
+ * A request must not be updated concurrently.
+ */
+void ProgressAggregator::update(Request &req, size_t sizeTotal, size_t sizeCurrent)
+{
+    const size_t prevTotal = req.ioGetSizeTotal();
+    const size_t prevCurrent = req.ioGetSizeCurrent();
+    if(prevTotal == sizeTotal && prevCurrent == sizeCurrent){
+        return;
+    }
+
+    req.ioSetSizeTotal(sizeTotal);
+    req.ioSetSizeCurrent(sizeCurrent);
+
+    /* Apply deltas (unsigned arithmetic is modular, so decreasing sizes are properly managed) */
+    const bool prevKnown = (prevTotal != 0);
+    const bool known = (sizeTotal != 0);
+
+    if(prevKnown && !known){
+        m_nbUnknowns.fetch_add(1, std::memory_order_relaxed);
+    }else if(!prevKnown && known){
+        m_nbUnknowns.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    size_t sizeRef = m_sizeRef.load(std::memory_order_relaxed);
+    while(sizeTotal > sizeRef){
+        if(m_sizeRef.compare_exchange_weak(sizeRef, sizeTotal, std::memory_order_relaxed)){
+            break;
+        }
+    }
+
+    m_sizeKnownTotal.fetch_add((known ? sizeTotal : 0) - (prevKnown ? prevTotal : 0), std::memory_order_relaxed);
+    m_sizeKnownCurrent.fetch_add((known ? sizeCurrent : 0) - (prevKnown ? prevCurrent : 0), std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Use to remove transferred bytes of
+ * a request from totals
+ * \details
+ * Must be called before I/O informations of a
+ * request are reset (new trial, failover, etc...). \n
+ * Total size of the request falls back to its
+ * expected size (see Request::ioGetSizeExpected()).
+ *
+ * \param[in, out] req
+ * Request to use.
+ */
+void ProgressAggregator::remove(Request &req)
+{
+    update(req, req.ioGetSizeExpected(), 0);
+}
+
+TransferManager::Progress ProgressAggregator::getProgress() const
+{
+    TransferManager::Progress progress{};
+
+    progress.sizeCurrent = m_sizeKnownCurrent.load(std::memory_order_relaxed);
+    progress.sizeTotal = m_sizeKnownTotal.load(std::memory_order_relaxed) + m_nbUnknowns.load(std::memory_order_relaxed) * m_sizeRef.load(std::memory_order_relaxed);
+    progress.sizeCurrent = std::min(progress.sizeCurrent, progress.sizeTotal);
+
+    return progress;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,35 @@
+#ifndef TEASE_NET_PROGRESSAGGREGATOR_H
+#define TEASE_NET_PROGRESSAGGREGATOR_H
+
+#include "transferease/transfermanager.h"
+
+#include <atomic>
+
+namespace tease
+{
+
+class ProgressAggregator final
+{
+    TEASE_DISABLE_COPY_MOVE(ProgressAggregator)
+
+public:
+    ProgressAggregator();
+
+public:
+    void reset(const Request::List &listReqs);
+
+    void update(Request &req, size_t sizeTotal, size_t sizeCurrent);
+    void remove(Request &req);
+
+    TransferManager::Progress getProgress() const;
+
+private:
+    std::atomic<size_t> m_sizeKnownTotal;
+    std::atomic<size_t> m_sizeKnownCurrent;
+    std::atomic<size_t> m_sizeRef;
+    std::atomic<size_t> m_nbUnknowns;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_PROGRESSAGGREGATOR_H
@@ -1,5 +1,6 @@
 #include "transferease/net/request.h"
 
+#include <atomic>
 #include <cstring>
 
 /*****************************/
@@ -18,6 +19,33 @@
  * \sa configureDownload(), configureUpload()
  */
 
+/*****************************/
+/* Callbacks documentations  */
+/*****************************/
+
+/*!
+ * \typedef Request::DataSink
+ * \brief Callback receiving downloaded datas
+ * as soon as they are received
+ *
+ * \param[in] offset
+ * Position of datas in the ressource. \n
+ * A new trial of the request starts again at \c 0,
+ * previously received datas must then be discarded.
+ * \param[in] data
+ * Received datas.
+ * \param[in] size
+ * Number of received bytes.
+ *
+ * \return
+ * Returns \c true if datas have been consumed. \n
+ * Returns \c false if sink can't accept datas yet: transfer
+ * is paused and same datas will be given again once request
+ * is resumed (see TransferManager::resume()).
+ *
+ * \sa setDataSink()
+ */
+
 /*****************************/
 /* Macro definitions         */
 /*****************************/
@@ -36,6 +64,9 @@ namespace tease
 
 class Request::Impl final
 {
+public:
+    Impl();
+
 public:
     void configureTransfer(TypeTransfer idType, const Url &url);
 
@@ -45,18 +76,34 @@ public:
 
     void clear();
 
+    static Id createId();
+
 public:
+    const Id m_id;
     TypeTransfer m_idType;
 
     Url m_url;
+    std::vector<Url> m_listMirrors;
+    TimePoint m_deadline;
+    std::string m_digest;
+    std::time_t m_mtime;
+    DataSink m_sink;
 
     BytesArray m_data;
+    MappedFile m_dataMapped;
     size_t m_dataNbRead;
 
-    size_t m_ioTotal;
-    size_t m_ioCurrent;
+    std::atomic<size_t> m_ioTotal; /* Sizes can be read by any thread to monitor progress */
+    std::atomic<size_t> m_ioCurrent;
+    size_t m_ioWire;
+    size_t m_ioExpected;
+    std::string m_ioDigest;
+    bool m_ioSkipped;
     int m_ioNbTrials;
-    bool m_ioAbort;
+    size_t m_ioIdMirror;
+    int m_ioNbFailovers;
+    std::atomic<bool> m_ioAbort; /* Can be set by any thread to cancel the transfer */
+    std::atomic<bool> m_ioPaused;
 };
 
 /*****************************/
@@ -64,6 +111,23 @@ public:
 /*      Private Class        */
 /*****************************/
 
+Request::Impl::Impl() :
+    m_id(createId())
+{
+}
+
+/*!
+ * \brief Use to create a new request identifier
+ *
+ * \return
+ * Returns identifier unique for the process lifetime.
+ */
+Request::Id Request::Impl::createId()
+{
+    static std::atomic<Id> nextId(1);
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Request::Impl::configureTransfer(TypeTransfer idType, const Url &url)
 {
     /* Reset any IO interactions */
@@ -72,6 +136,8 @@ void Request::Impl::configureTransfer(TypeTransfer idType, const Url &url)
     /* Set common properties */
     m_idType = idType;
     m_url = url;
+    m_dataMapped.close();
+    m_ioPaused = false;
 }
 
 size_t Request::Impl::ioReadFromBytesArray(char *buffer, size_t nbBytes)
@@ -89,11 +155,21 @@ void Request::Impl::ioReset(bool resetNbTrials)
 {
     m_dataNbRead = 0;
 
-    m_ioTotal = 0;
+    /* Expected size is kept between trials of the same transfer */
+    if(resetNbTrials){
+        m_ioExpected = 0;
+    }
+
+    m_ioTotal = m_ioExpected;
     m_ioCurrent = 0;
+    m_ioWire = 0;
+    m_ioDigest.clear();
+    m_ioSkipped = false;
 
     if(resetNbTrials){
         m_ioNbTrials = 0;
+        m_ioIdMirror = 0;
+        m_ioNbFailovers = 0;
         m_ioAbort = false;
     }
 }
@@ -103,9 +179,16 @@ void Request::Impl::clear()
     m_idType = TRANSFER_UNK;
 
     m_url.clear();
+    m_listMirrors.clear();
+    m_deadline = TimePoint::max();
+    m_digest.clear();
+    m_mtime = 0;
+    m_sink = nullptr;
     m_data.clear();
+    m_dataMapped.close();
 
     ioReset();
+    m_ioPaused = false;
 }
 
 /*****************************/
@@ -179,6 +262,152 @@ void Request::configureUpload(const Url &dstUrl, BytesArray &&inputData)
     d_ptr->m_data = std::move(inputData);
 }
 
+/*!
+ * \brief Use to set an absolute deadline
+ * for the request
+ * \details
+ * Transfer manager will start requests with the
+ * shortest deadline first. If request has not been
+ * completed before its deadline (or if current transfer
+ * speed shows that it can't be completed in time), the
+ * transfer will fail with error \c TransferManager::ERR_DEADLINE_EXCEEDED. \n
+ * Since the steady clock is used, a wall-clock deadline
+ * can be converted with:
+ * \code{.cpp}
+ * const auto delay = deadlineWallClock - std::chrono::system_clock::now();
+ * request->setDeadline(Request::Clock::now() + delay);
+ * \endcode
+ *
+ * \param[in] deadline
+ * Deadline to use. \n
+ * To disable it, use value <tt>Request::TimePoint::max()</tt>,
+ * which is the default value.
+ *
+ * \sa getDeadline(), hasDeadline()
+ * \sa TransferManager::setTimeoutBatch()
+ */
+void Request::setDeadline(const TimePoint &deadline)
+{
+    d_ptr->m_deadline = deadline;
+}
+
+/*!
+ * \brief Use to set alternative URLs of the ressource
+ * \details
+ * Mirrors are used when transfer fail on current URL: request
+ * will be transferred again with next mirror (in the order of
+ * the list, URL set at configuration being the first one). \n
+ * With option \c TransferManager::OPT_MIRROR_BY_THROUGHPUT,
+ * first used URL will be the one with the best measured throughput.
+ *
+ * \param[in] listMirrors
+ * List of mirrors to use, pass an empty list to disable
+ * mirrors (default behaviour).
+ *
+ * \warning
+ * This method must be called \b after \c configureDownload()
+ * or \c configureUpload().
+ *
+ * \sa getMirrors(), ioGetUrl()
+ */
+void Request::setMirrors(const std::vector<Url> &listMirrors)
+{
+    d_ptr->m_listMirrors = listMirrors;
+    d_ptr->m_ioIdMirror = 0;
+}
+
+/*!
+ * \brief Use to set expected digest of transferred
+ * ressource
+ * \details
+ * Digest of transferred datas is computed during the transfer, and
+ * the request fails with error \c TransferManager::ERR_INTEGRITY if it
+ * doesn't match (after the configured number of trials). \n
+ * When a content cache is used (see TransferManager::setContentCache()),
+ * contents are addressed by their digest instead of their URL: ressources
+ * downloaded from different URLs but having the same digest share the
+ * same cache entry. \n
+ * For uploads, this is the digest of local datas: it is also
+ * compared to remote \c ETag by incremental uploads (see
+ * TransferManager::OPT_SKIP_UNCHANGED).
+ *
+ * \param[in] digest
+ * Digest to use, prefixed by its algorithm (for example:
+ * <tt>sha256:9f86d0...</tt>, see TransferManager::TypeDigest for supported
+ * algorithms), case is insensitive. \n
+ * Use an empty string to disable it (default behaviour).
+ *
+ * \sa getExpectedDigest(), ioGetDigest()
+ */
+void Request::setExpectedDigest(const std::string &digest)
+{
+    d_ptr->m_digest = digest;
+}
+
+/*!
+ * \brief Use to set modification time of uploaded
+ * datas
+ * \details
+ * Used by incremental uploads (see TransferManager::OPT_SKIP_UNCHANGED):
+ * remote ressource having the same size and a modification time not
+ * older than this one is considered up to date.
+ *
+ * \param[in] time
+ * Modification time of local datas (usually the one of
+ * the file from which datas were read). \n
+ * Use \c 0 if unknown (default behaviour).
+ *
+ * \sa getModificationTime()
+ */
+void Request::setModificationTime(std::time_t time)
+{
+    d_ptr->m_mtime = time;
+}
+
+/*!
+ * \brief Use to give downloaded datas to a sink
+ * instead of storing them
+ * \details
+ * Datas are given to the sink as soon as they are received,
+ * getData() stays empty: memory usage doesn't depend on the
+ * ressource size. \n
+ * When sink can't keep up, it can refuse datas: transfer is then
+ * paused without buffering anything more, until request is resumed
+ * with TransferManager::resume(). \n
+ * Since received datas are not kept, downloads using a sink are
+ * never served by caches, coalesced nor hedged.
+ *
+ * \param[in] sink
+ * Sink to use, it is called from a transfer thread. \n
+ * Use \c nullptr to store datas into getData() (default behaviour).
+ *
+ * \note
+ * With TransferManager::transferNow(), transfer can't be paused:
+ * refusing datas fails the transfer.
+ *
+ * \sa getDataSink(), hasDataSink()
+ */
+void Request::setDataSink(const DataSink &sink)
+{
+    d_ptr->m_sink = sink;
+}
+
+/*!
+ * \brief Retrieve identifier of the request
+ * \details
+ * Identifier is assigned at creation and never change, even
+ * if request is configured again.
+ *
+ * \return
+ * Returns identifier unique for the process lifetime.
+ *
+ * \sa TransferManager::cancel()
+ */
+Request::Id Request::getId() const
+{
+    return d_ptr->m_id;
+}
+
 Request::TypeTransfer Request::getTypeTransfer() const
 {
     return d_ptr->m_idType;
@@ -189,6 +418,46 @@ const Url& Request::getUrl() const
     return d_ptr->m_url;
 }
 
+const std::vector<Url>& Request::getMirrors() const
+{
+    return d_ptr->m_listMirrors;
+}
+
+bool Request::hasMirrors() const
+{
+    return !d_ptr->m_listMirrors.empty();
+}
+
+const Request::TimePoint& Request::getDeadline() const
+{
+    return d_ptr->m_deadline;
+}
+
+bool Request::hasDeadline() const
+{
+    return d_ptr->m_deadline != TimePoint::max();
+}
+
+const std::string& Request::getExpectedDigest() const
+{
+    return d_ptr->m_digest;
+}
+
+std::time_t Request::getModificationTime() const
+{
+    return d_ptr->m_mtime;
+}
+
+const Request::DataSink& Request::getDataSink() const
+{
+    return d_ptr->m_sink;
+}
+
+bool Request::hasDataSink() const
+{
+    return static_cast<bool>(d_ptr->m_sink);
+}
+
 BytesArray& Request::getData()
 {
     return d_ptr->m_data;
@@ -199,6 +468,28 @@ const BytesArray& Request::getData() const
     return d_ptr->m_data;
 }
 
+/*!
+ * \brief Retrieve mapped datas of the request
+ * \details
+ * When content cache deliver its entries without copy
+ * (see TransferManager::CACHE_DELIVERY_MAP), downloads served
+ * from the cache are mapped here instead of being copied into
+ * getData(). \n
+ * Use MappedFile::isOpen() to know which one must be used.
+ *
+ * \return
+ * Returns mapped datas.
+ */
+MappedFile& Request::getMappedData()
+{
+    return d_ptr->m_dataMapped;
+}
+
+const MappedFile& Request::getMappedData() const
+{
+    return d_ptr->m_dataMapped;
+}
+
 size_t Request::ioRead(char *buffer, size_t nbBytes)
 {
     return d_ptr->ioReadFromBytesArray(buffer, nbBytes);
@@ -214,15 +505,157 @@ void Request::ioSetSizeCurrent(size_t size)
     d_ptr->m_ioCurrent = size;
 }
 
+/*!
+ * \brief Use to set number of bytes really
+ * transferred over the network
+ * \details
+ * Will differ from ioGetSizeCurrent() when
+ * transfer is compressed.
+ *
+ * \param[in] size
+ * Number of bytes.
+ *
+ * \sa ioGetSizeWire()
+ */
+void Request::ioSetSizeWire(size_t size)
+{
+    d_ptr->m_ioWire = size;
+}
+
+/*!
+ * \brief Use to set size of the ressource
+ * retrieved before transfer
+ * \details
+ * Expected size is kept between trials, total size is
+ * set to expected size until real size is known.
+ *
+ * \param[in] size
+ * Expected size in bytes, \c 0 if unknown.
+ *
+ * \sa ioGetSizeExpected()
+ */
+void Request::ioSetSizeExpected(size_t size)
+{
+    d_ptr->m_ioExpected = size;
+}
+
+/*!
+ * \brief Use to set digest computed on
+ * transferred datas
+ *
+ * \param[in] digest
+ * Digest prefixed by its algorithm.
+ *
+ * \sa ioGetDigest()
+ */
+void Request::ioSetDigest(const std::string &digest)
+{
+    d_ptr->m_ioDigest = digest;
+}
+
+/*!
+ * \brief Use to mark an upload as skipped, remote
+ * ressource being already up to date
+ *
+ * \param[in] skipped
+ * Set to \c true if upload is skipped.
+ *
+ * \sa ioIsSkipped()
+ */
+void Request::ioSetSkipped(bool skipped)
+{
+    d_ptr->m_ioSkipped = skipped;
+}
+
 void Request::ioRegisterTry()
 {
     d_ptr->ioReset(false);
     ++d_ptr->m_ioNbTrials;
 }
 
+/*!
+ * \brief Use to select URL to use for next transfer
+ *
+ * \param[in] idMirror
+ * Index of URL to use: \c 0 for URL set at configuration,
+ * \c i for the mirror <tt>i - 1</tt>. \n
+ * Out of range values are ignored.
+ *
+ * \sa ioGetUrl(), ioFailover()
+ */
+void Request::ioSelectMirror(size_t idMirror)
+{
+    if(idMirror > d_ptr->m_listMirrors.size()){
+        return;
+    }
+
+    d_ptr->m_ioIdMirror = idMirror;
+}
+
+/*!
+ * \brief Use to switch to next URL of the request
+ * \details
+ * I/O informations are reset, number of trials
+ * is kept unchanged.
+ *
+ * \return
+ * Returns \c true if URL has been switched, \c false
+ * if request doesn't have mirrors.
+ *
+ * \sa ioSelectMirror(), ioGetNbFailovers()
+ */
+bool Request::ioFailover()
+{
+    if(d_ptr->m_listMirrors.empty()){
+        return false;
+    }
+
+    d_ptr->ioReset(false);
+    d_ptr->m_ioIdMirror = (d_ptr->m_ioIdMirror + 1) % (d_ptr->m_listMirrors.size() + 1);
+    ++d_ptr->m_ioNbFailovers;
+
+    return true;
+}
+
+/*!
+ * \brief Use to cancel transfer of the request
+ * \details
+ * This method can be called from any thread. Transfer
+ * is stopped at next transfer event, request is then
+ * completed with error \c TransferManager::ERR_USER_ABORT. \n
+ * Flag is kept until request is reset or configured again.
+ *
+ * \note
+ * To remove a request of a running batch right away,
+ * prefer TransferManager::cancel().
+ *
+ * \sa ioIsAbort()
+ */
 void Request::ioAbort()
 {
-    d_ptr->m_ioAbort = true;
+    d_ptr->m_ioAbort.store(true, std::memory_order_release);
+}
+
+/*!
+ * \brief Use to pause or resume transfer of the request
+ * \details
+ * This method can be called from any thread, flag is kept
+ * until request is configured again. \n
+ * Request flagged before its transfer is started stays queued
+ * until resumed.
+ *
+ * \param[in] paused
+ * Set to \c true to pause the transfer.
+ *
+ * \note
+ * Flag of a running transfer is applied when TransferManager::pause()
+ * or TransferManager::resume() is called, prefer to use those.
+ *
+ * \sa ioIsPaused()
+ */
+void Request::ioSetPaused(bool paused)
+{
+    d_ptr->m_ioPaused.store(paused, std::memory_order_release);
 }
 
 void Request::ioReset()
@@ -240,14 +673,120 @@ size_t Request::ioGetSizeCurrent() const
     return d_ptr->m_ioCurrent;
 }
 
+/*!
+ * \brief Retrieve number of bytes transferred
+ * over the network
+ * \details
+ * Value is set once transfer succeed. For compressed
+ * transfers (see TransferManager::OPT_HTTP_COMPRESSION and
+ * TransferManager::setUploadEncoding()), this is the
+ * compressed size, which allows to compute compression
+ * ratio with size of datas.
+ *
+ * \return
+ * Returns number of bytes, \c 0 if transfer has not
+ * succeed yet.
+ *
+ * \sa ioSetSizeWire()
+ */
+size_t Request::ioGetSizeWire() const
+{
+    return d_ptr->m_ioWire;
+}
+
+/*!
+ * \brief Retrieve digest computed on transferred datas
+ * \details
+ * Digest is computed while datas are transferred, when
+ * an expected digest is set (see setExpectedDigest()) or
+ * when TransferManager::setDigestAlgorithm() is used.
+ *
+ * \return
+ * Returns digest prefixed by its algorithm (for example:
+ * <tt>crc32c:e3069283</tt>), empty string if no digest
+ * was computed or if transfer has not succeed yet.
+ */
+const std::string& Request::ioGetDigest() const
+{
+    return d_ptr->m_ioDigest;
+}
+
+/*!
+ * \brief Retrieve size of the ressource retrieved
+ * before transfer
+ * \details
+ * With option TransferManager::OPT_PREFETCH_SIZES, sizes
+ * of downloaded ressources are known before transfers
+ * start.
+ *
+ * \return
+ * Returns expected size in bytes, \c 0 if unknown.
+ *
+ * \sa ioSetSizeExpected()
+ */
+size_t Request::ioGetSizeExpected() const
+{
+    return d_ptr->m_ioExpected;
+}
+
+/*!
+ * \brief Use to know if upload has been skipped
+ * \details
+ * With option TransferManager::OPT_SKIP_UNCHANGED, uploads
+ * which remote ressource is already up to date are not
+ * transferred.
+ *
+ * \return
+ * Returns \c true if upload has been skipped.
+ *
+ * \sa ioSetSkipped()
+ */
+bool Request::ioIsSkipped() const
+{
+    return d_ptr->m_ioSkipped;
+}
+
 int Request::ioGetNbTrials() const
 {
     return d_ptr->m_ioNbTrials;
 }
 
+/*!
+ * \brief Retrieve URL to use for the transfer
+ *
+ * \return
+ * Returns URL set at configuration or currently
+ * selected mirror.
+ *
+ * \sa setMirrors(), ioSelectMirror()
+ */
+const Url& Request::ioGetUrl() const
+{
+    if(d_ptr->m_ioIdMirror == 0){
+        return d_ptr->m_url;
+    }
+
+    return d_ptr->m_listMirrors[d_ptr->m_ioIdMirror - 1];
+}
+
+size_t Request::ioGetIdMirror() const
+{
+    return d_ptr->m_ioIdMirror;
+}
+
+int Request::ioGetNbFailovers() const
+{
+    return d_ptr->m_ioNbFailovers;
+}
+
 bool Request::ioIsAbort() const
 {
-    return d_ptr->m_ioAbort;
+    return d_ptr->m_ioAbort.load(std::memory_order_acquire);
+}
+
+bool Request::ioIsPaused() const
+{
+    return d_ptr->m_ioPaused.load(std::memory_order_acquire);
 }
 
 /*****************************/
@@ -0,0 +1,128 @@
+#include "requestscheduler.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::RequestScheduler
+ * \brief Order requests of a job before
+ * starting them
+ * \details
+ * Order only depends on requests properties
+ * (deadline, URL, size) and on the scheduling
+ * policy, see TransferManager::TypeScheduling.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+/*!
+ * \brief Use to order requests before starting them
+ * \details
+ * Requests with shortest deadline are started first. Others
+ * are grouped by host and directory (connections already
+ * located in a directory can be reused without any directory
+ * change), then ordered according to scheduling policy.
+ *
+ * \param[in, out] listReqs
+ * List of requests to order.
+ * \param[in] policy
+ * Scheduling policy to use.
+ *
+ * \sa TransferManager::setSchedulingPolicy()
+ */
+void RequestScheduler::schedule(Request::List &listReqs, TransferManager::TypeScheduling policy)
+{
+    std::stable_sort(listReqs.begin(), listReqs.end(), [](const Request::PtrShared &left, const Request::PtrShared &right){
+        if(left->getDeadline() != right->getDeadline()){
+            return left->getDeadline() < right->getDeadline();
+        }
+
+        const Url &urlLeft = left->getUrl();
+        const Url &urlRight = right->getUrl();
+        if(urlLeft.getHost() != urlRight.getHost()){
+            return urlLeft.getHost() < urlRight.getHost();
+        }
+
+        const std::string &pathLeft = urlLeft.getPath();
+        const std::string &pathRight = urlRight.getPath();
+        return pathLeft.compare(0, pathLeft.rfind('/') + 1, pathRight, 0, pathRight.rfind('/') + 1) < 0;
+    });
+
+    switch(policy)
+    {
+        case TransferManager::SCHEDULING_SHORTEST_FIRST:
+        case TransferManager::SCHEDULING_LARGEST_FIRST:{
+            // Unknown sizes (0) are started last, whatever the order
+            const bool ascending = (policy == TransferManager::SCHEDULING_SHORTEST_FIRST);
+            auto getSize = [](const Request &req){
+                return (req.getTypeTransfer() == Request::TRANSFER_UPLOAD) ? req.getData().getSize() : req.ioGetSizeExpected();
+            };
+
+            std::stable_sort(listReqs.begin(), listReqs.end(), [ascending, &getSize](const Request::PtrShared &left, const Request::PtrShared &right){
+                if(left->getDeadline() != right->getDeadline()){
+                    return left->getDeadline() < right->getDeadline();
+                }
+
+                const size_t sizeLeft = getSize(*left);
+                const size_t sizeRight = getSize(*right);
+                if(sizeLeft == 0 || sizeRight == 0){
+                    return sizeRight == 0 && sizeLeft != 0;
+                }
+
+                return ascending ? sizeLeft < sizeRight : sizeLeft > sizeRight;
+            });
+        }break;
+
+        case TransferManager::SCHEDULING_ROUND_ROBIN_HOSTS:{
+            // Rank of each request among requests of its host, requests of same rank are started together
+            std::unordered_map<std::string, size_t> mapHostRanks;
+            std::unordered_map<const Request*, size_t> mapRanks;
+            mapRanks.reserve(listReqs.size());
+
+            for(const auto &req : listReqs){
+                mapRanks[req.get()] = mapHostRanks[req->getUrl().getHost()]++;
+            }
+
+            std::stable_sort(listReqs.begin(), listReqs.end(), [&mapRanks](const Request::PtrShared &left, const Request::PtrShared &right){
+                if(left->getDeadline() != right->getDeadline()){
+                    return left->getDeadline() < right->getDeadline();
+                }
+
+                return mapRanks.at(left.get()) < mapRanks.at(right.get());
+            });
+        }break;
+
+        default: break;
+    }
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,17 @@
+#ifndef TEASE_NET_REQUESTSCHEDULER_H
+#define TEASE_NET_REQUESTSCHEDULER_H
+
+#include "transferease/transfermanager.h"
+
+namespace tease
+{
+
+class RequestScheduler final
+{
+public:
+    static void schedule(Request::List &listReqs, TransferManager::TypeScheduling policy);
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_REQUESTSCHEDULER_H
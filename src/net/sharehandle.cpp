@@ -0,0 +1,105 @@
+#include "sharehandle.h"
+
+#include "transferease/logs/abstractlogger.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::ShareHandle
+ * \brief Cache shared between all transfers of
+ * a transfer manager
+ * \details
+ * DNS cache, connections and SSL sessions are shared,
+ * so that any worker can reuse a connection opened by
+ * another one (or by a previous batch), without paying
+ * again DNS lookup and TCP/TLS handshakes.
+ *
+ * \note
+ * This class is \em thread-safe, curl will lock
+ * each shared data when needed.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+ShareHandle::ShareHandle()
+{
+    m_handle = curl_share_init();
+    if(!m_handle){
+        TEASE_LOG_ERROR("Failed to initialize share handle, transfers will not share their caches");
+        return;
+    }
+
+    curl_share_setopt(m_handle, CURLSHOPT_LOCKFUNC, curlCbLock);
+    curl_share_setopt(m_handle, CURLSHOPT_UNLOCKFUNC, curlCbUnlock);
+    curl_share_setopt(m_handle, CURLSHOPT_USERDATA, this);
+
+    curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+/*!
+ * \warning
+ * All easy handles using the share handle must have
+ * been cleaned before.
+ */
+ShareHandle::~ShareHandle()
+{
+    if(m_handle){
+        curl_share_cleanup(m_handle);
+    }
+}
+
+/*!
+ * \brief Retrieve curl share handle
+ *
+ * \return
+ * Returns share handle to set on easy handles with
+ * \c CURLOPT_SHARE. \n
+ * Can be \c nullptr if failed to initialize it.
+ */
+CURLSH* ShareHandle::get() const
+{
+    return m_handle;
+}
+
+void ShareHandle::curlCbLock(TEASE_VAR_UNUSED CURL *handle, curl_lock_data data, TEASE_VAR_UNUSED curl_lock_access access, void *userptr)
+{
+    ShareHandle *share = static_cast<ShareHandle*>(userptr);
+    share->m_listMutexes[data].lock();
+}
+
+void ShareHandle::curlCbUnlock(TEASE_VAR_UNUSED CURL *handle, curl_lock_data data, void *userptr)
+{
+    ShareHandle *share = static_cast<ShareHandle*>(userptr);
+    share->m_listMutexes[data].unlock();
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
@@ -0,0 +1,35 @@
+#ifndef TEASE_NET_SHAREHANDLE_H
+#define TEASE_NET_SHAREHANDLE_H
+
+#include "transferease/transferease_global.h"
+
+#include <array>
+#include <curl/curl.h>
+#include <mutex>
+
+namespace tease
+{
+
+class ShareHandle final
+{
+    TEASE_DISABLE_COPY_MOVE(ShareHandle)
+
+public:
+    ShareHandle();
+    ~ShareHandle();
+
+public:
+    CURLSH* get() const;
+
+private:
+    static void curlCbLock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+    static void curlCbUnlock(CURL *handle, curl_lock_data data, void *userptr);
+
+private:
+    CURLSH *m_handle;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> m_listMutexes;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_SHAREHANDLE_H
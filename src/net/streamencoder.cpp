@@ -0,0 +1,366 @@
+#include "streamencoder.h"
+
+#if defined(TEASE_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(TEASE_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+#include "transferease/logs/abstractlogger.h"
+
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::StreamEncoder
+ * \brief Compress request datas on the fly
+ * \details
+ * Encoder is used as a stage between request datas and
+ * curl read callback: raw datas are read from a source
+ * by chunks, and only compressed datas are given to curl,
+ * so that no compressed copy of the whole datas is needed. \n
+ * Available encoders depend on libraries found at build time,
+ * see isSupported().
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define SIZE_CHUNK_IN       65536   /**< Unit in bytes */
+
+#define GZIP_WINDOW_BITS    (15 + 16)   /**< Maximum window size, with gzip header */
+#define GZIP_MEM_LEVEL      8
+#define ZSTD_LEVEL          3
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Private classes           */
+/*****************************/
+
+#if defined(TEASE_HAS_ZLIB)
+class GzipEncoder final : public StreamEncoder
+{
+public:
+    GzipEncoder();
+    ~GzipEncoder() override;
+
+public:
+    bool init();
+    size_t read(char *buffer, size_t size, const Source &source) override;
+
+private:
+    z_stream m_stream;
+    bool m_isInit;
+};
+
+GzipEncoder::GzipEncoder() :
+    m_stream{}, m_isInit(false)
+{
+
+}
+
+GzipEncoder::~GzipEncoder()
+{
+    if(m_isInit){
+        deflateEnd(&m_stream);
+    }
+}
+
+bool GzipEncoder::init()
+{
+    const int idErr = deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, GZIP_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+    m_isInit = (idErr == Z_OK);
+
+    return m_isInit;
+}
+
+size_t GzipEncoder::read(char *buffer, size_t size, const Source &source)
+{
+    while(!m_finished){
+        // Retrieve next raw chunk
+        if(m_stream.avail_in == 0 && !m_inputEnd){
+            m_stream.next_in = reinterpret_cast<Bytef*>(m_bufferIn.data());
+            m_stream.avail_in = static_cast<uInt>(readInput(source));
+        }
+
+        // Compress it
+        m_stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        m_stream.avail_out = static_cast<uInt>(size);
+
+        const int idErr = deflate(&m_stream, m_inputEnd ? Z_FINISH : Z_NO_FLUSH);
+        if(idErr == Z_STREAM_ERROR){
+            const std::string err = StringHelper::format("Failed to compress datas with gzip [id-err: %d]", idErr);
+            TEASE_LOG_ERROR(err);
+            return READ_ERROR;
+        }
+
+        m_finished = (idErr == Z_STREAM_END);
+
+        const size_t nbProduced = size - m_stream.avail_out;
+        if(nbProduced > 0){
+            m_sizeOut += nbProduced;
+            return nbProduced;
+        }
+    }
+
+    return 0;
+}
+#endif
+
+#if defined(TEASE_HAS_ZSTD)
+class ZstdEncoder final : public StreamEncoder
+{
+public:
+    ZstdEncoder();
+    ~ZstdEncoder() override;
+
+public:
+    bool init();
+    size_t read(char *buffer, size_t size, const Source &source) override;
+
+private:
+    ZSTD_CCtx *m_ctx;
+    ZSTD_inBuffer m_input;
+};
+
+ZstdEncoder::ZstdEncoder() :
+    m_ctx(nullptr), m_input{nullptr, 0, 0}
+{
+
+}
+
+ZstdEncoder::~ZstdEncoder()
+{
+    ZSTD_freeCCtx(m_ctx);
+}
+
+bool ZstdEncoder::init()
+{
+    m_ctx = ZSTD_createCCtx();
+    if(!m_ctx){
+        return false;
+    }
+
+    return !ZSTD_isError(ZSTD_CCtx_setParameter(m_ctx, ZSTD_c_compressionLevel, ZSTD_LEVEL));
+}
+
+size_t ZstdEncoder::read(char *buffer, size_t size, const Source &source)
+{
+    while(!m_finished){
+        // Retrieve next raw chunk
+        if(m_input.pos == m_input.size && !m_inputEnd){
+            m_input.src = m_bufferIn.data();
+            m_input.size = readInput(source);
+            m_input.pos = 0;
+        }
+
+        // Compress it
+        ZSTD_outBuffer output{buffer, size, 0};
+
+        const size_t remaining = ZSTD_compressStream2(m_ctx, &output, &m_input, m_inputEnd ? ZSTD_e_end : ZSTD_e_continue);
+        if(ZSTD_isError(remaining)){
+            const std::string err = StringHelper::format("Failed to compress datas with zstd [err: %s]", ZSTD_getErrorName(remaining));
+            TEASE_LOG_ERROR(err);
+            return READ_ERROR;
+        }
+
+        m_finished = (m_inputEnd && remaining == 0);
+
+        if(output.pos > 0){
+            m_sizeOut += output.pos;
+            return output.pos;
+        }
+    }
+
+    return 0;
+}
+#endif
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+StreamEncoder::StreamEncoder() :
+    m_bufferIn(SIZE_CHUNK_IN), m_inputEnd(false), m_finished(false),
+    m_sizeIn(0), m_sizeOut(0)
+{
+
+}
+
+StreamEncoder::~StreamEncoder() = default;
+
+/*!
+ * \fn size_t StreamEncoder::read(char *buffer, size_t size, const Source &source)
+ * \brief Use to retrieve next compressed datas
+ *
+ * \param[out] buffer
+ * Buffer to fill with compressed datas.
+ * \param[in] size
+ * Size of the buffer.
+ * \param[in] source
+ * Function used to read raw datas, returning \c 0
+ * once all datas have been read.
+ *
+ * \return
+ * Returns number of bytes written into \c buffer, \c 0 once
+ * all datas have been compressed. \n
+ * Returns \c StreamEncoder::READ_ERROR if compression failed.
+ */
+
+/*!
+ * \brief Retrieve number of raw bytes consumed
+ *
+ * \return
+ * Returns number of bytes.
+ */
+size_t StreamEncoder::getSizeIn() const
+{
+    return m_sizeIn;
+}
+
+/*!
+ * \brief Retrieve number of compressed bytes produced
+ *
+ * \return
+ * Returns number of bytes.
+ */
+size_t StreamEncoder::getSizeOut() const
+{
+    return m_sizeOut;
+}
+
+/*!
+ * \brief Use to create an encoder
+ *
+ * \param[in] idEncoding
+ * Encoding to use.
+ *
+ * \return
+ * Returns created encoder, \c nullptr if encoding is not
+ * supported or if encoder failed to be initialized.
+ */
+StreamEncoder::PtrUnique StreamEncoder::create(TransferManager::TypeEncoding idEncoding)
+{
+    switch(idEncoding)
+    {
+#if defined(TEASE_HAS_ZLIB)
+        case TransferManager::ENCODING_GZIP:{
+            auto encoder = std::make_unique<GzipEncoder>();
+            if(encoder->init()){
+                return encoder;
+            }
+        }break;
+#endif
+
+#if defined(TEASE_HAS_ZSTD)
+        case TransferManager::ENCODING_ZSTD:{
+            auto encoder = std::make_unique<ZstdEncoder>();
+            if(encoder->init()){
+                return encoder;
+            }
+        }break;
+#endif
+
+        default: break;
+    }
+
+    const std::string err = StringHelper::format("Unable to create encoder [id-encoding: %d]", idEncoding);
+    TEASE_LOG_ERROR(err);
+
+    return nullptr;
+}
+
+/*!
+ * \brief Verify if an encoding is available
+ *
+ * \param[in] idEncoding
+ * Encoding to verify.
+ *
+ * \return
+ * Returns \c true if supported.
+ */
+bool StreamEncoder::isSupported(TransferManager::TypeEncoding idEncoding)
+{
+    switch(idEncoding)
+    {
+        case TransferManager::ENCODING_NONE:    return true;
+
+#if defined(TEASE_HAS_ZLIB)
+        case TransferManager::ENCODING_GZIP:    return true;
+#endif
+
+#if defined(TEASE_HAS_ZSTD)
+        case TransferManager::ENCODING_ZSTD:    return true;
+#endif
+
+        default: break;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Retrieve name of an encoding
+ *
+ * \param[in] idEncoding
+ * Encoding to use.
+ *
+ * \return
+ * Returns name to use in \c Content-Encoding header.
+ */
+const char* StreamEncoder::getName(TransferManager::TypeEncoding idEncoding)
+{
+    switch(idEncoding)
+    {
+        case TransferManager::ENCODING_GZIP:    return "gzip";
+        case TransferManager::ENCODING_ZSTD:    return "zstd";
+
+        default: break;
+    }
+
+    return "identity";
+}
+
+/*!
+ * \brief Use to read next raw chunk from source
+ *
+ * \param[in] source
+ * Source of raw datas.
+ *
+ * \return
+ * Returns number of bytes read into input buffer. \n
+ * Once source datas are exhausted, \c m_inputEnd is set.
+ */
+size_t StreamEncoder::readInput(const Source &source)
+{
+    const size_t nbRead = source(m_bufferIn.data(), m_bufferIn.size());
+    m_sizeIn += nbRead;
+    m_inputEnd = (nbRead == 0);
+
+    return nbRead;
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
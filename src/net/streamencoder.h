@@ -0,0 +1,53 @@
+#ifndef TEASE_NET_STREAMENCODER_H
+#define TEASE_NET_STREAMENCODER_H
+
+#include "transferease/transfermanager.h"
+
+#include <functional>
+#include <limits>
+
+namespace tease
+{
+
+class StreamEncoder
+{
+    TEASE_DISABLE_COPY_MOVE(StreamEncoder)
+
+public:
+    using PtrUnique = std::unique_ptr<StreamEncoder>;
+    using Source = std::function<size_t(char *buffer, size_t size)>;
+
+public:
+    static constexpr size_t READ_ERROR = std::numeric_limits<size_t>::max(); /**< Value returned by read() when encoding failed */
+
+public:
+    virtual ~StreamEncoder();
+
+public:
+    virtual size_t read(char *buffer, size_t size, const Source &source) = 0;
+
+    size_t getSizeIn() const;
+    size_t getSizeOut() const;
+
+public:
+    static PtrUnique create(TransferManager::TypeEncoding idEncoding);
+    static bool isSupported(TransferManager::TypeEncoding idEncoding);
+    static const char* getName(TransferManager::TypeEncoding idEncoding);
+
+protected:
+    StreamEncoder();
+
+    size_t readInput(const Source &source);
+
+protected:
+    std::vector<char> m_bufferIn;
+    bool m_inputEnd;
+    bool m_finished;
+
+    size_t m_sizeIn;
+    size_t m_sizeOut;
+};
+
+} // namespace tease
+
+#endif // TEASE_NET_STREAMENCODER_H
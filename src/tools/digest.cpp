@@ -0,0 +1,647 @@
+#include "digest.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TEASE_DIGEST_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define TEASE_DIGEST_ARM_CRC
+#include <arm_acle.h>
+#endif
+
+#if defined(TEASE_DIGEST_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TEASE_TARGET(features)  __attribute__((target(features)))
+#else
+#define TEASE_TARGET(features)
+#endif
+
+#include "tools/stringhelper.h"
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class tease::Digest
+ * \brief Compute digest of datas incrementally
+ * \details
+ * Datas can be given by chunks (as received from network), so
+ * that digest is computed while datas are transferred, without
+ * reading them again once transfer is completed. \n
+ * Hardware acceleration is used when available (detected at runtime):
+ * - CRC32C: SSE4.2 on x86, CRC extension on ARMv8
+ * - SHA-256: SHA extensions on x86
+ *
+ * Otherwise, portable implementations are used.
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define SHA256_SIZE_BLOCK   64
+#define CRC32C_POLY         0x82F63B78u /**< Reversed Castagnoli polynomial */
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+namespace tease
+{
+
+/*****************************/
+/* Internal functions        */
+/*****************************/
+
+namespace
+{
+
+/* CPU features detection */
+struct CpuFeatures
+{
+    bool sse42 = false;
+    bool sha = false;
+};
+
+const CpuFeatures& getCpuFeatures()
+{
+    static const CpuFeatures features = []{
+        CpuFeatures res;
+
+#if defined(TEASE_DIGEST_X86)
+        unsigned int regs1[4] = {0}, regs7[4] = {0};
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int idMax = info[0];
+        __cpuidex(info, 1, 0);
+        std::memcpy(regs1, info, sizeof(regs1));
+        if(idMax >= 7){
+            __cpuidex(info, 7, 0);
+            std::memcpy(regs7, info, sizeof(regs7));
+        }
+#else
+        __get_cpuid(1, &regs1[0], &regs1[1], &regs1[2], &regs1[3]);
+        __get_cpuid_count(7, 0, &regs7[0], &regs7[1], &regs7[2], &regs7[3]);
+#endif
+        const bool ssse3 = regs1[2] & (1u << 9);
+        const bool sse41 = regs1[2] & (1u << 19);
+
+        res.sse42 = regs1[2] & (1u << 20);
+        res.sha = ssse3 && sse41 && (regs7[1] & (1u << 29));
+#endif
+
+        return res;
+    }();
+
+    return features;
+}
+
+std::string toHex(const uint8_t *data, size_t size)
+{
+    static constexpr char digits[] = "0123456789abcdef";
+
+    std::string hex(size * 2, '0');
+    for(size_t i = 0; i < size; ++i){
+        hex[2 * i] = digits[data[i] >> 4];
+        hex[2 * i + 1] = digits[data[i] & 0x0F];
+    }
+
+    return hex;
+}
+
+/* CRC32C implementations */
+using Crc32cTables = std::array<std::array<uint32_t, 256>, 8>;
+
+const Crc32cTables& getCrc32cTables()
+{
+    static const Crc32cTables tables = []{
+        Crc32cTables res{};
+        for(uint32_t i = 0; i < 256; ++i){
+            uint32_t crc = i;
+            for(int j = 0; j < 8; ++j){
+                crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1u)));
+            }
+            res[0][i] = crc;
+        }
+
+        for(uint32_t i = 0; i < 256; ++i){
+            for(size_t k = 1; k < res.size(); ++k){
+                res[k][i] = (res[k - 1][i] >> 8) ^ res[0][res[k - 1][i] & 0xFF];
+            }
+        }
+
+        return res;
+    }();
+
+    return tables;
+}
+
+uint32_t crc32cPortable(uint32_t crc, const uint8_t *data, size_t size)
+{
+    const Crc32cTables &t = getCrc32cTables();
+
+    /* Slicing-by-8: process 8 bytes per iteration */
+    while(size >= 8){
+        uint32_t low, high;
+        std::memcpy(&low, data, sizeof(low));
+        std::memcpy(&high, data + 4, sizeof(high));
+        low ^= crc; // Little-endian is assumed by this path, see below
+
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+            ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+
+        data += 8;
+        size -= 8;
+    }
+
+    while(size-- > 0){
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return crc;
+}
+
+uint32_t crc32cBytewise(uint32_t crc, const uint8_t *data, size_t size)
+{
+    const Crc32cTables &t = getCrc32cTables();
+    while(size-- > 0){
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return crc;
+}
+
+#if defined(TEASE_DIGEST_X86)
+TEASE_TARGET("sse4.2")
+uint32_t crc32cSse42(uint32_t crc, const uint8_t *data, size_t size)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    while(size >= 8){
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+
+        data += 8;
+        size -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+
+    while(size-- > 0){
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+
+    return crc;
+}
+#endif
+
+#if defined(TEASE_DIGEST_ARM_CRC)
+uint32_t crc32cArm(uint32_t crc, const uint8_t *data, size_t size)
+{
+    while(size >= 8){
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc = __crc32cd(crc, value);
+
+        data += 8;
+        size -= 8;
+    }
+
+    while(size-- > 0){
+        crc = __crc32cb(crc, *data++);
+    }
+
+    return crc;
+}
+#endif
+
+using FctCrc32c = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+FctCrc32c selectCrc32c()
+{
+#if defined(TEASE_DIGEST_X86)
+    if(getCpuFeatures().sse42){
+        return crc32cSse42;
+    }
+#endif
+
+#if defined(TEASE_DIGEST_ARM_CRC)
+    return crc32cArm;
+#endif
+
+    const uint16_t probe = 1;
+    const bool isLittleEndian = *reinterpret_cast<const uint8_t*>(&probe) == 1;
+
+    return isLittleEndian ? crc32cPortable : crc32cBytewise;
+}
+
+/* SHA-256 implementations */
+alignas(16) constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotr(uint32_t value, int nbBits)
+{
+    return (value >> nbBits) | (value << (32 - nbBits));
+}
+
+void sha256Portable(uint32_t state[8], const uint8_t *data, size_t nbBlocks)
+{
+    uint32_t w[64];
+
+    for(; nbBlocks > 0; --nbBlocks, data += SHA256_SIZE_BLOCK){
+        for(int i = 0; i < 16; ++i){
+            w[i] = (uint32_t(data[4 * i]) << 24) | (uint32_t(data[4 * i + 1]) << 16) | (uint32_t(data[4 * i + 2]) << 8) | uint32_t(data[4 * i + 3]);
+        }
+
+        for(int i = 16; i < 64; ++i){
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for(int i = 0; i < 64; ++i){
+            const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const uint32_t ch = (e & f) ^ (~e & g);
+            const uint32_t tmp1 = h + s1 + ch + SHA256_K[i] + w[i];
+            const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t tmp2 = s0 + maj;
+
+            h = g; g = f; f = e; e = d + tmp1;
+            d = c; c = b; b = a; a = tmp1 + tmp2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+#if defined(TEASE_DIGEST_X86)
+TEASE_TARGET("sha,sse4.1,ssse3")
+void sha256ShaNi(uint32_t state[8], const uint8_t *data, size_t nbBlocks)
+{
+    const __m128i maskSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    /* Load state, instructions expect ABEF/CDGH layout */
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for(; nbBlocks > 0; --nbBlocks, data += SHA256_SIZE_BLOCK){
+        const __m128i saveAbef = state0;
+        const __m128i saveCdgh = state1;
+
+        __m128i msgs[4];
+        for(int i = 0; i < 16; ++i){
+            // Load message, then schedule next ones while rounds are performed (4 rounds per iteration)
+            if(i < 4){
+                msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), maskSwap);
+            }
+
+            __m128i msg = _mm_add_epi32(msgs[i % 4], _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[4 * i])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+            if(i >= 3 && i <= 14){
+                __m128i &next = msgs[(i + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msgs[i % 4], msgs[(i + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, msgs[i % 4]);
+            }
+
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+            if(i >= 1 && i <= 12){
+                msgs[(i + 3) % 4] = _mm_sha256msg1_epu32(msgs[(i + 3) % 4], msgs[i % 4]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, saveAbef);
+        state1 = _mm_add_epi32(state1, saveCdgh);
+    }
+
+    /* Store state back to ABCD/EFGH layout */
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+#endif
+
+using FctSha256 = void (*)(uint32_t[8], const uint8_t*, size_t);
+
+FctSha256 selectSha256()
+{
+#if defined(TEASE_DIGEST_X86)
+    if(getCpuFeatures().sha){
+        return sha256ShaNi;
+    }
+#endif
+
+    return sha256Portable;
+}
+
+/*****************************/
+/* Private classes           */
+/*****************************/
+
+class DigestCrc32c final : public Digest
+{
+public:
+    DigestCrc32c() : Digest(TransferManager::DIGEST_CRC32C)
+    {
+        reset();
+    }
+
+public:
+    void reset() override
+    {
+        m_crc = 0xFFFFFFFFu;
+    }
+
+    void update(const void *data, size_t size) override
+    {
+        static const FctCrc32c fct = selectCrc32c();
+        m_crc = fct(m_crc, static_cast<const uint8_t*>(data), size);
+    }
+
+protected:
+    std::string computeValue() override
+    {
+        return StringHelper::format("%08x", ~m_crc);
+    }
+
+private:
+    uint32_t m_crc;
+};
+
+class DigestSha256 final : public Digest
+{
+public:
+    DigestSha256() : Digest(TransferManager::DIGEST_SHA256)
+    {
+        reset();
+    }
+
+public:
+    void reset() override
+    {
+        static constexpr uint32_t init[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+
+        std::memcpy(m_state, init, sizeof(m_state));
+        m_sizeBuffer = 0;
+        m_sizeTotal = 0;
+    }
+
+    void update(const void *data, size_t size) override
+    {
+        static const FctSha256 fct = selectSha256();
+
+        const uint8_t *bytes = static_cast<const uint8_t*>(data);
+        m_sizeTotal += size;
+
+        /* Complete pending block */
+        if(m_sizeBuffer > 0){
+            const size_t nbCopy = std::min(size, SHA256_SIZE_BLOCK - m_sizeBuffer);
+            std::memcpy(m_buffer + m_sizeBuffer, bytes, nbCopy);
+            m_sizeBuffer += nbCopy;
+            bytes += nbCopy;
+            size -= nbCopy;
+
+            if(m_sizeBuffer < SHA256_SIZE_BLOCK){
+                return;
+            }
+
+            fct(m_state, m_buffer, 1);
+            m_sizeBuffer = 0;
+        }
+
+        /* Process full blocks directly from input */
+        const size_t nbBlocks = size / SHA256_SIZE_BLOCK;
+        if(nbBlocks > 0){
+            fct(m_state, bytes, nbBlocks);
+            bytes += nbBlocks * SHA256_SIZE_BLOCK;
+            size -= nbBlocks * SHA256_SIZE_BLOCK;
+        }
+
+        /* Keep remaining bytes */
+        std::memcpy(m_buffer, bytes, size);
+        m_sizeBuffer = size;
+    }
+
+protected:
+    std::string computeValue() override
+    {
+        static const FctSha256 fct = selectSha256();
+
+        /* Apply padding: bit 1, zeros, then message length in bits (big-endian) */
+        const uint64_t nbBits = static_cast<uint64_t>(m_sizeTotal) * 8;
+
+        m_buffer[m_sizeBuffer++] = 0x80;
+        if(m_sizeBuffer > SHA256_SIZE_BLOCK - 8){
+            std::memset(m_buffer + m_sizeBuffer, 0, SHA256_SIZE_BLOCK - m_sizeBuffer);
+            fct(m_state, m_buffer, 1);
+            m_sizeBuffer = 0;
+        }
+
+        std::memset(m_buffer + m_sizeBuffer, 0, SHA256_SIZE_BLOCK - 8 - m_sizeBuffer);
+        for(int i = 0; i < 8; ++i){
+            m_buffer[SHA256_SIZE_BLOCK - 1 - i] = static_cast<uint8_t>(nbBits >> (8 * i));
+        }
+        fct(m_state, m_buffer, 1);
+
+        /* Output state as big-endian */
+        uint8_t hash[32];
+        for(int i = 0; i < 8; ++i){
+            hash[4 * i] = static_cast<uint8_t>(m_state[i] >> 24);
+            hash[4 * i + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+            hash[4 * i + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+            hash[4 * i + 3] = static_cast<uint8_t>(m_state[i]);
+        }
+
+        return toHex(hash, sizeof(hash));
+    }
+
+private:
+    uint32_t m_state[8];
+    uint8_t m_buffer[SHA256_SIZE_BLOCK];
+    size_t m_sizeBuffer;
+    size_t m_sizeTotal;
+};
+
+} // namespace
+
+/*****************************/
+/* Functions implementation  */
+/*****************************/
+
+Digest::Digest(TransferManager::TypeDigest idDigest) :
+    m_idDigest(idDigest)
+{
+
+}
+
+Digest::~Digest() = default;
+
+/*!
+ * \fn void Digest::reset()
+ * \brief Use to restart digest computation
+ */
+
+/*!
+ * \fn void Digest::update(const void *data, size_t size)
+ * \brief Use to add datas to the digest
+ *
+ * \param[in] data
+ * Datas to add.
+ * \param[in] size
+ * Number of bytes to add.
+ */
+
+/*!
+ * \brief Use to retrieve digest of all added datas
+ * \details
+ * Digest must be reset before being used again.
+ *
+ * \return
+ * Returns digest prefixed by its algorithm, for
+ * example: <tt>crc32c:e3069283</tt>.
+ *
+ * \sa parse()
+ */
+std::string Digest::finalize()
+{
+    return std::string(getName(m_idDigest)) + ':' + computeValue();
+}
+
+TransferManager::TypeDigest Digest::getType() const
+{
+    return m_idDigest;
+}
+
+/*!
+ * \brief Use to create a digest
+ *
+ * \param[in] idDigest
+ * Algorithm to use.
+ *
+ * \return
+ * Returns created digest, \c nullptr if algorithm
+ * is \c TransferManager::DIGEST_NONE or unknown.
+ */
+Digest::PtrUnique Digest::create(TransferManager::TypeDigest idDigest)
+{
+    switch(idDigest)
+    {
+        case TransferManager::DIGEST_SHA256:    return std::make_unique<DigestSha256>();
+        case TransferManager::DIGEST_CRC32C:    return std::make_unique<DigestCrc32c>();
+
+        default: break;
+    }
+
+    return nullptr;
+}
+
+/*!
+ * \brief Use to parse a digest
+ *
+ * \param[in] digest
+ * Digest to parse, format is <tt>algorithm:value</tt>
+ * (case insensitive).
+ * \param[out] idDigest
+ * Algorithm of the digest.
+ * \param[out] value
+ * Value of the digest, in lowercase hexadecimal.
+ *
+ * \return
+ * Returns \c true if digest is valid.
+ */
+bool Digest::parse(const std::string &digest, TransferManager::TypeDigest &idDigest, std::string &value)
+{
+    const std::string digestLower = StringHelper::toLower(digest);
+
+    const size_t posSep = digestLower.find(':');
+    if(posSep == std::string::npos){
+        return false;
+    }
+
+    /* Parse algorithm */
+    const std::string name = digestLower.substr(0, posSep);
+    size_t nbHexExpected = 0;
+
+    if(name == getName(TransferManager::DIGEST_SHA256)){
+        idDigest = TransferManager::DIGEST_SHA256;
+        nbHexExpected = 64;
+
+    }else if(name == getName(TransferManager::DIGEST_CRC32C)){
+        idDigest = TransferManager::DIGEST_CRC32C;
+        nbHexExpected = 8;
+
+    }else{
+        return false;
+    }
+
+    /* Parse value */
+    value = digestLower.substr(posSep + 1);
+    if(value.size() != nbHexExpected){
+        return false;
+    }
+
+    return value.find_first_not_of("0123456789abcdef") == std::string::npos;
+}
+
+const char* Digest::getName(TransferManager::TypeDigest idDigest)
+{
+    switch(idDigest)
+    {
+        case TransferManager::DIGEST_SHA256:    return "sha256";
+        case TransferManager::DIGEST_CRC32C:    return "crc32c";
+
+        default: break;
+    }
+
+    return "none";
+}
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
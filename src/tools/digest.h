@@ -0,0 +1,55 @@
+#ifndef TEASE_TOOLS_DIGEST_H
+#define TEASE_TOOLS_DIGEST_H
+
+#include "transferease/transfermanager.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+namespace tease{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+class Digest
+{
+    TEASE_DISABLE_COPY_MOVE(Digest)
+
+public:
+    using PtrUnique = std::unique_ptr<Digest>;
+
+public:
+    virtual ~Digest();
+
+public:
+    virtual void reset() = 0;
+    virtual void update(const void *data, size_t size) = 0;
+    std::string finalize();
+
+    TransferManager::TypeDigest getType() const;
+
+public:
+    static PtrUnique create(TransferManager::TypeDigest idDigest);
+    static bool parse(const std::string &digest, TransferManager::TypeDigest &idDigest, std::string &value);
+    static const char* getName(TransferManager::TypeDigest idDigest);
+
+protected:
+    explicit Digest(TransferManager::TypeDigest idDigest);
+
+    virtual std::string computeValue() = 0;
+
+private:
+    TransferManager::TypeDigest m_idDigest;
+};
+
+/*****************************/
+/* End namespaces            */
+/*****************************/
+
+} // namespace tease
+
+/*****************************/
+/* End file                  */
+/*****************************/
+
+#endif // TEASE_TOOLS_DIGEST_H
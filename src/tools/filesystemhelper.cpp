@@ -1,6 +1,11 @@
 #include "filesystemhelper.h"
 
+#include <chrono>
+#include <fstream>
+#include <thread>
+
 #include "transferease/logs/abstractlogger.h"
+#include "transferease/net/bytesarray.h"
 
 #include "stringhelper.h"
 
@@ -28,3 +33,84 @@ bool tease::FileSystemHelper::createDirectories(const std::filesystem::path &pat
 
     return true;
 }
+
+/*!
+ * \brief Use to write a file atomically
+ * \details
+ * Datas are written to a temporary file (with an unique
+ * name) located in the same directory, then renamed, so
+ * that readers (from any thread or process) never observe
+ * a partially written file.
+ *
+ * \param[in] pathFile
+ * Path of the file to write, replaced if already exist.
+ * \param[in] data
+ * Datas to write.
+ *
+ * \return
+ * Returns \c true if succeed.
+ */
+bool tease::FileSystemHelper::writeFileAtomic(const std::filesystem::path &pathFile, const BytesArray &data)
+{
+    return writeFileAtomic(pathFile, BytesArray(), data);
+}
+
+/*!
+ * \brief Use to write a file atomically, made of
+ * a header followed by datas
+ * \details
+ * Avoid to concatenate header and datas in memory.
+ *
+ * \param[in] pathFile
+ * Path of the file to write, replaced if already exist.
+ * \param[in] header
+ * Datas to write first.
+ * \param[in] data
+ * Datas to write after header.
+ *
+ * \return
+ * Returns \c true if succeed.
+ *
+ * \sa writeFileAtomic(const std::filesystem::path&, const BytesArray&)
+ */
+bool tease::FileSystemHelper::writeFileAtomic(const std::filesystem::path &pathFile, const BytesArray &header, const BytesArray &data)
+{
+    const auto nonce = std::chrono::steady_clock::now().time_since_epoch().count() ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const std::filesystem::path pathTmp = pathFile.string() + ".tmp" + std::to_string(nonce);
+
+    std::error_code errId;
+
+    /* Write temporary file */
+    {
+        std::ofstream outFile(pathTmp, std::ios::out | std::ios::trunc | std::ios::binary);
+        if(!outFile){
+            const std::string err = StringHelper::format("Failed to create file [path: %s]", pathTmp.string().c_str());
+            TEASE_LOG_ERROR(err);
+            return false;
+        }
+
+        outFile.write(reinterpret_cast<const char*>(header.dataConst()), header.getSize());
+        outFile.write(reinterpret_cast<const char*>(data.dataConst()), data.getSize());
+        outFile.close();
+
+        if(!outFile){
+            const std::string err = StringHelper::format("Failed to write to file [path: %s]", pathTmp.string().c_str());
+            TEASE_LOG_ERROR(err);
+
+            std::filesystem::remove(pathTmp, errId);
+            return false;
+        }
+    }
+
+    /* Replace file */
+    std::filesystem::rename(pathTmp, pathFile, errId);
+    if(errId){
+        const std::string err = StringHelper::format("Unable to replace file [path: %s, error: %s]", pathFile.string().c_str(), errId.message().c_str());
+        TEASE_LOG_ERROR(err);
+
+        std::filesystem::remove(pathTmp, errId);
+        return false;
+    }
+
+    return true;
+}
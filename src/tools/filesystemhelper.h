@@ -8,6 +8,8 @@
 /*****************************/
 namespace tease{
 
+class BytesArray;
+
 /*****************************/
 /* Class definitions         */
 /*****************************/
@@ -17,6 +19,8 @@ class FileSystemHelper
 public:
     static std::filesystem::path getFilePathDir(const std::string &filepath);
     static bool createDirectories(const std::filesystem::path &pathDirectories);
+    static bool writeFileAtomic(const std::filesystem::path &pathFile, const BytesArray &data);
+    static bool writeFileAtomic(const std::filesystem::path &pathFile, const BytesArray &header, const BytesArray &data);
 };
 
 /*****************************/
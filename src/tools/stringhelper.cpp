@@ -124,6 +124,30 @@ int StringHelper::toInt(const std::string &str, int base, bool *succeed)
     return tmpInt;
 }
 
+/*!
+ * \brief Use to remove leading and trailing
+ * whitespaces of a string
+ *
+ * \param[in] str
+ * String to trim. \n
+ * Removed characters are: spaces, tabulations, carriage
+ * returns and line feeds.
+ *
+ * \return
+ * Return trimmed string copy
+ */
+std::string StringHelper::trim(const std::string &str)
+{
+    static constexpr const char *whitespaces = " \t\r\n";
+
+    const size_t posStart = str.find_first_not_of(whitespaces);
+    if(posStart == std::string::npos){
+        return std::string();
+    }
+
+    const size_t posEnd = str.find_last_not_of(whitespaces);
+    return str.substr(posStart, posEnd - posStart + 1);
+}
 
 /*!
  * \brief Use to split a string into multiple substrings
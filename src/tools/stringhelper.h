@@ -18,6 +18,7 @@ class StringHelper
 public:
     static std::string toLower(const std::string &str);
     static std::string toUpper(const std::string &str);
+    static std::string trim(const std::string &str);
 
     static int toInt(const std::string &str, int base = 10, bool *succeed = nullptr);
 
@@ -1,12 +1,34 @@
 #include "transferease/transfermanager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <curl/curl.h>
+#include <deque>
 #include <future>
+#include <limits>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "transferease/logs/abstractlogger.h"
 
+#include "net/callbackdispatcher.h"
+#include "net/concurrencycontroller.h"
+#include "net/contentstore.h"
+#include "net/directorycache.h"
+#include "net/dnscache.h"
+#include "net/ftphelper.h"
 #include "net/handle.h"
+#include "net/handletemplates.h"
+#include "net/httpcache.h"
+#include "net/latencytracker.h"
+#include "net/progressaggregator.h"
+#include "net/requestscheduler.h"
+#include "net/sharehandle.h"
+#include "net/streamencoder.h"
+#include "tools/digest.h"
 #include "tools/stringhelper.h"
 
 /*****************************/
@@ -38,7 +60,7 @@
  * - https://everything.curl.dev/
  * - https://curl.se/libcurl/c/
  *
- * \sa startDownload()
+ * \sa startDownload(), submit()
  * \sa tease::Url
  */
 
@@ -72,6 +94,25 @@
  * \sa startDownload()
  */
 
+/*!
+ * \typedef TransferManager::CbProgressInfos
+ * \brief Callback called during transfer with
+ * detailed progress
+ * \details
+ * Called right after TransferManager::CbProgress,
+ * with same rate-limiting.
+ *
+ * \param[in] typeTransfer
+ * Type of transfer being performed.
+ * \param[in] progress
+ * Progress of the transfer: sizes, smoothed throughput,
+ * estimated remaining time and number of requests
+ * in each state.
+ *
+ * \sa setCbProgressInfos()
+ * \sa setProgressInterval()
+ */
+
 /*!
  * \typedef TransferManager::CbCompleted
  * \brief Callback called when transfer finished
@@ -96,14 +137,41 @@
  * \sa startDownload()
  */
 
+/*!
+ * \typedef TransferManager::CbDone
+ * \brief Continuation called once a submitted
+ * transfer is finished
+ *
+ * \param[in] result
+ * Result of the transfer.
+ *
+ * \sa submit(const Request::List&, CbDone)
+ */
+
 /*****************************/
 /* Macro definitions         */
 /*****************************/
 #define DEFAULT_NB_MAX_TRIALS       1
 #define DEFAULT_TIMEOUT_CONNECT     10L /**< Unit in seconds */
 #define DEFAULT_TIMEOUT_TRANSFER    10L /**< Unit in seconds */
+#define DEFAULT_TIMEOUT_BATCH       0L  /**< Unit in seconds, disabled */
+#define DEFAULT_NB_MAX_HOST         0   /**< No limit */
+#define DEFAULT_NB_WORKERS          1
+#define DEFAULT_HEDGING_PERCENTILE  95.0
 
 #define MIN_SPEED_LIMIT             30L /**< Unit in bytes/sec */
+#define MIN_DEADLINE_ESTIMATE       1.0 /**< Unit in seconds, minimum transfer duration before estimating if deadline can be met */
+
+#define PROGRESS_SAMPLE_PERIOD      0.1 /**< Unit in seconds, minimum duration between two throughput samples */
+#define PROGRESS_EWMA_PERIOD        2.0 /**< Unit in seconds, time constant of smoothed throughput */
+
+#define HEDGING_NB_SAMPLES_MIN      10      /**< Minimum number of latencies samples before hedging requests */
+#define HEDGING_NB_SAMPLES_MAX      1000    /**< Number of latest latencies samples used to compute percentiles */
+#define HEDGING_POLL_MIN            5       /**< Unit in milliseconds, minimum polling period used to detect slow requests */
+
+#define POLL_TIMEOUT                1000    /**< Unit in milliseconds */
+
+#define HTTP_CODE_NOT_MODIFIED      304
 
 /*****************************/
 /* Start namespace           */
@@ -124,6 +192,94 @@ public:
     using Thread = std::future<void>;
     using Locker = std::lock_guard<std::mutex>;
 
+public:
+    struct Settings
+    {
+        FlagOption options = FlagOption::OPT_NONE;
+        int nbMaxTrials = 0;
+        TypeEncoding uploadEncoding = ENCODING_NONE;
+        TypeDigest digestAlgorithm = DIGEST_NONE;
+        TypeCacheDelivery cacheDelivery = CACHE_DELIVERY_COPY;
+        TypeFtpMethod ftpMethod = FTP_METHOD_MULTICWD;
+
+        std::string username;               /* Configuration of handle templates */
+        std::string userpwd;
+        long timeoutConnect = 0;
+        long timeoutTransfer = 0;
+        long timeoutDnsCache = 0;
+        int generationTemplates = 0;        /* Generation of handle templates matching this configuration */
+    };
+
+    struct Transfer
+    {
+        CURL *handle = nullptr;
+        curl_slist *listResolve = nullptr;
+        curl_slist *listHeaders = nullptr;
+        StreamEncoder::PtrUnique encoder;   /* Set when uploaded datas are compressed */
+        Digest::PtrUnique digest;           /* Set when digest of transferred datas is computed */
+        ProgressAggregator *progress = nullptr; /* Set when transfer progress is part of the job progress */
+        Settings settings;                  /* Manager configuration used by the transfer */
+
+        bool useCache = false;              /* Set when response is managed by HTTP cache */
+        HttpCache::Validators validatorsSent;
+        HttpCache::Validators validatorsRecv;
+        bool storeAllowed = true;       /* Unset when response forbid to be stored (Cache-Control) */
+        std::string host;               /* Host on which a slot has been acquired */
+
+        Request *req = nullptr;         /* Request used by curl callbacks */
+        Request *reqOrigin = nullptr;   /* Request of the job (differ from "req" for hedged transfers) */
+        Request::PtrShared reqHedge;    /* Owned request of hedged transfers */
+        Transfer *twin = nullptr;       /* Hedging counterpart transfer */
+
+        Request::TimePoint tsStart;
+        Request::TimePoint deadline;    /* Request deadline, including batch one for jobs */
+
+        size_t offsetSink = 0;          /* Number of bytes consumed by data sink of the request */
+        bool canPause = true;           /* Unset when transfer can't be resumed (performed on calling thread) */
+        bool isPaused = false;
+        bool wasPaused = false;         /* Set once paused, transfer durations are then irrelevant */
+    };
+    using PtrTransfer = std::unique_ptr<Transfer>;
+
+    struct ControlRequest
+    {
+        ControlRequest(const std::string &urlCtrl, const Url &urlSrc, bool createMissingDirs) :
+            url(urlCtrl), urlRef(urlSrc), createDirs(createMissingDirs) {}
+
+        std::string url;                /* URL to use for the request */
+        Url urlRef;                     /* URL from which request has been created (used for scheme, host, etc...) */
+        bool createDirs;                /* Set to create missing directories */
+
+        CURLcode result = CURLE_OK;
+
+        bool fetchInfos = false;        /* Set to retrieve informations of remote ressource */
+        long codeHttp = 0;
+        curl_off_t size = -1;
+        curl_off_t filetime = -1;
+        std::string etag;
+    };
+
+    struct Worker
+    {
+        CURLM *handleMulti = nullptr;
+        std::vector<PtrTransfer> listTransfers;
+
+        std::deque<Request*> queueReqs;
+        std::mutex mutexQueue;
+
+        int cancelsSeen = 0;            /* Cancellations generation already managed by the worker */
+        int pausesSeen = 0;             /* Pauses generation already managed by the worker */
+
+        Thread thread;
+    };
+    using PtrWorker = std::unique_ptr<Worker>;
+
+    struct PendingResult
+    {
+        std::vector<std::promise<IdError>> listPromises;   /* A request may be listed multiple times */
+        bool isSet = false;
+    };
+
 public:
     explicit Impl(TransferManager *parent);
     ~Impl();
@@ -131,53 +287,175 @@ public:
 public:
     void init();
 
+    IdError prewarmConnections(const std::vector<Url> &listUrls);
+    void cancelRequests(const std::vector<Request::Id> &listIds);
+    void abortJob();
+    void pauseRequests(const std::vector<Request::Id> &listIds, bool paused);
+    void pauseJob(bool paused);
+    void createDirectories();
+    void skipUnchanged();
+    void prefetchSizes();
+    IdError performControls(std::vector<ControlRequest> &listCtrls, Request::TimePoint deadline = Request::TimePoint::max());
+
     IdError jobPrepare(Request::TypeTransfer typeTransfer, const Request::List &listReqs);
+    IdError verifyRequest(Request::TypeTransfer typeTransfer, const Request &req) const;
+    std::future<BatchResult> jobSubmit(const Request::List &listReqs, std::vector<std::future<IdError>> *listFutures, CbDone cbDone = nullptr);
+    void jobStart();
     void jobPerform();
 
+    IdError transferNow(Request *req);
+
+    Progress createProgress() const;
+
 private:
     bool transferPrepare();
-    bool performTransfer(IdError &idErr);
-    void updateProgress();
-    IdError manageStatus(int &counterReqsDone);
-    bool errorAllowRetry(CURLcode curlErr, IdError &idErr);
-
+    void transferPerform(Worker &worker);
+    IdError transferAdmit(Worker &worker);
+    IdError manageCancellations(Worker &worker);
+    bool completeCancelled(Worker &worker, Request *req);
+    bool completeExpired(Worker &worker, Request *req);
+    bool queueFollowers(Worker &worker, const Request *req);
+    IdError managePauses(Worker &worker);
+    bool transferSteal(Worker &worker);
+    bool performTransfer(Worker &worker, IdError &idErr);
+    void updateProgress(bool force = false);
+    IdError manageStatus(Worker &worker);
+    IdError manageDeadlines(Worker &worker);
+    void manageHedging(Worker &worker);
+    int getPollTimeout() const;
+    bool manageStatusNow(Transfer &transfer, CURLcode curlErr, IdError &idErr);
+    bool errorAllowRetry(CURLcode curlErr, long codeHttp, IdError &idErr);
+    bool errorAllowFailover(CURLcode curlErr, long codeHttp) const;
+    void registerFailure(IdError idErr);
+    void resolveRequest(const Request *req, IdError idErr);
+    void resolveJob(IdError idErr);
+
+    void wakeUpWorkers(const Worker *workerSrc = nullptr);
+    bool queueIsEmpty(Worker &worker);
+
+    bool acquireHost(Request *req);
+    CURL* createHandle(const Request *req, const Settings &settings);
+    Transfer* createTransfer(Worker &worker, Request *req, Request *reqOrigin);
+    void releaseTransfer(Worker &worker, Transfer *transfer);
     void cleanHandles();
     void cleanRequests();
 
-    void configureHandle(CURL *handle, Request *req);
+    void configureTemplate(CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, const Settings &settings) const;
+    Settings createSettings() const;
+    void configureHandle(Transfer *transfer);
+    void configureHttpCache(Transfer *transfer);
+    bool manageHttpCache(Transfer *transfer);
+    bool deliverFromCache(Request *req, const Settings &settings);
+    Digest::PtrUnique createDigest(const Request *req, TypeDigest idDigest) const;
+    bool verifyDigest(Digest &digest, Request *req, const Request *reqOrigin) const;
+    void coalesceRequests(Request::List &listReqs);
+    void completeFollowers(const Request *req);
+    static bool isUnchanged(const Request &req, const ControlRequest &ctrl);
+    curl_slist* createResolveList(const Url &url) const;
+    bool needCreateDirs(const Request *req) const;
+    Request::TimePoint getDeadline(const Request *req) const;
 
 private:
+    static PtrWorker createWorker();
+
     static size_t curlCbWrite(char *ptr, size_t size, size_t nmemb, void *userdata);
+    static size_t curlCbHeader(char *buffer, size_t size, size_t nitems, void *userdata);
+    static size_t curlCbHeaderControl(char *buffer, size_t size, size_t nitems, void *userdata);
+    static bool parseHeader(std::string_view line, std::string &name, std::string &value);
     static size_t curlCbRead(char *buffer, size_t size, size_t nitems, void *userdata);
+    static size_t readRequest(const Transfer *transfer, char *buffer, size_t size);
+    static void setSizes(const Transfer *transfer, size_t sizeTotal, size_t sizeCurrent);
+    static size_t curlCbReadEncoded(char *buffer, size_t size, size_t nitems, void *userdata);
     static int curlCbProgress(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
     static int curlCbVerbose(CURL *handle, curl_infotype type, char *data, size_t size, void *userdata);
 
 private:
+    void dispatchEvent(const CallbackDispatcher::Event &event);
+
     static void defaultCbStarted(Request::TypeTransfer typeTransfer);
     static void defaultCbProgress(Request::TypeTransfer typeTransfer, size_t transferTotal, size_t transferNow);
     static void defaultCbCompleted(Request::TypeTransfer typeTransfer);
     static void defaultCbFailed(Request::TypeTransfer typeTransfer, IdError idErr);
 
 public:
-    CURLM* m_handleMulti = nullptr;
+    std::vector<PtrWorker> m_listWorkers;
+    size_t m_nbWorkersUsed;
 
     Request::TypeTransfer m_typeTransfer;
     Request::List m_listReqs;
+    std::unordered_map<const Request*, std::vector<Request*>> m_mapFollowers; /* Requests waiting for the result of an identical download */
+
+    std::atomic<int> m_nbReqsTodo;
+    std::atomic<int> m_nbReqsDone;
+    std::atomic<int> m_nbReqsActive;
+    std::atomic<IdError> m_failureStatus;
+
+    std::atomic<bool> m_abortJob;          /* Set to abort the whole job */
+    std::atomic<int> m_cancelsGeneration;  /* Incremented each time requests are cancelled */
+    std::atomic<int> m_nbReqsCancelled;
+    std::atomic<int> m_nbReqsExpired;      /* Requests which missed their own deadline */
+
+    std::atomic<bool> m_pauseJob;          /* Set to pause all transfers, kept between jobs */
+    std::atomic<int> m_pausesGeneration;   /* Incremented each time requests are paused or resumed */
+
+    std::unordered_map<const Request*, PendingResult> m_mapResults; /* Results of requests of a submitted job */
+    std::promise<BatchResult> m_promiseJob;
+    bool m_hasPromiseJob;
+    CbDone m_cbJobDone;                    /* Continuation of a submitted job */
+
+    ConcurrencyController m_ctrlConcurrency;
+    ProgressAggregator m_progress;
+    std::atomic<double> m_throughput;
+    Request::TimePoint m_tsProgressSample;
+    size_t m_sizeProgressSample;
+    Request::TimePoint m_tsProgressEmit;
+    size_t m_sizeProgressEmit;
+    Request::TimePoint m_deadlineBatch;
+
+    LatencyTracker m_latFirstByte;
+    LatencyTracker m_latCompletion;
+
+    ShareHandle m_share;
+    HandleTemplates m_templates;
+    DnsCache m_dnsCache;
+    DirectoryCache m_cacheDirs;
+    HttpCache m_cacheHttp;
+    ContentStore m_cacheContent;
+    SkipStats m_statsSkip;
 
     std::string m_username;
     std::string m_userpwd;
     int m_nbMaxTrials;
     long m_timeoutConnect;
     long m_timeoutTransfer;
+    long m_timeoutBatch;
     FlagOption m_options;
-
+    int m_nbMaxHost;
+    int m_nbWorkers;
+    TypeHedging m_hedgingPolicy;
+    double m_hedgingPercentile;
+    TypeFtpMethod m_ftpMethod;
+    TypeEncoding m_uploadEncoding;
+    TypeDigest m_digestAlgorithm;
+    TypeScheduling m_scheduling;
+    TypeCacheDelivery m_cacheDelivery;
+    long m_progressInterval;
+    size_t m_progressThreshold;
+
+    std::atomic<bool> m_jobRunning;        /* Set from job preparation until job results are given */
     Thread m_threadTransfer;
+    std::thread::id m_idThreadTransfer;
+    std::vector<Thread> m_listThreadsRetired; /* Transfer threads which started a new job from their continuation */
     std::mutex m_mutex;
+    std::mutex m_mutexProgress;
+    std::mutex m_mutexFollowers;
 
     CbStarted m_cbStarted;
     CbProgress m_cbProgress;
     CbCompleted m_cbCompleted;
     CbFailed m_cbFailed;
+    CbProgressInfos m_cbProgressInfos;
+    CallbackDispatcher m_dispatcher;
 
     TransferManager *m_parent;
 };
@@ -187,752 +465,4497 @@ public:
 /*      Private Class        */
 /*****************************/
 
-TransferManager::Impl::Impl(TransferManager *parent)
+TransferManager::Impl::Impl(TransferManager *parent) :
+    m_latFirstByte(HEDGING_NB_SAMPLES_MAX),
+    m_latCompletion(HEDGING_NB_SAMPLES_MAX),
+    m_dispatcher([this](const CallbackDispatcher::Event &event){ dispatchEvent(event); })
 {
     /* Manage library handle */
     Handle::instance();
 
     /* Set properties */
-    m_handleMulti = curl_multi_init();
-    if(!m_handleMulti){
+    PtrWorker worker = createWorker();
+    if(!worker){
         const std::string err = "Failed to initialise curl multi instance";
         TEASE_LOG_FATAL(err);
 
         throw std::runtime_error(err);
     }
+    m_listWorkers.push_back(std::move(worker));
+    m_nbWorkersUsed = 1;
+
+    m_nbReqsTodo = 0;
+    m_nbReqsDone = 0;
+    m_nbReqsActive = 0;
+    m_failureStatus = ERR_NO_ERROR;
+    m_abortJob = false;
+    m_cancelsGeneration = 0;
+    m_nbReqsCancelled = 0;
+    m_nbReqsExpired = 0;
+    m_pauseJob = false;
+    m_pausesGeneration = 0;
+    m_hasPromiseJob = false;
+    m_jobRunning = false;
+    m_deadlineBatch = Request::TimePoint::max();
+
+    m_throughput = 0.0;
+    m_sizeProgressSample = 0;
+    m_sizeProgressEmit = 0;
 
     m_nbMaxTrials = DEFAULT_NB_MAX_TRIALS;
     m_timeoutConnect = DEFAULT_TIMEOUT_CONNECT;
     m_timeoutTransfer = DEFAULT_TIMEOUT_TRANSFER;
+    m_timeoutBatch = DEFAULT_TIMEOUT_BATCH;
     m_options = FlagOption::OPT_NONE;
+    m_nbMaxHost = DEFAULT_NB_MAX_HOST;
+    m_nbWorkers = DEFAULT_NB_WORKERS;
+    m_hedgingPolicy = HEDGING_DISABLED;
+    m_hedgingPercentile = DEFAULT_HEDGING_PERCENTILE;
+    m_ftpMethod = FTP_METHOD_MULTICWD;
+    m_uploadEncoding = ENCODING_NONE;
+    m_digestAlgorithm = DIGEST_NONE;
+    m_scheduling = SCHEDULING_GROUPED;
+    m_cacheDelivery = CACHE_DELIVERY_COPY;
+    m_progressInterval = 0;
+    m_progressThreshold = 0;
+    m_statsSkip = SkipStats();
     m_parent = parent;
 }
 
 TransferManager::Impl::~Impl()
 {
+    /* Transfer thread and pending callbacks must not use destroyed members */
+    if(m_threadTransfer.valid()){
+        m_threadTransfer.wait();
+    }
+    m_listThreadsRetired.clear();
+    m_dispatcher.stop();
+
     cleanHandles();
     cleanRequests();
 
-    curl_multi_cleanup(m_handleMulti);
-}
-
-void TransferManager::Impl::init()
-{
-    /* Set default callbacks */
-    m_parent->setCbStarted(defaultCbStarted);
-    m_parent->setCbProgress(defaultCbProgress);
-    m_parent->setCbCompleted(defaultCbCompleted);
-    m_parent->setCbFailed(defaultCbFailed);
+    for(auto &worker : m_listWorkers){
+        curl_multi_cleanup(worker->handleMulti);
+    }
 }
 
-TransferManager::IdError TransferManager::Impl::jobPrepare(Request::TypeTransfer typeTransfer, const Request::List &listReqs)
+/*!
+ * \brief Use to open connections to a list of hosts
+ * \details
+ * A request without body is performed on each unique host, opened
+ * connections are then kept in shared connections cache, ready
+ * to be used by next transfers.
+ *
+ * \param[in] listUrls
+ * List of URLs of hosts to connect to.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if all connections
+ * have been opened, \c TransferManager::ERR_HOST_NOT_FOUND otherwise.
+ */
+TransferManager::IdError TransferManager::Impl::prewarmConnections(const std::vector<Url> &listUrls)
 {
-    /* Verify that a transfer is not already running */
-    if(m_parent->transferIsInProgress()){
-        TEASE_LOG_ERROR("Unable to start download, transfer already in progress");
-        return ERR_BUSY;
+    /* Prepare one request per unique host */
+    std::vector<ControlRequest> listCtrls;
+    for(const Url &url : listUrls){
+        const std::string root = StringHelper::format("%s://%s:%u/", Url::idSchemeToString(url.getIdScheme()).c_str(), url.getHost().c_str(), DnsCache::getPortEffective(url));
+
+        auto it = std::find_if(listCtrls.begin(), listCtrls.end(), [&root](const ControlRequest &ctrl){
+            return ctrl.url == root;
+        });
+        if(it == listCtrls.end()){
+            listCtrls.emplace_back(root, url, false);
+        }
     }
 
-    /* Verify that list is not empty */
-    if(listReqs.empty()){
-        TEASE_LOG_ERROR("List of requests is empty, no download process to perform");
-        return ERR_INVALID_REQUEST;
+    /* Open connections in parallel */
+    const IdError idErr = performControls(listCtrls);
+    if(idErr != ERR_NO_ERROR){
+        return idErr;
     }
 
-    /* Verify requests validity */
-    for(const auto &req : listReqs){
-        // Do all requests are expected transfer type ?
-        if(req->getTypeTransfer() != typeTransfer){
-            const std::string err = StringHelper::format("Receive request with a transfer type different than expected [type-req: %d, type-exp: %d]", req->getTypeTransfer(), typeTransfer);
-            TEASE_LOG_ERROR(err);
-            return ERR_INVALID_REQUEST;
-        }
+    /* Verify that each connection has been opened */
+    for(const ControlRequest &ctrl : listCtrls){
+        if(ctrl.result != CURLE_OK){
+            const std::string err = StringHelper::format("Failed to open connection [url: %s, curl-err: %d]", ctrl.url.c_str(), ctrl.result);
+            TEASE_LOG_WARN(err);
 
-        // Do URL is valid ?
-        const Url &url = req->getUrl();
-        if(!url.isValid()){
-            const std::string err = StringHelper::format("Receive invalid URL [id-scheme: %d, host: %s, path: %s]", url.getIdScheme(), url.getHost().c_str(), url.getPath().c_str());
-            TEASE_LOG_ERROR(err);
-            return ERR_INVALID_REQUEST;
+            return ERR_HOST_NOT_FOUND;
         }
+    }
+
+    return ERR_NO_ERROR;
+}
 
-        // Verify that datas are not empty for upload transfer
-        if(typeTransfer == Request::TRANSFER_UPLOAD){
-            const BytesArray &data = req->getData();
-            if(data.isEmpty()){
-                const std::string err = StringHelper::format("Receive empty data request for upload [id-scheme: %d, host: %s, path: %s]", url.getIdScheme(), url.getHost().c_str(), url.getPath().c_str());
-                TEASE_LOG_ERROR(err);
-                return ERR_INVALID_REQUEST;
+/*!
+ * \brief Use to create directories needed by an
+ * upload batch
+ * \details
+ * Each unique directory not known yet is created once (in
+ * parallel), uploads into those directories can then skip
+ * directories creation. \n
+ * Directories which failed to be created will simply be
+ * created by associated uploads.
+ *
+ * \sa DirectoryCache
+ */
+void TransferManager::Impl::createDirectories()
+{
+    /* Retrieve unknown directories */
+    std::vector<Url> listUrls;
+    for(const auto &req : m_listReqs){
+        for(size_t idMirror = 0; idMirror <= req->getMirrors().size(); ++idMirror){
+            const Url &url = (idMirror == 0) ? req->getUrl() : req->getMirrors()[idMirror - 1];
+            if(url.getIdScheme() == Url::SCHEME_FTP || url.getIdScheme() == Url::SCHEME_FTPS){
+                listUrls.push_back(url);
             }
         }
     }
 
-    /* Register requests */
-    m_typeTransfer = typeTransfer;
-    m_listReqs = listReqs;
+    std::vector<ControlRequest> listCtrls;
+    for(const Url &url : m_cacheDirs.listMissing(listUrls)){
+        listCtrls.emplace_back(DirectoryCache::createKey(url), url, true);
+    }
 
-    return ERR_NO_ERROR;
+    if(listCtrls.empty()){
+        return;
+    }
+
+    /* Create them */
+    if(performControls(listCtrls, m_deadlineBatch) != ERR_NO_ERROR){
+        return;
+    }
+
+    for(const ControlRequest &ctrl : listCtrls){
+        if(ctrl.result == CURLE_OK){
+            m_cacheDirs.insert(ctrl.urlRef);
+        }else{
+            const std::string err = StringHelper::format("Failed to create directory, it will be created by uploads [url: %s, curl-err: %d]", ctrl.url.c_str(), ctrl.result);
+            TEASE_LOG_WARN(err);
+        }
+    }
 }
 
-void TransferManager::Impl::jobPerform()
+/*!
+ * \brief Use to skip uploads which remote ressource
+ * is already up to date
+ * \details
+ * Informations of all remote ressources are retrieved in
+ * parallel (FTP: \c SIZE and \c MDTM commands, HTTP: \c HEAD
+ * request), skipped uploads are then completed without any
+ * transfer. \n
+ * Only URL set at configuration is checked (mirrors are ignored).
+ *
+ * \sa isUnchanged()
+ */
+void TransferManager::Impl::skipUnchanged()
 {
-    const int nbReqsTodo = m_listReqs.size();
-    int nbReqsDone = 0;
+    /* Reset status of previous batch */
+    for(const auto &req : m_listReqs){
+        req->ioSetSkipped(false);
+    }
 
-    IdError failureStatus = ERR_NO_ERROR;
+    if(!(m_options & FlagOption::OPT_SKIP_UNCHANGED)){
+        return;
+    }
 
-    /* Inform that transfer is started */
-    m_cbStarted(m_typeTransfer);
+    /* Retrieve informations of remote ressources */
+    std::vector<ControlRequest> listCtrls;
+    listCtrls.reserve(m_listReqs.size());
 
-    /* Perform transfer preparation */
-    bool succeed = transferPrepare();
-    if(!succeed){
-        failureStatus = ERR_INTERNAL;
-        goto stat_clean;
+    for(const auto &req : m_listReqs){
+        ControlRequest &ctrl = listCtrls.emplace_back(req->getUrl().toString(), req->getUrl(), false);
+        ctrl.fetchInfos = true;
     }
 
-    /* Do first call to perform transfer */
-    succeed = performTransfer(failureStatus);
-    if(!succeed){
-        goto stat_clean;
+    if(performControls(listCtrls, m_deadlineBatch) != ERR_NO_ERROR){
+        TEASE_LOG_WARN("Failed to retrieve informations of remote ressources, all uploads will be performed");
+        return;
     }
 
-    /* Perform transfer */
-    while(nbReqsDone < nbReqsTodo){
-        // Perform polling
-        curl_multi_wait(m_handleMulti, nullptr, 0, 1000, nullptr);
-        succeed = performTransfer(failureStatus);
-        if(!succeed){
-            goto stat_clean;
+    /* Skip up to date ressources */
+    SkipStats stats{};
+    for(size_t i = 0; i < listCtrls.size(); ++i){
+        Request &req = *m_listReqs[i];
+
+        ++stats.nbChecked;
+        if(!isUnchanged(req, listCtrls[i])){
+            continue;
         }
 
-        // Update progress
-        updateProgress();
+        const size_t size = req.getData().getSize();
+        req.ioSetSkipped(true);
+        req.ioSetSizeTotal(size);
+        req.ioSetSizeCurrent(size);
 
-        // Manage status
-        failureStatus = manageStatus(nbReqsDone);
-        if(failureStatus != ERR_NO_ERROR){
-            goto stat_clean;
-        }
+        ++stats.nbSkipped;
+        stats.nbBytesSkipped += size;
     }
 
-    /* Clean used ressources */
-stat_clean:
-    cleanHandles();
-    cleanRequests();
+    const std::string msg = StringHelper::format("Remote ressources checked, unchanged ones are skipped [nb-checked: %zu, nb-skipped: %zu, nb-bytes-skipped: %zu]", stats.nbChecked, stats.nbSkipped, stats.nbBytesSkipped);
+    TEASE_LOG_DEBUG(msg);
 
-    /* Inform user about transfer status */
-    if(failureStatus == ERR_NO_ERROR){
-        m_cbCompleted(m_typeTransfer);
-    }else{
-        m_cbFailed(m_typeTransfer, failureStatus);
-    }
+    Locker locker(m_mutex);
+    m_statsSkip.nbChecked += stats.nbChecked;
+    m_statsSkip.nbSkipped += stats.nbSkipped;
+    m_statsSkip.nbBytesSkipped += stats.nbBytesSkipped;
 }
 
-bool TransferManager::Impl::transferPrepare()
+/*!
+ * \brief Use to retrieve sizes of downloaded ressources
+ * before transfers start
+ * \details
+ * Sizes of all remote ressources are retrieved in parallel
+ * (FTP: \c SIZE command, HTTP: \c HEAD request) and set as
+ * expected size of each request: job progress total is then
+ * exact from the start, and download buffers can be
+ * allocated once. \n
+ * Requests which size can't be retrieved are simply
+ * downloaded with an unknown size.
+ *
+ * \sa Request::ioGetSizeExpected()
+ */
+void TransferManager::Impl::prefetchSizes()
 {
-    Locker locker(m_mutex);
-
-    /* Reset any current handle */
-    cleanHandles();
+    /* Retrieve informations of remote ressources */
+    std::vector<ControlRequest> listCtrls;
+    listCtrls.reserve(m_listReqs.size());
 
-    /* Prepare curl handle from request */
-    for(auto &req : m_listReqs){
-        // Create handle
-        CURL *handle = curl_easy_init();
-        if(!handle){
-            TEASE_LOG_ERROR("Failed to initialize easy handle");
-            return false;
-        }
+    for(const auto &req : m_listReqs){
+        ControlRequest &ctrl = listCtrls.emplace_back(req->getUrl().toString(), req->getUrl(), false);
+        ctrl.fetchInfos = true;
+    }
 
-        // Configure it
-        configureHandle(handle, req.get());
-        curl_multi_add_handle(m_handleMulti, handle);
+    if(performControls(listCtrls, m_deadlineBatch) != ERR_NO_ERROR){
+        TEASE_LOG_WARN("Failed to retrieve sizes of remote ressources, downloads will be performed with unknown sizes");
+        return;
     }
 
-    return true;
-}
+    /* Register known sizes */
+    size_t nbKnown = 0, sizeTotal = 0;
+    for(size_t i = 0; i < listCtrls.size(); ++i){
+        const ControlRequest &ctrl = listCtrls[i];
+        if(ctrl.result != CURLE_OK || ctrl.size <= 0){
+            continue;
+        }
 
-bool TransferManager::Impl::performTransfer(IdError &idErr)
-{
-    Locker locker(m_mutex);
-    int nbReqsRunning;
+        const bool isHttp = ctrl.urlRef.getIdScheme() == Url::SCHEME_HTTP || ctrl.urlRef.getIdScheme() == Url::SCHEME_HTTPS;
+        if(isHttp && (ctrl.codeHttp < 200 || ctrl.codeHttp >= 300)){
+            continue;
+        }
 
-    CURLMcode curlErr = curl_multi_perform(m_handleMulti, &nbReqsRunning);
-    if(curlErr != CURLM_OK){
-        idErr = ERR_INTERNAL;
+        const size_t size = static_cast<size_t>(ctrl.size);
+        m_listReqs[i]->ioSetSizeExpected(size);
+        m_listReqs[i]->ioSetSizeTotal(size);
 
-        const std::string err = StringHelper::format("Error when trying to perform on multi handle [curl-err: %d]", curlErr);
-        TEASE_LOG_ERROR(err);
-        return false;
+        ++nbKnown;
+        sizeTotal += size;
     }
 
-    return true;
+    const std::string msg = StringHelper::format("Sizes of remote ressources prefetched [nb-reqs: %zu, nb-known: %zu, size-total: %zu]", m_listReqs.size(), nbKnown, sizeTotal);
+    TEASE_LOG_DEBUG(msg);
 }
 
-void TransferManager::Impl::updateProgress()
+/*!
+ * \brief Use to perform requests without body in parallel
+ * \details
+ * Used to perform operations which only need the control
+ * connection (opening connections, creating directories, etc...).
+ * Opened connections are kept in shared connections cache.
+ *
+ * \param[in, out] listCtrls
+ * List of requests to perform, result of each request
+ * will be set.
+ * \param[in] deadline
+ * Time at which requests still running are stopped
+ * (used to apply batch timeout to jobs control requests).
+ *
+ * \return
+ * Returns \c TransferManager::ERR_INTERNAL if failed to
+ * perform requests.
+ */
+TransferManager::IdError TransferManager::Impl::performControls(std::vector<ControlRequest> &listCtrls, Request::TimePoint deadline)
 {
-    /* Calculate list progress */
-    size_t sizeTotal = 0, sizeCurrent = 0, sizeRef = 0;
-    int nbUnks = 0;
-    for(const auto &req : m_listReqs){
-        // Find maximum size on all request
-        sizeRef = std::max(sizeRef, req->ioGetSizeTotal());
+    /* Retrieve needed configuration */
+    std::string username, userpwd;
+    long timeoutConnect;
+    int nbMaxHost;
+    {
+        Locker locker(m_mutex);
 
-        // Count number of unknown request size
-        if(req->ioGetSizeTotal() == 0){
-            ++nbUnks;
+        username = m_username;
+        userpwd = m_userpwd;
+        timeoutConnect = m_timeoutConnect;
+        nbMaxHost = m_nbMaxHost;
+    }
 
-        // Transfer has started, we have all infos
-        }else{
-            sizeTotal += req->ioGetSizeTotal();
-            sizeCurrent += req->ioGetSizeCurrent();
-        }
+    /* Control requests can't last longer than given deadline */
+    long timeoutMs = timeoutConnect * 1000;
+    if(deadline != Request::TimePoint::max()){
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Request::Clock::now());
+        timeoutMs = std::clamp<long>(static_cast<long>(remaining.count()), 1L, timeoutMs);
     }
 
-    /* Adjust total size with number of unknown size request */
-    sizeTotal += (nbUnks * sizeRef);
+    CURLM *handleMulti = curl_multi_init();
+    if(!handleMulti){
+        TEASE_LOG_ERROR("Failed to initialise curl multi instance used by control requests");
+        return ERR_INTERNAL;
+    }
 
-    /* Inform user */
-    m_cbProgress(m_typeTransfer, sizeTotal, sizeCurrent);
-}
+    curl_multi_setopt(handleMulti, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(nbMaxHost));
 
-TransferManager::IdError TransferManager::Impl::manageStatus(int &counterReqsDone)
-{
-    IdError idErr = ERR_NO_ERROR;
-    CURLMsg *msg = nullptr;
-    int nbMsgLeft = 0;
+    /* Prepare handles */
+    std::vector<std::pair<CURL*, curl_slist*>> listHandles;
+    for(size_t i = 0; i < listCtrls.size(); ++i){
+        ControlRequest &ctrl = listCtrls[i];
 
-    /* Manage status of each request */
-    while((msg = curl_multi_info_read(m_handleMulti, &nbMsgLeft))){
-        // Do we already have detected an error ?
-        if(idErr != ERR_NO_ERROR){
-            continue; // Curl doesn't allow to clean internal messages queue, so before returning because an error was detected, we have to iterate through every messages
+        CURL *handle = curl_easy_init();
+        if(!handle){
+            TEASE_LOG_ERROR("Failed to initialize easy handle");
+            ctrl.result = CURLE_FAILED_INIT;
+            continue;
         }
 
-        // Ignore request not finished
-        if(msg->msg != CURLMSG_DONE){
-            continue; // Read status of next request
+        curl_easy_setopt(handle, CURLOPT_URL, ctrl.url.c_str());
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, &ctrl);
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(handle, CURLOPT_SHARE, m_share.get());
+        curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, m_dnsCache.getTimeout());
+        curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, timeoutConnect);
+        curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeoutMs);
+
+        switch(ctrl.urlRef.getIdScheme())
+        {
+            case Url::SCHEME_FTPS:{
+                curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+            }TEASE_FALLTHROUGH;
+
+            case Url::SCHEME_FTP:{
+                curl_easy_setopt(handle, CURLOPT_USERNAME, username.c_str());
+                curl_easy_setopt(handle, CURLOPT_PASSWORD, userpwd.c_str());
+
+                if(ctrl.createDirs){
+                    curl_easy_setopt(handle, CURLOPT_FTP_FILEMETHOD, CURLFTPMETHOD_MULTICWD);
+                    curl_easy_setopt(handle, CURLOPT_FTP_CREATE_MISSING_DIRS, CURLFTP_CREATE_DIR_RETRY);
+                }
+            }break;
+
+            case Url::SCHEME_HTTPS:{
+                curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+            }break;
+
+            default: break;
         }
 
-        // Count requests which succeed
-        const CURLcode curlErr = msg->data.result;
-        if(curlErr == CURLE_OK){
-            ++counterReqsDone;
-            continue;
+        // Size is always retrieved (FTP "SIZE" command, HTTP "Content-Length" header), modification time must be requested
+        if(ctrl.fetchInfos){
+            curl_easy_setopt(handle, CURLOPT_FILETIME, 1L);
+            curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, curlCbHeaderControl);
+            curl_easy_setopt(handle, CURLOPT_HEADERDATA, &ctrl);
+
+            // FTP informations are given as pseudo-headers to the write function
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlCbHeaderControl);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, &ctrl);
         }
 
-        // Do error allow us to a retry ? */
-        const bool retryAllowed = errorAllowRetry(curlErr, idErr);
-        if(!retryAllowed){
-            continue; // We have detected an error, so now we just need to clean remaining messages
+        curl_slist *listResolve = createResolveList(ctrl.urlRef);
+        if(listResolve){
+            curl_easy_setopt(handle, CURLOPT_RESOLVE, listResolve);
         }
 
-        // Retrieve current request informations
-        CURL *handle = msg->easy_handle;
-        Request *req = nullptr;
-        curl_easy_getinfo(handle, CURLINFO_PRIVATE, &req);
+        curl_multi_add_handle(handleMulti, handle);
+        listHandles.emplace_back(handle, listResolve);
+    }
 
-        // Have we reach maximal number of retry for this request ?
-        if(req->ioGetNbTrials() >= m_nbMaxTrials){
-            const std::string err = StringHelper::format("Reached maximum number of trials [url: %s, curl-err: %d]", req->getUrl().toString().c_str(), curlErr);
-            TEASE_LOG_WARN(err);
+    /* Perform requests */
+    IdError idErr = ERR_NO_ERROR;
 
-            idErr = ERR_MAX_TRIALS;
-            continue;
+    int nbRunning = 0;
+    do{
+        const CURLMcode multiErr = curl_multi_perform(handleMulti, &nbRunning);
+        if(multiErr != CURLM_OK){
+            const std::string err = StringHelper::format("Failed to perform control requests [multi-err: %d]", multiErr);
+            TEASE_LOG_ERROR(err);
+
+            idErr = ERR_INTERNAL;
+            break;
         }
 
-        // Prepare new trial for current request
-        const std::string logTrial = StringHelper::format("Perform new trial for request [url: %s, nb-trials: %d, curl-err: %d]", req->getUrl().toString().c_str(), req->ioGetNbTrials(), curlErr);
-        TEASE_LOG_DEBUG(logTrial);
+        if(nbRunning > 0){
+            curl_multi_poll(handleMulti, nullptr, 0, 1000, nullptr);
+        }
 
-        req->ioRegisterTry();
+    }while(nbRunning > 0);
+
+    /* Retrieve results */
+    int nbMsgs = 0;
+    while(CURLMsg *msg = curl_multi_info_read(handleMulti, &nbMsgs)){
+        if(msg->msg != CURLMSG_DONE){
+            continue;
+        }
+
+        ControlRequest *ctrl = nullptr;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &ctrl);
+        ctrl->result = msg->data.result;
 
-        curl_multi_remove_handle(m_handleMulti, handle);
-        curl_easy_reset(handle);
+        if(ctrl->fetchInfos && ctrl->result == CURLE_OK){
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &ctrl->codeHttp);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &ctrl->size);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_FILETIME_T, &ctrl->filetime);
+        }
+    }
 
-        configureHandle(handle, req);
-        curl_multi_add_handle(m_handleMulti, handle);
+    /* Clean ressources (connections are kept by shared cache) */
+    for(const auto &pair : listHandles){
+        curl_multi_remove_handle(handleMulti, pair.first);
+        curl_easy_cleanup(pair.first);
+        curl_slist_free_all(pair.second);
     }
+    curl_multi_cleanup(handleMulti);
 
     return idErr;
 }
 
-bool TransferManager::Impl::errorAllowRetry(CURLcode curlErr, IdError &idErr)
+/*!
+ * \brief Use to cancel requests of current job
+ * \details
+ * Requests are flagged, workers are then woken up
+ * to remove their transfers right away.
+ *
+ * \param[in] listIds
+ * Identifiers of requests to cancel, identifiers
+ * not belonging to current job are ignored.
+ *
+ * \sa manageCancellations()
+ */
+void TransferManager::Impl::cancelRequests(const std::vector<Request::Id> &listIds)
 {
-    switch(curlErr)
-    {
-        case CURLE_UNSUPPORTED_PROTOCOL:
-        case CURLE_NOT_BUILT_IN:
-        case CURLE_OUT_OF_MEMORY:{
-            const std::string err = StringHelper::format("Received internal error which require attention [curl-err: %d]", curlErr);
-            TEASE_LOG_FATAL(err);
+    const std::unordered_set<Request::Id> setIds(listIds.cbegin(), listIds.cend());
 
-            idErr = ERR_INTERNAL;
-        }break;
+    Locker locker(m_mutex);
 
-        case CURLE_REMOTE_DISK_FULL:        idErr = ERR_MEMORY_FULL_REMOTE; break;
-        case CURLE_URL_MALFORMAT:           idErr = ERR_INVALID_REQUEST;    break;
-        case CURLE_REMOTE_FILE_NOT_FOUND:   idErr = ERR_CONTENT_NOT_FOUND;  break;
-        case CURLE_LOGIN_DENIED:            idErr = ERR_INVALID_LOGIN;      break;
-        case CURLE_ABORTED_BY_CALLBACK:     idErr = ERR_USER_ABORT;         break;
+    bool hasCancelled = false;
+    for(const auto &req : m_listReqs){
+        if(setIds.count(req->getId()) > 0){
+            req->ioAbort();
+            hasCancelled = true;
+        }
+    }
 
-        default:{
-            return true; // Any other errors allow to perform new try
-        }break;
+    if(hasCancelled){
+        ++m_cancelsGeneration;
+        wakeUpWorkers();
     }
+}
 
-    return false;
+/*!
+ * \brief Use to abort the whole job
+ * \details
+ * Workers are woken up to stop all their
+ * transfers right away.
+ */
+void TransferManager::Impl::abortJob()
+{
+    m_abortJob = true;
+
+    Locker locker(m_mutex);
+    wakeUpWorkers();
 }
 
-void TransferManager::Impl::cleanHandles()
+/*!
+ * \brief Use to pause or resume requests of
+ * current job
+ * \details
+ * Requests are flagged, workers are then woken up
+ * to apply new state to their transfers.
+ *
+ * \param[in] listIds
+ * Identifiers of requests to use, identifiers
+ * not belonging to current job are ignored.
+ * \param[in] paused
+ * Set to \c true to pause requests, \c false
+ * to resume them.
+ *
+ * \sa managePauses()
+ */
+void TransferManager::Impl::pauseRequests(const std::vector<Request::Id> &listIds, bool paused)
 {
-    CURL **list = curl_multi_get_handles(m_handleMulti);
-    if(list){
-        // Clean any handle
-        for(int i = 0; list[i]; ++i){
-            curl_multi_remove_handle(m_handleMulti, list[i]);
-            curl_easy_cleanup(list[i]);
+    const std::unordered_set<Request::Id> setIds(listIds.cbegin(), listIds.cend());
+
+    Locker locker(m_mutex);
+
+    bool hasChanged = false;
+    for(const auto &req : m_listReqs){
+        if(setIds.count(req->getId()) > 0){
+            req->ioSetPaused(paused);
+            hasChanged = true;
         }
+    }
 
-        // Clean array
-        curl_free(list);
+    if(hasChanged){
+        ++m_pausesGeneration;
+        wakeUpWorkers();
     }
 }
 
-void TransferManager::Impl::cleanRequests()
+/*!
+ * \brief Use to pause or resume all transfers
+ *
+ * \param[in] paused
+ * Set to \c true to pause transfers.
+ *
+ * \sa managePauses()
+ */
+void TransferManager::Impl::pauseJob(bool paused)
 {
-    m_listReqs.clear();
+    m_pauseJob = paused;
+
+    Locker locker(m_mutex);
+    ++m_pausesGeneration;
+    wakeUpWorkers();
 }
 
-void TransferManager::Impl::configureHandle(CURL *handle, Request *req)
+void TransferManager::Impl::init()
 {
-    /* URL informations */
-    const Url &url = req->getUrl();
-    curl_easy_setopt(handle, CURLOPT_URL, url.toString().c_str());
+    /* Set default callbacks */
+    m_parent->setCbStarted(defaultCbStarted);
+    m_parent->setCbProgress(defaultCbProgress);
+    m_parent->setCbCompleted(defaultCbCompleted);
+    m_parent->setCbFailed(defaultCbFailed);
+}
 
-    /* Manage protocols behaviours */
-    switch(url.getIdScheme())
+TransferManager::IdError TransferManager::Impl::jobPrepare(Request::TypeTransfer typeTransfer, const Request::List &listReqs)
+{
+    /* Verify that a transfer is not already running */
+    if(m_jobRunning){
+        TEASE_LOG_ERROR("Unable to start download, transfer already in progress");
+        return ERR_BUSY;
+    }
+
+    /* Verify that list is not empty */
+    if(listReqs.empty()){
+        TEASE_LOG_ERROR("List of requests is empty, no download process to perform");
+        return ERR_INVALID_REQUEST;
+    }
+
+    /* Verify requests validity */
+    for(const auto &req : listReqs){
+        const IdError idErr = verifyRequest(typeTransfer, *req);
+        if(idErr != ERR_NO_ERROR){
+            return idErr;
+        }
+    }
+
+    /* Reserve manager (another thread may have started a job meanwhile) */
+    bool expected = false;
+    if(!m_jobRunning.compare_exchange_strong(expected, true)){
+        TEASE_LOG_ERROR("Unable to start download, transfer already in progress");
+        return ERR_BUSY;
+    }
+
+    /* Register requests */
     {
-        case Url::SCHEME_FTPS:{
-            curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
-        }TEASE_FALLTHROUGH;
+        Locker locker(m_mutex);
+        m_typeTransfer = typeTransfer;
+        m_listReqs = listReqs;
+    }
 
-        case Url::SCHEME_FTP:{
-            curl_easy_setopt(handle, CURLOPT_USERNAME, m_username.c_str());
-            curl_easy_setopt(handle, CURLOPT_PASSWORD, m_userpwd.c_str());
-        }break;
+    m_abortJob = false;
+    m_mapResults.clear();
+    m_hasPromiseJob = false;
+    m_cbJobDone = nullptr;
 
-        case Url::SCHEME_HTTPS:{
-            curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
-        }break;
+    return ERR_NO_ERROR;
+}
 
-        default: break;
+/*!
+ * \brief Use to start transfer thread of
+ * a prepared job
+ * \details
+ * Thread of previous job may still be running the job
+ * continuation (see submit(const Request::List&, CbDone)): it is
+ * waited for, unless this job is started from that continuation.
+ */
+void TransferManager::Impl::jobStart()
+{
+    if(m_threadTransfer.valid()){
+        if(std::this_thread::get_id() == m_idThreadTransfer){
+            m_listThreadsRetired.push_back(std::move(m_threadTransfer));
+        }else{
+            m_threadTransfer.wait();
+        }
     }
 
-    /* Request datas */
-    curl_easy_setopt(handle, CURLOPT_PRIVATE, req);
+    /* Forget retired threads which are finished */
+    m_listThreadsRetired.erase(std::remove_if(m_listThreadsRetired.begin(), m_listThreadsRetired.end(), [](const Thread &thread){
+        return thread.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), m_listThreadsRetired.end());
 
-    /* Manage configurations options related to the transfer type */
-    switch(m_typeTransfer)
+    m_threadTransfer = std::async(std::launch::async, &Impl::jobPerform, this);
+}
+
+/*!
+ * \brief Use to prepare and start a job which
+ * results are given through futures
+ *
+ * \param[in] listReqs
+ * List of requests to transfer, transfer type is
+ * deduced from those.
+ * \param[out] listFutures
+ * List filled with one future per request (in same
+ * order than \c listReqs). \n
+ * Can be \c nullptr if not needed.
+ * \param[in] cbDone
+ * Continuation to call with the job result, see resolveJob(). \n
+ * If job can't be started, it is called right away. \n
+ * Can be \c nullptr if not needed.
+ *
+ * \return
+ * Returns future of the job result. If job can't be
+ * started, it is already ready.
+ */
+std::future<TransferManager::BatchResult> TransferManager::Impl::jobSubmit(const Request::List &listReqs, std::vector<std::future<IdError>> *listFutures, CbDone cbDone)
+{
+    /* Transfer type is deduced from requests (consistency is verified by job preparation) */
+    const Request::TypeTransfer typeTransfer = listReqs.empty() ? Request::TRANSFER_UNK : listReqs.front()->getTypeTransfer();
+
+    /* Perform pre-job verifications, errors are given through futures */
+    const IdError idErr = jobPrepare(typeTransfer, listReqs);
+    if(idErr != ERR_NO_ERROR){
+        if(listFutures){
+            listFutures->clear();
+            for(size_t i = 0; i < listReqs.size(); ++i){
+                std::promise<IdError> promise;
+                promise.set_value(idErr);
+                listFutures->push_back(promise.get_future());
+            }
+        }
+
+        std::promise<BatchResult> promise;
+        promise.set_value(BatchResult{typeTransfer, idErr});
+
+        if(cbDone){
+            cbDone(BatchResult{typeTransfer, idErr});
+        }
+
+        return promise.get_future();
+    }
+
+    /* Register promises before starting job, transfer thread is then the only one to use them */
+    if(listFutures){
+        listFutures->clear();
+        listFutures->reserve(listReqs.size());
+
+        for(const auto &req : listReqs){
+            std::vector<std::promise<IdError>> &listPromises = m_mapResults[req.get()].listPromises;
+            listPromises.emplace_back();
+            listFutures->push_back(listPromises.back().get_future());
+        }
+    }
+
+    m_promiseJob = std::promise<BatchResult>();
+    m_hasPromiseJob = true;
+    m_cbJobDone = std::move(cbDone);
+    std::future<BatchResult> future = m_promiseJob.get_future();
+
+    /* Start transfer process */
+    jobStart();
+
+    return future;
+}
+
+/*!
+ * \brief Use to verify that a request can
+ * be transferred
+ *
+ * \param[in] typeTransfer
+ * Expected transfer type.
+ * \param[in] req
+ * Request to verify.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if request is valid,
+ * \c TransferManager::ERR_INVALID_REQUEST otherwise.
+ */
+TransferManager::IdError TransferManager::Impl::verifyRequest(Request::TypeTransfer typeTransfer, const Request &req) const
+{
+    /* Do request is expected transfer type ? */
+    if(req.getTypeTransfer() != typeTransfer){
+        const std::string err = StringHelper::format("Receive request with a transfer type different than expected [type-req: %d, type-exp: %d]", req.getTypeTransfer(), typeTransfer);
+        TEASE_LOG_ERROR(err);
+        return ERR_INVALID_REQUEST;
+    }
+
+    /* Verify that upload encoding can be used */
+    if(typeTransfer == Request::TRANSFER_UPLOAD && !encodingIsSupported(m_uploadEncoding)){
+        const std::string err = StringHelper::format("Upload encoding is not supported by this build [id-encoding: %d]", m_uploadEncoding);
+        TEASE_LOG_ERROR(err);
+        return ERR_INVALID_REQUEST;
+    }
+
+    /* Do URL is valid ? */
+    const Url &url = req.getUrl();
+    if(!url.isValid()){
+        const std::string err = StringHelper::format("Receive invalid URL [id-scheme: %d, host: %s, path: %s]", url.getIdScheme(), url.getHost().c_str(), url.getPath().c_str());
+        TEASE_LOG_ERROR(err);
+        return ERR_INVALID_REQUEST;
+    }
+
+    for(const Url &mirror : req.getMirrors()){
+        if(!mirror.isValid()){
+            const std::string err = StringHelper::format("Receive invalid mirror URL [id-scheme: %d, host: %s, path: %s]", mirror.getIdScheme(), mirror.getHost().c_str(), mirror.getPath().c_str());
+            TEASE_LOG_ERROR(err);
+            return ERR_INVALID_REQUEST;
+        }
+    }
+
+    /* Verify that expected digest can be checked */
+    TypeDigest idDigest;
+    std::string valueDigest;
+    if(!req.getExpectedDigest().empty() && !Digest::parse(req.getExpectedDigest(), idDigest, valueDigest)){
+        const std::string err = StringHelper::format("Receive invalid expected digest [digest: %s, url: %s]", req.getExpectedDigest().c_str(), url.toString().c_str());
+        TEASE_LOG_ERROR(err);
+        return ERR_INVALID_REQUEST;
+    }
+
+    /* Verify that datas are not empty for upload transfer */
+    if(typeTransfer == Request::TRANSFER_UPLOAD && req.getData().isEmpty()){
+        const std::string err = StringHelper::format("Receive empty data request for upload [id-scheme: %d, host: %s, path: %s]", url.getIdScheme(), url.getHost().c_str(), url.getPath().c_str());
+        TEASE_LOG_ERROR(err);
+        return ERR_INVALID_REQUEST;
+    }
+
+    return ERR_NO_ERROR;
+}
+
+/*!
+ * \brief Use to transfer a request on the
+ * calling thread
+ * \details
+ * Easy handle is performed directly, so that transfer doesn't pay
+ * thread creation nor multi interface polling. Request is
+ * configured like job transfers and follow same retries,
+ * failovers and errors mapping.
+ *
+ * \param[in, out] req
+ * Request to transfer.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if succeed.
+ *
+ * \sa manageStatusNow()
+ */
+TransferManager::IdError TransferManager::Impl::transferNow(Request *req)
+{
+    /* Retrieve needed configuration and verify request validity */
+    IdError idErr = ERR_NO_ERROR;
+    Settings settings;
     {
-        case Request::TRANSFER_DOWNLOAD:{
-            // Manage write callbacks
-            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlCbWrite);
-            curl_easy_setopt(handle, CURLOPT_WRITEDATA, req);
-        }break;
+        Locker locker(m_mutex);
 
-        case Request::TRANSFER_UPLOAD:{
-            // Manage upload configuration
-            curl_easy_setopt(handle, CURLOPT_UPLOAD, 1L);
-            curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(req->getData().getSize()));
+        idErr = verifyRequest(req->getTypeTransfer(), *req);
+        settings = createSettings();
+    }
 
-            // Manage read callbacks
-            curl_easy_setopt(handle, CURLOPT_READFUNCTION, curlCbRead);
-            curl_easy_setopt(handle, CURLOPT_READDATA, req);
+    if(idErr != ERR_NO_ERROR){
+        return idErr;
+    }
+
+    /* Downloads available in content cache are completed without any transfer */
+    req->ioReset();
+    if(deliverFromCache(req, settings)){
+        return ERR_NO_ERROR;
+    }
+
+    /* Perform trials until request succeed or can't be retried (connections stay in shared connections cache) */
+    bool retry = true;
+    while(retry){
+        // Each trial use a fresh transfer, datas of previous ones must not be kept (idle handle of the scheme is reused, failover may change it)
+        const Url::IdScheme idScheme = req->ioGetUrl().getIdScheme();
+
+        CURL *handle = m_templates.acquireHandle(idScheme, req->getTypeTransfer(), settings.generationTemplates, [this, &settings](CURL *handleTemplate, Url::IdScheme idSchemeTemplate, Request::TypeTransfer typeTransfer){
+            configureTemplate(handleTemplate, idSchemeTemplate, typeTransfer, settings);
+        });
+        if(!handle){
+            TEASE_LOG_ERROR("Failed to initialize easy handle");
+            return ERR_INTERNAL;
+        }
+
+        Transfer transfer;
+        transfer.handle = handle;
+        transfer.host = req->ioGetUrl().getHost();
+        transfer.req = req;
+        transfer.reqOrigin = req;
+        transfer.settings = settings;
+        transfer.tsStart = Request::Clock::now();
+        transfer.deadline = req->getDeadline();
+        transfer.canPause = false;
+
+        if(req->getTypeTransfer() == Request::TRANSFER_DOWNLOAD){
+            req->getData().clear();
+            req->getData().reserve(req->ioGetSizeExpected());
+        }
+
+        configureHandle(&transfer);
+        const CURLcode curlErr = curl_easy_perform(handle);
+        retry = manageStatusNow(transfer, curlErr, idErr);
+
+        m_templates.releaseHandle(handle, idScheme, req->getTypeTransfer(), settings.generationTemplates);
+        curl_slist_free_all(transfer.listResolve);
+        curl_slist_free_all(transfer.listHeaders);
+    }
+
+    return idErr;
+}
+
+/*!
+ * \brief Use to manage status of a transfer
+ * performed on the calling thread
+ *
+ * \param[in] transfer
+ * Performed transfer.
+ * \param[in] curlErr
+ * Result of the transfer.
+ * \param[out] idErr
+ * Result of the request, only relevant if no new trial
+ * has to be performed.
+ *
+ * \return
+ * Returns \c true if a new trial must be performed.
+ *
+ * \sa transferNow()
+ */
+bool TransferManager::Impl::manageStatusNow(Transfer &transfer, CURLcode curlErr, IdError &idErr)
+{
+    Request *req = transfer.req;
+    const Request::TypeTransfer typeTransfer = req->getTypeTransfer();
+
+    idErr = ERR_NO_ERROR;
 
-            // Manage available options
-            if(m_options & FlagOption::OPT_FTP_CREATE_DIRS){
-                curl_easy_setopt(handle, CURLOPT_FTP_CREATE_MISSING_DIRS, CURLFTP_CREATE_DIR);
+    /* Manage request which succeed */
+    if(curlErr == CURLE_OK){
+        // Cached body may have been removed since its validators were sent, request must be transferred again
+        if(transfer.useCache && !manageHttpCache(&transfer)){
+            req->ioRegisterTry();
+            return true;
+        }
+
+        // Verify integrity of transferred datas
+        if(transfer.digest && !verifyDigest(*transfer.digest, req, req)){
+            if(transfer.useCache){
+                m_cacheHttp.remove(req->ioGetUrl().toString());
             }
-        }break;
 
-        default: break;
+            if(req->ioGetNbTrials() >= transfer.settings.nbMaxTrials){
+                const std::string err = StringHelper::format("Reached maximum number of trials, datas are corrupted [url: %s]", req->ioGetUrl().toString().c_str());
+                TEASE_LOG_WARN(err);
+
+                idErr = ERR_INTEGRITY;
+                return false;
+            }
+
+            req->ioRegisterTry();
+            return true;
+        }
+
+        curl_off_t nbBytes = 0;
+        curl_easy_getinfo(transfer.handle, typeTransfer == Request::TRANSFER_UPLOAD ? CURLINFO_SIZE_UPLOAD_T : CURLINFO_SIZE_DOWNLOAD_T, &nbBytes);
+        req->ioSetSizeWire(static_cast<size_t>(nbBytes));
+
+        // Directory of uploaded file now exist
+        if(typeTransfer == Request::TRANSFER_UPLOAD && (transfer.settings.options & FlagOption::OPT_FTP_CREATE_DIRS)){
+            m_cacheDirs.insert(req->ioGetUrl());
+        }
+
+        // Keep downloaded content for next requests
+        if(typeTransfer == Request::TRANSFER_DOWNLOAD && m_cacheContent.isEnabled() && !req->hasDataSink()){
+            m_cacheContent.insert(ContentStore::createKey(req->getUrl(), req->getExpectedDigest()), req->getData());
+        }
+
+        return false;
     }
 
-    /* Progress callback */
-    curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, curlCbProgress);
-    curl_easy_setopt(handle, CURLOPT_XFERINFODATA, req);
-    curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L); // Enable progress meter
+    /* Directory may have been removed from remote, let next trial create it */
+    if(typeTransfer == Request::TRANSFER_UPLOAD && (transfer.settings.options & FlagOption::OPT_FTP_CREATE_DIRS)){
+        m_cacheDirs.remove(req->ioGetUrl());
+    }
 
-    /* Manage timeouts */
-    // Maximum time allowed to connect to host
-    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, m_timeoutConnect);
+    /* Was transfer stopped because of its deadline ? */
+    if(transfer.deadline <= Request::Clock::now()){
+        const std::string err = StringHelper::format("Request deadline reached [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+        TEASE_LOG_WARN(err);
 
-    // Minimum allowed speed (if transfer rate is below the limit for the configured timeout transfer, transfer will timeout)
-    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, MIN_SPEED_LIMIT);
-    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, m_timeoutTransfer);
+        idErr = ERR_DEADLINE_EXCEEDED;
+        return false;
+    }
 
-    /* Do we need to enable verbosity debug ? */
-    if(m_options & FlagOption::OPT_VERBOSE){
-        curl_easy_setopt(handle, CURLOPT_DEBUGFUNCTION, curlCbVerbose);
-        curl_easy_setopt(handle, CURLOPT_DEBUGDATA, req);
-        curl_easy_setopt(handle, CURLOPT_VERBOSE, 1L);
+    /* Can request be transferred from another mirror ? */
+    long codeHttp = 0;
+    curl_easy_getinfo(transfer.handle, CURLINFO_RESPONSE_CODE, &codeHttp);
+
+    if(errorAllowFailover(curlErr, codeHttp) && req->ioGetNbFailovers() < static_cast<int>(req->getMirrors().size())){
+        const std::string logFailover = StringHelper::format("Failover request to next mirror [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+        req->ioFailover();
+        TEASE_LOG_INFO(logFailover);
+
+        return true;
+    }
+
+    /* Do error allow us to a retry ? */
+    if(!errorAllowRetry(curlErr, codeHttp, idErr)){
+        return false;
+    }
+
+    /* Have we reach maximal number of retry for this request ? */
+    if(req->ioGetNbTrials() >= transfer.settings.nbMaxTrials){
+        const std::string err = StringHelper::format("Reached maximum number of trials [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+        TEASE_LOG_WARN(err);
+
+        idErr = ERR_MAX_TRIALS;
+        return false;
     }
+
+    /* Prepare new trial */
+    const std::string logTrial = StringHelper::format("Perform new trial for request [url: %s, nb-trials: %d, curl-err: %d]", req->ioGetUrl().toString().c_str(), req->ioGetNbTrials(), curlErr);
+    TEASE_LOG_DEBUG(logTrial);
+
+    req->ioRegisterTry();
+    return true;
 }
 
-size_t TransferManager::Impl::curlCbWrite(char *ptr, size_t size, size_t nmemb, void *userdata)
+void TransferManager::Impl::jobPerform()
 {
-    /* Cast elements */
-    Request *req = static_cast<Request*>(userdata);
-    BytesArray::Byte *bufferData = reinterpret_cast<BytesArray::Byte*>(ptr);
+    m_idThreadTransfer = std::this_thread::get_id();
 
-    /* Fill request data */
-    const size_t bufferSize = size * nmemb;
-    req->getData().pushBack(bufferData, bufferSize);
+    /* Batch timeout covers the whole job, including control requests */
+    {
+        Locker locker(m_mutex);
 
-    return bufferSize;
+        m_deadlineBatch = Request::TimePoint::max();
+        if(m_timeoutBatch > 0){
+            m_deadlineBatch = Request::Clock::now() + std::chrono::seconds(m_timeoutBatch);
+        }
+    }
+
+    /* Inform that transfer is started */
+    m_dispatcher.postStarted(m_typeTransfer);
+
+    /* Create needed directories once, instead of letting each upload create them */
+    if(m_typeTransfer == Request::TRANSFER_UPLOAD && (m_options & FlagOption::OPT_FTP_CREATE_DIRS)){
+        createDirectories();
+    }
+
+    /* Uploads which remote ressource is already up to date are not performed (must be known before queuing requests) */
+    if(m_typeTransfer == Request::TRANSFER_UPLOAD){
+        skipUnchanged();
+    }
+
+    /* Sizes of downloads must be known before preparing progress and queues */
+    if(m_typeTransfer == Request::TRANSFER_DOWNLOAD && (m_options & FlagOption::OPT_PREFETCH_SIZES)){
+        prefetchSizes();
+    }
+
+    /* Perform transfer preparation */
+    bool succeed = transferPrepare();
+    if(!succeed){
+        registerFailure(ERR_INTERNAL);
+        goto stat_clean;
+    }
+
+    /* Perform transfer: first worker use current thread, others use dedicated threads */
+    for(size_t i = 1; i < m_nbWorkersUsed; ++i){
+        Worker &worker = *m_listWorkers[i];
+        worker.thread = std::async(std::launch::async, &Impl::transferPerform, this, std::ref(worker));
+    }
+
+    transferPerform(*m_listWorkers.front());
+
+    for(size_t i = 1; i < m_nbWorkersUsed; ++i){
+        m_listWorkers[i]->thread.wait();
+    }
+
+    /* Clean used ressources */
+stat_clean:
+    cleanHandles();
+    cleanRequests();
+
+    /* Cancelled or expired requests make the job fail, even if all other requests succeed */
+    if(m_nbReqsCancelled > 0){
+        IdError expected = ERR_NO_ERROR;
+        m_failureStatus.compare_exchange_strong(expected, ERR_USER_ABORT);
+    }
+
+    if(m_nbReqsExpired > 0){
+        IdError expected = ERR_NO_ERROR;
+        m_failureStatus.compare_exchange_strong(expected, ERR_DEADLINE_EXCEEDED);
+    }
+
+    /* Inform user about transfer status (final progress is never rate-limited) */
+    updateProgress(true);
+
+    const IdError failureStatus = m_failureStatus;
+    if(failureStatus == ERR_NO_ERROR){
+        m_dispatcher.postCompleted(m_typeTransfer);
+    }else{
+        m_dispatcher.postFailed(m_typeTransfer, failureStatus);
+    }
+
+    /* Give results to futures of submitted job */
+    resolveJob(failureStatus);
+}
+
+bool TransferManager::Impl::transferPrepare()
+{
+    /* Retrieve requests of the job and needed configuration */
+    Request::List listReqs;
+    Settings settings;
+    {
+        Locker locker(m_mutex);
+
+        listReqs = m_listReqs;
+        settings = createSettings();
+    }
+
+    /* Downloads available in content cache and skipped uploads are completed without any transfer (cache is read without holding the lock) */
+    Request::List listSorted;
+    std::vector<const Request*> listDelivered;
+    listSorted.reserve(listReqs.size());
+
+    for(const auto &req : listReqs){
+        if(!req->ioIsAbort() && (req->ioIsSkipped() || deliverFromCache(req.get(), settings))){
+            listDelivered.push_back(req.get());
+        }else{
+            listSorted.push_back(req);
+        }
+    }
+
+    Locker locker(m_mutex);
+
+    /* Reset any current handle */
+    cleanHandles();
+
+    /* Reset transfer status */
+    m_mapFollowers.clear();
+    m_nbReqsTodo = listReqs.size();
+    m_nbReqsDone = listDelivered.size();
+    m_nbReqsCancelled = 0;
+    m_nbReqsExpired = 0;
+    m_failureStatus = ERR_NO_ERROR;
+
+    /* Prepare concurrency controller */
+    m_ctrlConcurrency.configure(m_options & FlagOption::OPT_ADAPTIVE_CONCURRENCY, m_nbMaxHost);
+    m_ctrlConcurrency.resetActive();
+
+    /* Publish results of requests completed without transfer */
+    for(const Request *req : listDelivered){
+        resolveRequest(req, ERR_NO_ERROR);
+    }
+
+    m_progress.reset(listReqs);
+
+    m_throughput = 0.0;
+    m_tsProgressSample = m_tsProgressEmit = Request::Clock::now();
+    m_sizeProgressSample = m_sizeProgressEmit = m_progress.getProgress().sizeCurrent;
+
+    /* Order requests according to scheduling policy */
+    RequestScheduler::schedule(listSorted, m_scheduling);
+
+    /* Identical downloads are performed once, result is given to all of them */
+    if(m_typeTransfer == Request::TRANSFER_DOWNLOAD){
+        coalesceRequests(listSorted);
+    }
+
+    /* Prepare needed workers (no need to have more workers than requests) */
+    size_t nbWorkers = m_nbWorkers > 0 ? m_nbWorkers : std::max(1u, std::thread::hardware_concurrency());
+    nbWorkers = std::clamp<size_t>(listSorted.size(), 1, nbWorkers);
+
+    while(m_listWorkers.size() < nbWorkers){
+        PtrWorker worker = createWorker();
+        if(!worker){
+            TEASE_LOG_ERROR("Failed to initialise curl multi instance of worker");
+            return false;
+        }
+
+        m_listWorkers.push_back(std::move(worker));
+    }
+    m_nbWorkersUsed = nbWorkers;
+
+    /* Dispatch requests between workers, they will be started when allowed */
+    for(auto &worker : m_listWorkers){
+        worker->queueReqs.clear();
+    }
+
+    for(size_t i = 0; i < listSorted.size(); ++i){
+        m_listWorkers[i % m_nbWorkersUsed]->queueReqs.push_back(listSorted[i].get());
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Transfer loop of a worker
+ * \details
+ * Each worker own a multi handle and perform transfers of
+ * its queued requests. \n
+ * When a worker has no more queued requests, it will try
+ * to steal queued requests of other workers. Worker loop
+ * ends once all requests of the job are done, once an
+ * error has been detected or if there are no more requests
+ * to perform for this worker.
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ */
+void TransferManager::Impl::transferPerform(Worker &worker)
+{
+    IdError idErr = ERR_NO_ERROR;
+
+    /* Job may have been aborted while being prepared */
+    if(m_abortJob){
+        registerFailure(ERR_USER_ABORT);
+        return;
+    }
+
+    /* Start allowed requests */
+    idErr = transferAdmit(worker);
+    if(idErr != ERR_NO_ERROR){
+        registerFailure(idErr);
+        return;
+    }
+
+    /* Do first call to perform transfer */
+    bool succeed = performTransfer(worker, idErr);
+    if(!succeed){
+        registerFailure(idErr);
+        return;
+    }
+
+    /* Transfers reusing opened connections may already be completed, nothing would wake up polling */
+    idErr = manageStatus(worker);
+    if(idErr != ERR_NO_ERROR){
+        registerFailure(idErr);
+        return;
+    }
+
+    /* Perform transfer */
+    while(m_nbReqsDone < m_nbReqsTodo && m_failureStatus == ERR_NO_ERROR){
+        // Worker has no more requests queued, try to steal some from other workers
+        if(queueIsEmpty(worker) && transferSteal(worker)){
+            idErr = transferAdmit(worker);
+            if(idErr != ERR_NO_ERROR){
+                registerFailure(idErr);
+                return;
+            }
+        }
+
+        // Nothing more to do for this worker
+        if(worker.listTransfers.empty() && queueIsEmpty(worker)){
+            return;
+        }
+
+        // Perform polling
+        curl_multi_poll(worker.handleMulti, nullptr, 0, getPollTimeout(), nullptr);
+        succeed = performTransfer(worker, idErr);
+        if(!succeed){
+            registerFailure(idErr);
+            return;
+        }
+
+        // Update progress
+        updateProgress();
+
+        // Remove cancelled requests
+        idErr = manageCancellations(worker);
+        if(idErr != ERR_NO_ERROR){
+            registerFailure(idErr);
+            return;
+        }
+
+        // Pause or resume requests
+        idErr = managePauses(worker);
+        if(idErr != ERR_NO_ERROR){
+            registerFailure(idErr);
+            return;
+        }
+
+        // Manage status
+        idErr = manageStatus(worker);
+        if(idErr != ERR_NO_ERROR){
+            registerFailure(idErr);
+            return;
+        }
+
+        // Manage deadlines
+        idErr = manageDeadlines(worker);
+        if(idErr != ERR_NO_ERROR){
+            registerFailure(idErr);
+            return;
+        }
+
+        // Manage slow requests
+        manageHedging(worker);
+    }
+}
+
+/*!
+ * \brief Use to start queued requests allowed
+ * by the concurrency controller
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ *
+ * Cancelled requests and requests which deadline has
+ * been reached are completed without being started,
+ * paused requests stay queued.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_DEADLINE_EXCEEDED if
+ * batch deadline has been reached, \c TransferManager::ERR_INTERNAL
+ * if failed to create handle.
+ */
+TransferManager::IdError TransferManager::Impl::transferAdmit(Worker &worker)
+{
+    const Request::TimePoint now = Request::Clock::now();
+    if(m_deadlineBatch <= now){
+        TEASE_LOG_WARN("Batch timeout reached before all transfers could start");
+        return ERR_DEADLINE_EXCEEDED;
+    }
+
+    std::vector<Request*> listCancelled, listExpired;
+    {
+        Locker locker(worker.mutexQueue);
+
+        for(auto it = worker.queueReqs.begin(); it != worker.queueReqs.end();){
+            // Was request cancelled while queued ?
+            Request *req = *it;
+            if(req->ioIsAbort()){
+                listCancelled.push_back(req);
+                it = worker.queueReqs.erase(it);
+                continue;
+            }
+
+            // Can request still be completed in time ?
+            if(req->getDeadline() <= now){
+                const std::string err = StringHelper::format("Request deadline reached before transfer could start [url: %s]", req->ioGetUrl().toString().c_str());
+                TEASE_LOG_WARN(err);
+
+                listExpired.push_back(req);
+                it = worker.queueReqs.erase(it);
+                continue;
+            }
+
+            // Is request allowed to be started ?
+            if(m_pauseJob || req->ioIsPaused()){
+                ++it;
+                continue;
+            }
+
+            // Is host able to accept a new transfer ?
+            if(!acquireHost(req)){
+                ++it;
+                continue;
+            }
+
+            // Start transfer
+            Transfer *transfer = createTransfer(worker, req, req);
+            if(!transfer){
+                m_ctrlConcurrency.release(req->ioGetUrl().getHost());
+                return ERR_INTERNAL;
+            }
+
+            it = worker.queueReqs.erase(it);
+        }
+    }
+
+    /* Identical downloads waiting for a cancelled or expired request have been queued, they must be started too */
+    bool hasQueued = false;
+    for(Request *req : listCancelled){
+        hasQueued |= completeCancelled(worker, req);
+    }
+    for(Request *req : listExpired){
+        hasQueued |= completeExpired(worker, req);
+    }
+
+    return hasQueued ? transferAdmit(worker) : ERR_NO_ERROR;
+}
+
+/*!
+ * \brief Use to remove transfers of cancelled
+ * requests from the transfer loop
+ * \details
+ * Nothing is performed until a request is cancelled,
+ * requests are flagged with atomic flags so that running
+ * transfers don't need any lock to be verified.
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_USER_ABORT if the whole job
+ * has been aborted, otherwise error of transfers admission.
+ *
+ * \sa cancelRequests(), abortJob()
+ */
+TransferManager::IdError TransferManager::Impl::manageCancellations(Worker &worker)
+{
+    if(m_abortJob){
+        return ERR_USER_ABORT;
+    }
+
+    /* Do requests have been cancelled since last verification ? */
+    const int generation = m_cancelsGeneration;
+    if(worker.cancelsSeen == generation){
+        return ERR_NO_ERROR;
+    }
+    worker.cancelsSeen = generation;
+
+    /* Remove running transfers right away (scan is restarted after each removal since transfers are reordered) */
+    std::vector<Request*> listCancelled;
+    for(size_t i = 0; i < worker.listTransfers.size();){
+        Transfer *transfer = worker.listTransfers[i].get();
+        if(!transfer->reqOrigin->ioIsAbort()){
+            ++i;
+            continue;
+        }
+
+        listCancelled.push_back(transfer->reqOrigin);
+        if(transfer->twin){
+            releaseTransfer(worker, transfer->twin);
+        }
+        releaseTransfer(worker, transfer);
+        i = 0;
+    }
+
+    for(Request *req : listCancelled){
+        completeCancelled(worker, req);
+    }
+
+    /* Start queued requests on released slots (queued cancelled requests are completed at admission) */
+    const IdError idErr = transferAdmit(worker);
+    if(!listCancelled.empty()){
+        wakeUpWorkers(&worker);
+    }
+
+    return idErr;
+}
+
+/*!
+ * \brief Use to apply pause state of requests
+ * to running transfers
+ * \details
+ * Nothing is performed until a request is paused or
+ * resumed. Transfers are paused with curl pause mechanism:
+ * connection is kept open and no more datas are received
+ * nor sent. \n
+ * Transfers paused by their data sink (see Request::setDataSink())
+ * are already paused, datas they refused are given again
+ * when resumed.
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ *
+ * \return
+ * Returns error of transfers admission.
+ *
+ * \sa pauseRequests(), pauseJob()
+ */
+TransferManager::IdError TransferManager::Impl::managePauses(Worker &worker)
+{
+    /* Do requests have been paused or resumed since last verification ? */
+    const int generation = m_pausesGeneration;
+    if(worker.pausesSeen == generation){
+        return ERR_NO_ERROR;
+    }
+    worker.pausesSeen = generation;
+
+    /* Apply state to running transfers */
+    for(const auto &transfer : worker.listTransfers){
+        const bool paused = m_pauseJob || transfer->reqOrigin->ioIsPaused();
+        if(paused == transfer->isPaused){
+            continue;
+        }
+
+        // Resumed transfer may be paused again right away by its data sink
+        transfer->isPaused = paused;
+        transfer->wasPaused = true;
+
+        const CURLcode curlErr = curl_easy_pause(transfer->handle, paused ? CURLPAUSE_ALL : CURLPAUSE_CONT);
+        if(curlErr != CURLE_OK){
+            const std::string err = StringHelper::format("Unable to change pause state of transfer [url: %s, paused: %d, curl-err: %d]", transfer->req->ioGetUrl().toString().c_str(), paused, curlErr);
+            TEASE_LOG_WARN(err);
+        }
+    }
+
+    /* Start resumed queued requests */
+    return transferAdmit(worker);
+}
+
+/*!
+ * \brief Use to complete a cancelled request
+ * \details
+ * Other requests of the job are still performed. Identical
+ * downloads waiting for the result of this request (see
+ * coalesceRequests()) are given to a new leader (see queueFollowers()).
+ *
+ * \param[in, out] worker
+ * Worker which performed the request.
+ * \param[in] req
+ * Cancelled request, it must not belong to any
+ * queue nor transfer.
+ *
+ * \return
+ * Returns \c true if identical downloads have been queued.
+ */
+bool TransferManager::Impl::completeCancelled(Worker &worker, Request *req)
+{
+    const std::string log = StringHelper::format("Request cancelled [url: %s]", req->ioGetUrl().toString().c_str());
+    TEASE_LOG_INFO(log);
+
+    ++m_nbReqsCancelled;
+    ++m_nbReqsDone;
+    resolveRequest(req, ERR_USER_ABORT);
+
+    return queueFollowers(worker, req);
+}
+
+/*!
+ * \brief Use to complete a request which
+ * can't meet its own deadline
+ * \details
+ * Other requests of the job are still performed, job will
+ * fail with \c TransferManager::ERR_DEADLINE_EXCEEDED once
+ * done. Identical downloads waiting for the result of this
+ * request are given to a new leader (its own deadline is
+ * verified when started).
+ *
+ * \param[in, out] worker
+ * Worker which performed the request.
+ * \param[in] req
+ * Expired request, it must not belong to any
+ * queue nor transfer.
+ *
+ * \return
+ * Returns \c true if identical downloads have been queued.
+ *
+ * \sa completeCancelled()
+ */
+bool TransferManager::Impl::completeExpired(Worker &worker, Request *req)
+{
+    ++m_nbReqsExpired;
+    ++m_nbReqsDone;
+    resolveRequest(req, ERR_DEADLINE_EXCEEDED);
+
+    return queueFollowers(worker, req);
+}
+
+/*!
+ * \brief Use to queue identical downloads which
+ * were waiting for the result of a request
+ * \details
+ * First follower which isn't cancelled becomes the
+ * new leader: it is queued, others wait for its result. \n
+ * When all followers are cancelled, they are all queued
+ * to be completed as such.
+ *
+ * \param[in, out] worker
+ * Worker which will perform them.
+ * \param[in] req
+ * Request which didn't succeed.
+ *
+ * \return
+ * Returns \c true if identical downloads have been queued.
+ *
+ * \sa coalesceRequests()
+ */
+bool TransferManager::Impl::queueFollowers(Worker &worker, const Request *req)
+{
+    std::vector<Request*> listQueued;
+    {
+        Locker locker(m_mutexFollowers);
+
+        auto it = m_mapFollowers.find(req);
+        if(it == m_mapFollowers.end() || it->second.empty()){
+            return false;
+        }
+
+        listQueued = std::move(it->second);
+        m_mapFollowers.erase(it);
+
+        auto itLeader = std::find_if(listQueued.begin(), listQueued.end(), [](const Request *follower){ return !follower->ioIsAbort(); });
+        if(itLeader != listQueued.end()){
+            Request *leader = *itLeader;
+            listQueued.erase(itLeader);
+
+            if(!listQueued.empty()){
+                m_mapFollowers[leader] = std::move(listQueued);
+            }
+            listQueued = {leader};
+        }
+    }
+
+    Locker locker(worker.mutexQueue);
+    worker.queueReqs.insert(worker.queueReqs.end(), listQueued.cbegin(), listQueued.cend());
+
+    return true;
+}
+
+/*!
+ * \brief Use to steal queued requests from
+ * the most loaded worker
+ * \details
+ * Half of the queued requests of the worker
+ * having the biggest queue will be moved.
+ *
+ * \param[in, out] worker
+ * Worker which will receive stolen requests.
+ *
+ * \return
+ * Returns \c true if requests have been stolen.
+ */
+bool TransferManager::Impl::transferSteal(Worker &worker)
+{
+    /* Search most loaded worker */
+    Worker *victim = nullptr;
+    size_t victimSize = 0;
+
+    for(size_t i = 0; i < m_nbWorkersUsed; ++i){
+        Worker *candidate = m_listWorkers[i].get();
+        if(candidate == &worker){
+            continue;
+        }
+
+        Locker locker(candidate->mutexQueue);
+        if(candidate->queueReqs.size() > victimSize){
+            victim = candidate;
+            victimSize = candidate->queueReqs.size();
+        }
+    }
+
+    if(!victim){
+        return false;
+    }
+
+    /* Steal half of its queue (from the back, victim use the front) */
+    std::deque<Request*> stolen;
+    {
+        Locker locker(victim->mutexQueue);
+
+        const size_t nbToSteal = (victim->queueReqs.size() + 1) / 2;
+        for(size_t i = 0; i < nbToSteal; ++i){
+            stolen.push_front(victim->queueReqs.back());
+            victim->queueReqs.pop_back();
+        }
+    }
+
+    if(stolen.empty()){
+        return false;
+    }
+
+    Locker locker(worker.mutexQueue);
+    worker.queueReqs.insert(worker.queueReqs.end(), stolen.cbegin(), stolen.cend());
+
+    return true;
+}
+
+bool TransferManager::Impl::performTransfer(Worker &worker, IdError &idErr)
+{
+    int nbReqsRunning;
+
+    CURLMcode curlErr = curl_multi_perform(worker.handleMulti, &nbReqsRunning);
+    if(curlErr != CURLM_OK){
+        idErr = ERR_INTERNAL;
+
+        const std::string err = StringHelper::format("Error when trying to perform on multi handle [curl-err: %d]", curlErr);
+        TEASE_LOG_ERROR(err);
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to update smoothed throughput and
+ * inform user about job progress
+ * \details
+ * Progress events are rate-limited according to
+ * setProgressInterval().
+ *
+ * \param[in] force
+ * Set to \c true to inform user whatever the
+ * elapsed time and transferred bytes since
+ * previous event.
+ */
+void TransferManager::Impl::updateProgress(bool force)
+{
+    /* Only one worker need to inform user at a time */
+    std::unique_lock<std::mutex> locker(m_mutexProgress, std::defer_lock);
+    if(force){
+        locker.lock();
+    }else if(!locker.try_lock()){
+        return;
+    }
+
+    /* Job progress is maintained by each size update, no need to browse requests */
+    const Progress progressSizes = m_progress.getProgress();
+    const Request::TimePoint tsNow = Request::Clock::now();
+
+    /* Update throughput: time based factor keeps average independent of sampling rate */
+    const double elapsed = std::chrono::duration<double>(tsNow - m_tsProgressSample).count();
+    if(elapsed >= PROGRESS_SAMPLE_PERIOD || (force && elapsed > 0.0)){
+        const size_t sizeDelta = progressSizes.sizeCurrent > m_sizeProgressSample ? progressSizes.sizeCurrent - m_sizeProgressSample : 0;
+        const double rate = static_cast<double>(sizeDelta) / elapsed;
+        const double alpha = 1.0 - std::exp(-elapsed / PROGRESS_EWMA_PERIOD);
+
+        const double throughput = m_throughput;
+        m_throughput = (throughput <= 0.0) ? rate : throughput + alpha * (rate - throughput);
+
+        m_tsProgressSample = tsNow;
+        m_sizeProgressSample = progressSizes.sizeCurrent;
+    }
+
+    /* Coalesce events which are too close */
+    if(!force){
+        const long elapsedEmit = std::chrono::duration_cast<std::chrono::milliseconds>(tsNow - m_tsProgressEmit).count();
+        const size_t sizeEmit = progressSizes.sizeCurrent > m_sizeProgressEmit ? progressSizes.sizeCurrent - m_sizeProgressEmit : 0;
+        if(elapsedEmit < m_progressInterval || sizeEmit < m_progressThreshold){
+            return;
+        }
+    }
+
+    m_tsProgressEmit = tsNow;
+    m_sizeProgressEmit = progressSizes.sizeCurrent;
+
+    /* Inform user */
+    m_dispatcher.postProgress(m_typeTransfer, createProgress());
+}
+
+/*!
+ * \brief Use to build current job progress
+ * \details
+ * Built from lock-free values, so it can be
+ * called from any thread.
+ *
+ * \return
+ * Returns job progress.
+ */
+TransferManager::Progress TransferManager::Impl::createProgress() const
+{
+    Progress progress = m_progress.getProgress();
+
+    const int nbTodo = m_nbReqsTodo;
+    const int nbDone = m_nbReqsDone;
+    const int nbActive = m_nbReqsActive;
+
+    progress.nbActive = std::max(0, nbActive);
+    progress.nbCompleted = std::max(0, nbDone);
+    progress.nbQueued = std::max(0, nbTodo - nbDone - nbActive);
+
+    progress.throughput = m_throughput;
+    progress.eta = -1.0;
+    if(progress.sizeCurrent >= progress.sizeTotal && progress.nbCompleted >= static_cast<size_t>(std::max(0, nbTodo))){
+        progress.eta = 0.0;
+    }else if(progress.throughput > 0.0){
+        progress.eta = static_cast<double>(progress.sizeTotal - progress.sizeCurrent) / progress.throughput;
+    }
+
+    return progress;
+}
+
+TransferManager::IdError TransferManager::Impl::manageStatus(Worker &worker)
+{
+    IdError idErr = ERR_NO_ERROR;
+    CURLMsg *msg = nullptr;
+    int nbMsgLeft = 0;
+    bool hasReleased = false;
+
+    /* Manage status of each request */
+    while((msg = curl_multi_info_read(worker.handleMulti, &nbMsgLeft))){
+        // Do we already have detected an error ?
+        if(idErr != ERR_NO_ERROR){
+            continue; // Curl doesn't allow to clean internal messages queue, so before returning because an error was detected, we have to iterate through every messages
+        }
+
+        // Ignore request not finished
+        if(msg->msg != CURLMSG_DONE){
+            continue; // Read status of next request
+        }
+
+        // Retrieve current request informations
+        CURL *handle = msg->easy_handle;
+        Transfer *transfer = nullptr;
+        curl_easy_getinfo(handle, CURLINFO_PRIVATE, &transfer);
+
+        Request *req = transfer->reqOrigin;
+        const std::string host = transfer->host;
+
+        // Count requests which succeed
+        const CURLcode curlErr = msg->data.result;
+        if(curlErr == CURLE_OK){
+            // Cached body may have been removed since its validators were sent, request must be transferred again
+            if(transfer->useCache && !manageHttpCache(transfer)){
+                if(transfer->twin){
+                    releaseTransfer(worker, transfer->twin);
+                }
+
+                m_progress.remove(*req);
+                req->ioRegisterTry();
+
+                releaseTransfer(worker, transfer);
+                hasReleased = true;
+
+                Locker locker(worker.mutexQueue);
+                worker.queueReqs.push_front(req);
+                continue;
+            }
+
+            // Verify integrity of transferred datas
+            if(transfer->digest && !verifyDigest(*transfer->digest, transfer->req, req)){
+                m_ctrlConcurrency.registerFailure(host);
+                if(transfer->useCache){
+                    m_cacheHttp.remove(req->ioGetUrl().toString());
+                }
+
+                // Hedging counterpart is still running, let it complete the request
+                if(transfer->twin){
+                    transfer->twin->twin = nullptr;
+
+                    releaseTransfer(worker, transfer);
+                    hasReleased = true;
+                    continue;
+                }
+
+                if(req->ioGetNbTrials() >= m_nbMaxTrials){
+                    const std::string err = StringHelper::format("Reached maximum number of trials, datas are corrupted [url: %s]", req->ioGetUrl().toString().c_str());
+                    TEASE_LOG_WARN(err);
+
+                    idErr = ERR_INTEGRITY;
+                    continue;
+                }
+
+                m_progress.remove(*req);
+                req->ioRegisterTry();
+
+                releaseTransfer(worker, transfer);
+                hasReleased = true;
+
+                Locker locker(worker.mutexQueue);
+                worker.queueReqs.push_front(req);
+                continue;
+            }
+
+            curl_off_t timeFirstByte = 0, timeTotal = 0, nbBytes = 0;
+            curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME_T, &timeFirstByte);
+            curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME_T, &timeTotal);
+            curl_easy_getinfo(handle, m_typeTransfer == Request::TRANSFER_UPLOAD ? CURLINFO_SIZE_UPLOAD_T : CURLINFO_SIZE_DOWNLOAD_T, &nbBytes);
+
+            m_ctrlConcurrency.registerSuccess(host, timeFirstByte / 1e6, timeTotal / 1e6, static_cast<size_t>(nbBytes));
+            transfer->req->ioSetSizeWire(static_cast<size_t>(nbBytes));
+            if(!transfer->wasPaused){
+                m_latFirstByte.addSample(timeFirstByte / 1e6);
+                m_latCompletion.addSample(timeTotal / 1e6);
+            }
+
+            // Directory of uploaded file now exist
+            if(m_typeTransfer == Request::TRANSFER_UPLOAD && (m_options & FlagOption::OPT_FTP_CREATE_DIRS)){
+                m_cacheDirs.insert(req->ioGetUrl());
+            }
+
+            // Hedged transfer won, keep its datas and cancel its twin
+            if(transfer->reqHedge){
+                req->getData() = std::move(transfer->reqHedge->getData());
+                m_progress.update(*req, transfer->reqHedge->ioGetSizeTotal(), transfer->reqHedge->ioGetSizeCurrent());
+                req->ioSetSizeWire(transfer->reqHedge->ioGetSizeWire());
+                req->ioSetDigest(transfer->reqHedge->ioGetDigest());
+            }
+
+            if(transfer->twin){
+                releaseTransfer(worker, transfer->twin);
+            }
+
+            // Give result to identical downloads
+            completeFollowers(req);
+
+            // Keep downloaded content for next jobs
+            if(m_typeTransfer == Request::TRANSFER_DOWNLOAD && m_cacheContent.isEnabled() && !req->hasDataSink()){
+                m_cacheContent.insert(ContentStore::createKey(req->getUrl(), req->getExpectedDigest()), req->getData());
+            }
+
+            releaseTransfer(worker, transfer);
+            hasReleased = true;
+
+            ++m_nbReqsDone;
+            resolveRequest(req, ERR_NO_ERROR);
+            continue;
+        }
+
+        // Request cancelled, other requests are still performed
+        if(req->ioIsAbort()){
+            if(transfer->twin){
+                releaseTransfer(worker, transfer->twin);
+            }
+
+            releaseTransfer(worker, transfer);
+            hasReleased = true;
+
+            completeCancelled(worker, req);
+            continue;
+        }
+
+        m_ctrlConcurrency.registerFailure(host);
+
+        // Directory may have been removed from remote, let next trial create it
+        if(m_typeTransfer == Request::TRANSFER_UPLOAD && (m_options & FlagOption::OPT_FTP_CREATE_DIRS)){
+            m_cacheDirs.remove(req->ioGetUrl());
+        }
+
+        // Hedging counterpart is still running, let it complete the request
+        if(transfer->twin){
+            transfer->twin->twin = nullptr;
+
+            releaseTransfer(worker, transfer);
+            hasReleased = true;
+            continue;
+        }
+
+        // Was transfer stopped because of the batch deadline ?
+        const Request::TimePoint now = Request::Clock::now();
+        if(m_deadlineBatch <= now){
+            const std::string err = StringHelper::format("Batch timeout reached [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+            TEASE_LOG_WARN(err);
+
+            idErr = ERR_DEADLINE_EXCEEDED;
+            continue;
+        }
+
+        // Was transfer stopped because of its own deadline ? Other requests are still performed
+        if(req->getDeadline() <= now){
+            const std::string err = StringHelper::format("Request deadline reached [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+            TEASE_LOG_WARN(err);
+
+            releaseTransfer(worker, transfer);
+            hasReleased = true;
+
+            completeExpired(worker, req);
+            continue;
+        }
+
+        // Can request be transferred from another mirror ?
+        long codeHttp = 0;
+        curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &codeHttp);
+
+        if(errorAllowFailover(curlErr, codeHttp) && req->ioGetNbFailovers() < static_cast<int>(req->getMirrors().size())){
+            releaseTransfer(worker, transfer);
+            hasReleased = true;
+
+            const std::string logFailover = StringHelper::format("Failover request to next mirror [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+            m_progress.remove(*req);
+            req->ioFailover();
+            TEASE_LOG_INFO(logFailover);
+
+            Locker locker(worker.mutexQueue);
+            worker.queueReqs.push_front(req);
+            continue;
+        }
+
+        // Do error allow us to a retry ? */
+        const bool retryAllowed = errorAllowRetry(curlErr, codeHttp, idErr);
+        if(!retryAllowed){
+            continue; // We have detected an error, so now we just need to clean remaining messages
+        }
+
+        // Have we reach maximal number of retry for this request ?
+        if(req->ioGetNbTrials() >= m_nbMaxTrials){
+            const std::string err = StringHelper::format("Reached maximum number of trials [url: %s, curl-err: %d]", req->ioGetUrl().toString().c_str(), curlErr);
+            TEASE_LOG_WARN(err);
+
+            idErr = ERR_MAX_TRIALS;
+            continue;
+        }
+
+        // Prepare new trial for current request
+        const std::string logTrial = StringHelper::format("Perform new trial for request [url: %s, nb-trials: %d, curl-err: %d]", req->ioGetUrl().toString().c_str(), req->ioGetNbTrials(), curlErr);
+        TEASE_LOG_DEBUG(logTrial);
+
+        m_progress.remove(*req);
+        req->ioRegisterTry();
+
+        releaseTransfer(worker, transfer);
+        hasReleased = true;
+
+        Locker locker(worker.mutexQueue);
+        worker.queueReqs.push_front(req);
+    }
+
+    /* Start queued requests on released slots */
+    if(idErr == ERR_NO_ERROR && hasReleased){
+        idErr = transferAdmit(worker);
+
+        // Other workers may wait for a slot on same host
+        wakeUpWorkers(&worker);
+    }
+
+    return idErr;
+}
+
+/*!
+ * \brief Use to verify that running requests
+ * can meet their deadline
+ * \details
+ * Curl will stop transfers once deadline is reached, but
+ * this method allow to fail earlier: when remaining
+ * datas can't be transferred in time at current average
+ * speed, there is no need to wait for the deadline. \n
+ * A request which can't meet its own deadline is completed
+ * with \c TransferManager::ERR_DEADLINE_EXCEEDED, other requests
+ * are still performed. Only the batch deadline stops the job.
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_DEADLINE_EXCEEDED if
+ * batch deadline can't be met, otherwise error of
+ * transfers admission.
+ */
+TransferManager::IdError TransferManager::Impl::manageDeadlines(Worker &worker)
+{
+    /* Verify batch deadline (queued requests are verified when started) */
+    const Request::TimePoint now = Request::Clock::now();
+    if(m_deadlineBatch <= now){
+        TEASE_LOG_WARN("Batch timeout reached");
+        return ERR_DEADLINE_EXCEEDED;
+    }
+
+    /* Estimate completion time of running requests */
+    std::vector<Transfer*> listExpired;
+    for(const auto &transfer : worker.listTransfers){
+        CURL *handle = transfer->handle;
+        const Request *req = transfer->req;
+
+        const Request::TimePoint deadline = getDeadline(transfer->reqOrigin);
+        if(deadline == Request::TimePoint::max() || req->ioGetSizeTotal() == 0){
+            continue;
+        }
+
+        // Speed of paused transfers is not relevant
+        if(transfer->isPaused){
+            continue;
+        }
+
+        // Wait for enough transfer time to have a relevant speed
+        curl_off_t elapsed = 0, speed = 0;
+        curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME_T, &elapsed);
+        curl_easy_getinfo(handle, m_typeTransfer == Request::TRANSFER_UPLOAD ? CURLINFO_SPEED_UPLOAD_T : CURLINFO_SPEED_DOWNLOAD_T, &speed);
+        if(elapsed / 1e6 < MIN_DEADLINE_ESTIMATE || speed <= 0){
+            continue;
+        }
+
+        // Verify estimated completion time (compared in seconds, estimate may not fit into clock duration)
+        const size_t remaining = req->ioGetSizeTotal() - std::min(req->ioGetSizeTotal(), req->ioGetSizeCurrent());
+        const double estimate = static_cast<double>(remaining) / speed;
+        const double available = std::chrono::duration<double>(deadline - now).count();
+        if(estimate <= available){
+            continue;
+        }
+
+        if(deadline == m_deadlineBatch){
+            const std::string err = StringHelper::format("Batch can't meet its deadline at current speed [url: %s, remaining: %zu, speed: %lld]", req->ioGetUrl().toString().c_str(), remaining, static_cast<long long>(speed));
+            TEASE_LOG_WARN(err);
+            return ERR_DEADLINE_EXCEEDED;
+        }
+
+        const std::string err = StringHelper::format("Request can't meet its deadline at current speed [url: %s, remaining: %zu, speed: %lld]", req->ioGetUrl().toString().c_str(), remaining, static_cast<long long>(speed));
+        TEASE_LOG_WARN(err);
+
+        // Hedged counterpart may have already been selected
+        const bool isListed = std::any_of(listExpired.cbegin(), listExpired.cend(), [&transfer](const Transfer *expired){
+            return expired->reqOrigin == transfer->reqOrigin;
+        });
+        if(!isListed){
+            listExpired.push_back(transfer.get());
+        }
+    }
+
+    if(listExpired.empty()){
+        return ERR_NO_ERROR;
+    }
+
+    /* Complete expired requests (transfers are released afterwards since list is reordered) */
+    for(Transfer *transfer : listExpired){
+        Request *req = transfer->reqOrigin;
+        if(transfer->twin){
+            releaseTransfer(worker, transfer->twin);
+        }
+        releaseTransfer(worker, transfer);
+
+        completeExpired(worker, req);
+    }
+
+    /* Start queued requests on released slots */
+    const IdError idErr = transferAdmit(worker);
+    wakeUpWorkers(&worker);
+
+    return idErr;
+}
+
+/*!
+ * \brief Use to duplicate slowest running requests
+ * \details
+ * Once enough latencies have been observed, running requests
+ * slower than the configured percentile are duplicated (only once). \n
+ * Datas of the duplicated request are stored into a dedicated request,
+ * first transfer to complete will be kept, see manageStatus().
+ *
+ * \param[in, out] worker
+ * Worker to use.
+ *
+ * \sa TransferManager::setHedgingPolicy()
+ */
+void TransferManager::Impl::manageHedging(Worker &worker)
+{
+    /* Hedging is only available for downloads (duplicated uploads could corrupt remote ressources) */
+    if(m_hedgingPolicy == HEDGING_DISABLED || m_typeTransfer != Request::TRANSFER_DOWNLOAD){
+        return;
+    }
+
+    /* Do we have observed enough requests ? */
+    const bool useFirstByte = (m_hedgingPolicy == HEDGING_FIRST_BYTE);
+    const LatencyTracker &tracker = useFirstByte ? m_latFirstByte : m_latCompletion;
+    if(tracker.getNbSamples() < HEDGING_NB_SAMPLES_MIN){
+        return;
+    }
+
+    const std::chrono::duration<double> threshold(tracker.getPercentile(m_hedgingPercentile));
+    const Request::TimePoint now = Request::Clock::now();
+
+    /* Duplicate slow requests (list will grow with hedged transfers, those must not be parsed) */
+    const size_t nbTransfers = worker.listTransfers.size();
+    for(size_t i = 0; i < nbTransfers; ++i){
+        Transfer *transfer = worker.listTransfers[i].get();
+
+        // Verify that request has not been already hedged
+        if(transfer->twin || transfer->reqHedge){
+            continue;
+        }
+
+        // Paused requests are not slow, and datas given to a sink can't be duplicated
+        if(transfer->wasPaused || transfer->req->hasDataSink()){
+            continue;
+        }
+
+        // Verify that request is slow
+        if(useFirstByte && transfer->req->ioGetSizeCurrent() > 0){
+            continue;
+        }
+
+        if(now - transfer->tsStart < threshold){
+            continue;
+        }
+
+        // Start duplicated transfer if host allow it
+        Request *req = transfer->reqOrigin;
+        if(!m_ctrlConcurrency.tryAcquire(req->ioGetUrl().getHost())){
+            continue;
+        }
+
+        Request::PtrShared reqHedge = std::make_shared<Request>();
+        reqHedge->configureDownload(req->ioGetUrl());
+        reqHedge->ioSetSizeExpected(req->ioGetSizeExpected());
+
+        Transfer *hedge = createTransfer(worker, reqHedge.get(), req);
+        if(!hedge){
+            m_ctrlConcurrency.release(req->ioGetUrl().getHost());
+            continue;
+        }
+
+        hedge->reqHedge = reqHedge;
+        hedge->twin = transfer;
+        transfer->twin = hedge;
+
+        const std::string log = StringHelper::format("Start hedged transfer for slow request [url: %s, threshold: %.3f s]", req->ioGetUrl().toString().c_str(), threshold.count());
+        TEASE_LOG_DEBUG(log);
+    }
+}
+
+/*!
+ * \brief Use to retrieve how long workers can wait
+ * for network events
+ * \details
+ * When hedging is active, slow requests must be detected
+ * as soon as they exceed the hedging threshold, which is
+ * usually much lower than default polling timeout.
+ *
+ * \return
+ * Returns polling timeout in milliseconds.
+ */
+int TransferManager::Impl::getPollTimeout() const
+{
+    if(m_hedgingPolicy == HEDGING_DISABLED || m_typeTransfer != Request::TRANSFER_DOWNLOAD){
+        return POLL_TIMEOUT;
+    }
+
+    const LatencyTracker &tracker = (m_hedgingPolicy == HEDGING_FIRST_BYTE) ? m_latFirstByte : m_latCompletion;
+    if(tracker.getNbSamples() < HEDGING_NB_SAMPLES_MIN){
+        return POLL_TIMEOUT;
+    }
+
+    const double threshold = tracker.getPercentile(m_hedgingPercentile) * 1000.0;
+    return static_cast<int>(std::clamp(threshold, static_cast<double>(HEDGING_POLL_MIN), static_cast<double>(POLL_TIMEOUT)));
+}
+
+/*!
+ * \brief Use to know if a transfer error may
+ * not happen on a new trial
+ *
+ * \param[in] curlErr
+ * Curl error to parse.
+ * \param[in] codeHttp
+ * Last HTTP response code, only used when \c curlErr
+ * is \c CURLE_HTTP_RETURNED_ERROR.
+ * \param[out] idErr
+ * Error of the request when no new trial is allowed.
+ *
+ * \return
+ * Returns \c true if request can be transferred again.
+ */
+bool TransferManager::Impl::errorAllowRetry(CURLcode curlErr, long codeHttp, IdError &idErr)
+{
+    /* Client errors will happen again, except when server asked to wait */
+    if(curlErr == CURLE_HTTP_RETURNED_ERROR){
+        switch(codeHttp)
+        {
+            case 404:
+            case 410: idErr = ERR_CONTENT_NOT_FOUND;    break;
+            case 401:
+            case 403: idErr = ERR_INVALID_LOGIN;        break;
+            case 507: idErr = ERR_MEMORY_FULL_REMOTE;   break;
+
+            case 408:
+            case 429: return true;
+
+            default:{
+                if(codeHttp >= 500){
+                    return true;
+                }
+
+                idErr = ERR_INVALID_REQUEST;
+            }break;
+        }
+
+        const std::string err = StringHelper::format("Received HTTP error which doesn't allow new trial [code-http: %ld]", codeHttp);
+        TEASE_LOG_WARN(err);
+
+        return false;
+    }
+
+    switch(curlErr)
+    {
+        case CURLE_UNSUPPORTED_PROTOCOL:
+        case CURLE_NOT_BUILT_IN:
+        case CURLE_OUT_OF_MEMORY:{
+            const std::string err = StringHelper::format("Received internal error which require attention [curl-err: %d]", curlErr);
+            TEASE_LOG_FATAL(err);
+
+            idErr = ERR_INTERNAL;
+        }break;
+
+        case CURLE_REMOTE_DISK_FULL:        idErr = ERR_MEMORY_FULL_REMOTE; break;
+        case CURLE_URL_MALFORMAT:           idErr = ERR_INVALID_REQUEST;    break;
+        case CURLE_REMOTE_FILE_NOT_FOUND:   idErr = ERR_CONTENT_NOT_FOUND;  break;
+        case CURLE_LOGIN_DENIED:            idErr = ERR_INVALID_LOGIN;      break;
+        case CURLE_ABORTED_BY_CALLBACK:     idErr = ERR_USER_ABORT;         break;
+
+        default:{
+            return true; // Any other errors allow to perform new try
+        }break;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Use to know if a transfer error may
+ * not happen on another mirror
+ *
+ * \param[in] curlErr
+ * Curl error to parse.
+ * \param[in] codeHttp
+ * Last HTTP response code, only used when \c curlErr
+ * is \c CURLE_HTTP_RETURNED_ERROR: only server errors
+ * (\c 5xx) allow to use another mirror.
+ *
+ * \return
+ * Returns \c true if request can be transferred
+ * again from another mirror.
+ */
+bool TransferManager::Impl::errorAllowFailover(CURLcode curlErr, long codeHttp) const
+{
+    if(curlErr == CURLE_HTTP_RETURNED_ERROR){
+        return codeHttp >= 500;
+    }
+
+    switch(curlErr)
+    {
+        case CURLE_UNSUPPORTED_PROTOCOL:
+        case CURLE_NOT_BUILT_IN:
+        case CURLE_OUT_OF_MEMORY:
+        case CURLE_URL_MALFORMAT:
+        case CURLE_ABORTED_BY_CALLBACK: return false;
+
+        default: break;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to register job failure
+ * \details
+ * Only first registered error will be kept, all
+ * workers are then stopped.
+ *
+ * \param[in] idErr
+ * Error to register.
+ */
+void TransferManager::Impl::registerFailure(IdError idErr)
+{
+    IdError expected = ERR_NO_ERROR;
+    m_failureStatus.compare_exchange_strong(expected, idErr);
+
+    wakeUpWorkers();
+}
+
+/*!
+ * \brief Use to give result of a request to
+ * its futures
+ * \details
+ * Nothing is performed if request doesn't belong to
+ * a submitted job or if its result is already set.
+ *
+ * \param[in] req
+ * Request of the job.
+ * \param[in] idErr
+ * Result of the request.
+ *
+ * \warning
+ * A request must not be resolved concurrently.
+ *
+ * \sa jobSubmit()
+ */
+void TransferManager::Impl::resolveRequest(const Request *req, IdError idErr)
+{
+    auto it = m_mapResults.find(req);
+    if(it == m_mapResults.end() || it->second.isSet){
+        return;
+    }
+
+    it->second.isSet = true;
+    for(auto &promise : it->second.listPromises){
+        promise.set_value(idErr);
+    }
+}
+
+/*!
+ * \brief Use to give result of the job to
+ * its futures
+ * \details
+ * Requests which are not completed yet are given
+ * the job result. \n
+ * Manager is released before job future is made ready
+ * and job continuation is called, so that a new job can
+ * be started as soon as result is received.
+ *
+ * \param[in] idErr
+ * Result of the job.
+ *
+ * \warning
+ * Must be called from transfer thread, once
+ * workers are finished. No member of the job
+ * can be used afterwards.
+ */
+void TransferManager::Impl::resolveJob(IdError idErr)
+{
+    for(const auto &pair : m_mapResults){
+        resolveRequest(pair.first, idErr);
+    }
+
+    /* Retrieve job results receivers before releasing manager */
+    const BatchResult result{m_typeTransfer, idErr};
+    const bool hasPromise = m_hasPromiseJob;
+    std::promise<BatchResult> promise = std::move(m_promiseJob);
+    CbDone cbDone = std::move(m_cbJobDone);
+
+    m_hasPromiseJob = false;
+    m_cbJobDone = nullptr;
+    m_jobRunning = false;
+
+    /* Give results (continuation is called from transfer thread) */
+    if(hasPromise){
+        promise.set_value(result);
+    }
+
+    if(cbDone){
+        cbDone(result);
+    }
+}
+
+/*!
+ * \brief Use to wake up workers waiting
+ * for network events
+ *
+ * \param[in] workerSrc
+ * Worker requesting the wake up, it will not be wake up. \n
+ * Can be \c nullptr.
+ */
+void TransferManager::Impl::wakeUpWorkers(const Worker *workerSrc)
+{
+    for(size_t i = 0; i < m_nbWorkersUsed; ++i){
+        Worker *worker = m_listWorkers[i].get();
+        if(worker != workerSrc){
+            curl_multi_wakeup(worker->handleMulti);
+        }
+    }
+}
+
+bool TransferManager::Impl::queueIsEmpty(Worker &worker)
+{
+    Locker locker(worker.mutexQueue);
+    return worker.queueReqs.empty();
+}
+
+/*!
+ * \brief Use to reserve a transfer slot on
+ * the host of a request
+ * \details
+ * When option \c TransferManager::OPT_MIRROR_BY_THROUGHPUT is
+ * set, mirror of requests not started yet is selected according
+ * to measured throughput of each host (unknown hosts are preferred,
+ * in order to measure them), first mirror with an available slot
+ * is used.
+ *
+ * \param[in, out] req
+ * Request to use.
+ *
+ * \return
+ * Returns \c true if a slot has been acquired.
+ */
+bool TransferManager::Impl::acquireHost(Request *req)
+{
+    const bool useThroughput = (m_options & FlagOption::OPT_MIRROR_BY_THROUGHPUT);
+    if(!useThroughput || !req->hasMirrors() || req->ioGetNbTrials() > 0 || req->ioGetNbFailovers() > 0){
+        return m_ctrlConcurrency.tryAcquire(req->ioGetUrl().getHost());
+    }
+
+    /* Sort mirrors by throughput */
+    const std::vector<Url> &listMirrors = req->getMirrors();
+
+    std::vector<std::pair<double, size_t>> listScores;
+    listScores.reserve(listMirrors.size() + 1);
+
+    for(size_t idMirror = 0; idMirror <= listMirrors.size(); ++idMirror){
+        const Url &url = (idMirror == 0) ? req->getUrl() : listMirrors[idMirror - 1];
+
+        double throughput = m_ctrlConcurrency.getThroughput(url.getHost());
+        if(throughput < 0.0){
+            throughput = std::numeric_limits<double>::max();
+        }
+
+        listScores.emplace_back(throughput, idMirror);
+    }
+
+    std::stable_sort(listScores.begin(), listScores.end(), [](const auto &left, const auto &right){
+        return left.first > right.first;
+    });
+
+    /* Use fastest mirror able to accept a new transfer */
+    for(const auto &score : listScores){
+        req->ioSelectMirror(score.second);
+        if(m_ctrlConcurrency.tryAcquire(req->ioGetUrl().getHost())){
+            return true;
+        }
+    }
+
+    req->ioSelectMirror(listScores.front().second);
+    return false;
+}
+
+/*!
+ * \brief Use to create handle of a request
+ * \details
+ * Handle is duplicated from template of the current
+ * URL scheme and transfer type, it must then be configured
+ * with configureHandle().
+ *
+ * \param[in] req
+ * Request to transfer.
+ * \param[in] settings
+ * Manager configuration used by the transfer.
+ *
+ * \return
+ * Returns created handle, \c nullptr if failed
+ * to create it.
+ */
+CURL* TransferManager::Impl::createHandle(const Request *req, const Settings &settings)
+{
+    return m_templates.createHandle(req->ioGetUrl().getIdScheme(), req->getTypeTransfer(), settings.generationTemplates, [this, &settings](CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer){
+        configureTemplate(handle, idScheme, typeTransfer, settings);
+    });
+}
+
+/*!
+ * \brief Use to start transfer of a request
+ * \details
+ * Host slot must have been acquired before
+ * calling this method.
+ *
+ * \param[in, out] worker
+ * Worker which will perform the transfer.
+ * \param[in] req
+ * Request used by the transfer.
+ * \param[in] reqOrigin
+ * Request of the job associated to the transfer. \n
+ * Will differ from \c req only for hedged transfers.
+ *
+ * \return
+ * Returns created transfer, \c nullptr if failed
+ * to create handle.
+ */
+TransferManager::Impl::Transfer* TransferManager::Impl::createTransfer(Worker &worker, Request *req, Request *reqOrigin)
+{
+    /* Retrieve needed configuration (can be changed from any thread) */
+    Settings settings;
+    {
+        Locker locker(m_mutex);
+        settings = createSettings();
+    }
+
+    /* Create handle */
+    CURL *handle = createHandle(req, settings);
+    if(!handle){
+        TEASE_LOG_ERROR("Failed to initialize easy handle");
+        return nullptr;
+    }
+
+    /* Create associated transfer */
+    PtrTransfer transfer = std::make_unique<Transfer>();
+    transfer->handle = handle;
+    transfer->host = reqOrigin->ioGetUrl().getHost();
+    transfer->req = req;
+    transfer->reqOrigin = reqOrigin;
+    transfer->progress = (req == reqOrigin) ? &m_progress : nullptr;
+    transfer->settings = std::move(settings);
+    transfer->tsStart = Request::Clock::now();
+    transfer->deadline = getDeadline(reqOrigin);
+
+    if(transfer->progress){
+        ++m_nbReqsActive;
+    }
+
+    /* Datas of previous trials must not be kept, buffer is allocated once when size is known */
+    if(m_typeTransfer == Request::TRANSFER_DOWNLOAD){
+        req->getData().clear();
+        req->getData().reserve(req->ioGetSizeExpected());
+    }
+
+    /* Configure it */
+    configureHandle(transfer.get());
+    curl_multi_add_handle(worker.handleMulti, handle);
+
+    worker.listTransfers.push_back(std::move(transfer));
+    return worker.listTransfers.back().get();
+}
+
+/*!
+ * \brief Use to remove a transfer from
+ * the transfer loop
+ * \details
+ * Associated host slot is released, allowing
+ * queued requests to be started.
+ *
+ * \param[in, out] worker
+ * Worker owning the transfer.
+ * \param[in] transfer
+ * Transfer to release, pointer will be invalid
+ * once released.
+ */
+void TransferManager::Impl::releaseTransfer(Worker &worker, Transfer *transfer)
+{
+    m_ctrlConcurrency.release(transfer->host);
+    if(transfer->progress){
+        --m_nbReqsActive;
+    }
+
+    curl_multi_remove_handle(worker.handleMulti, transfer->handle);
+    curl_easy_cleanup(transfer->handle);
+    curl_slist_free_all(transfer->listResolve);
+    curl_slist_free_all(transfer->listHeaders);
+
+    auto it = std::find_if(worker.listTransfers.begin(), worker.listTransfers.end(), [transfer](const PtrTransfer &item){
+        return item.get() == transfer;
+    });
+    if(it != worker.listTransfers.end()){
+        *it = std::move(worker.listTransfers.back());
+        worker.listTransfers.pop_back();
+    }
+}
+
+void TransferManager::Impl::cleanHandles()
+{
+    for(auto &worker : m_listWorkers){
+        for(const auto &transfer : worker->listTransfers){
+            m_ctrlConcurrency.release(transfer->host);
+
+            curl_multi_remove_handle(worker->handleMulti, transfer->handle);
+            curl_easy_cleanup(transfer->handle);
+            curl_slist_free_all(transfer->listResolve);
+            curl_slist_free_all(transfer->listHeaders);
+        }
+
+        worker->listTransfers.clear();
+    }
+
+    m_nbReqsActive = 0;
+}
+
+void TransferManager::Impl::cleanRequests()
+{
+    for(auto &worker : m_listWorkers){
+        worker->queueReqs.clear();
+    }
+
+    Locker locker(m_mutex);
+    m_listReqs.clear();
+}
+
+/*!
+ * \brief Use to configure template handle of a
+ * scheme and a type of transfer
+ * \details
+ * Only options depending on manager configuration are set,
+ * handles of transfers are duplicated from it and then
+ * configured with configureHandle().
+ *
+ * \param[in, out] handle
+ * Template handle to configure.
+ * \param[in] idScheme
+ * Scheme of URLs using the template.
+ * \param[in] typeTransfer
+ * Type of transfers using the template.
+ * \param[in] settings
+ * Manager configuration to use, retrieved with createSettings().
+ *
+ * \sa HandleTemplates
+ */
+void TransferManager::Impl::configureTemplate(CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, const Settings &settings) const
+{
+    const bool isHttp = (idScheme == Url::SCHEME_HTTP || idScheme == Url::SCHEME_HTTPS);
+
+    /* Use DNS cache shared by all transfers (share handle itself is not duplicated) */
+    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, settings.timeoutDnsCache);
+
+    /* Manage protocols behaviours */
+    switch(idScheme)
+    {
+        case Url::SCHEME_FTPS:{
+            curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+        }TEASE_FALLTHROUGH;
+
+        case Url::SCHEME_FTP:{
+            curl_easy_setopt(handle, CURLOPT_USERNAME, settings.username.c_str());
+            curl_easy_setopt(handle, CURLOPT_PASSWORD, settings.userpwd.c_str());
+        }break;
+
+        case Url::SCHEME_HTTPS:{
+            curl_easy_setopt(handle, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+        }TEASE_FALLTHROUGH;
+
+        case Url::SCHEME_HTTP:{
+            curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1L); // HTTP errors must not be considered as valid content
+        }break;
+
+        default: break;
+    }
+
+    /* Manage configurations options related to the transfer type */
+    switch(typeTransfer)
+    {
+        case Request::TRANSFER_DOWNLOAD:{
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, curlCbWrite);
+
+            if(isHttp && (settings.options & FlagOption::OPT_HTTP_COMPRESSION)){
+                curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, ""); // Advertise all built-in supported encodings
+            }
+        }break;
+
+        case Request::TRANSFER_UPLOAD:{
+            curl_easy_setopt(handle, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(handle, CURLOPT_READFUNCTION, curlCbRead);
+        }break;
+
+        default: break;
+    }
+
+    /* Progress callback */
+    curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, curlCbProgress);
+    curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L); // Enable progress meter
+
+    /* Manage timeouts */
+    // Maximum time allowed to connect to host
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, settings.timeoutConnect);
+
+    // Minimum allowed speed (if transfer rate is below the limit for the configured timeout transfer, transfer will timeout)
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, MIN_SPEED_LIMIT);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, settings.timeoutTransfer);
+
+    /* Do we need to enable verbosity debug ? */
+    if(settings.options & FlagOption::OPT_VERBOSE){
+        curl_easy_setopt(handle, CURLOPT_DEBUGFUNCTION, curlCbVerbose);
+        curl_easy_setopt(handle, CURLOPT_VERBOSE, 1L);
+    }
+}
+
+/*!
+ * \brief Use to retrieve manager configuration
+ * used by transfers
+ * \details
+ * Caller must hold \c m_mutex, configuration can be
+ * changed from any thread. \n
+ * Generation of handle templates is retrieved along,
+ * setters invalidate templates while holding the lock.
+ *
+ * \return
+ * Returns current configuration.
+ */
+TransferManager::Impl::Settings TransferManager::Impl::createSettings() const
+{
+    Settings settings;
+    settings.options = m_options;
+    settings.nbMaxTrials = m_nbMaxTrials;
+    settings.uploadEncoding = m_uploadEncoding;
+    settings.digestAlgorithm = m_digestAlgorithm;
+    settings.cacheDelivery = m_cacheDelivery;
+    settings.ftpMethod = m_ftpMethod;
+
+    settings.username = m_username;
+    settings.userpwd = m_userpwd;
+    settings.timeoutConnect = m_timeoutConnect;
+    settings.timeoutTransfer = m_timeoutTransfer;
+    settings.timeoutDnsCache = m_dnsCache.getTimeout();
+    settings.generationTemplates = m_templates.getGeneration();
+
+    return settings;
+}
+
+/*!
+ * \brief Use to configure handle of a transfer
+ * with options specific to its request
+ * \details
+ * Handle must have been created with createHandle() or
+ * HandleTemplates::acquireHandle(), options of the manager
+ * configuration are already set. \n
+ * All options specific to a request must be set (even
+ * to their default value), idle handles keep those of
+ * their previous request.
+ *
+ * \param[in, out] transfer
+ * Transfer to configure.
+ */
+void TransferManager::Impl::configureHandle(Transfer *transfer)
+{
+    CURL *handle = transfer->handle;
+    Request *req = transfer->req;
+
+    /* URL informations */
+    const Url &url = req->ioGetUrl();
+    curl_easy_setopt(handle, CURLOPT_URL, url.toString().c_str());
+
+    const bool createDirs = needCreateDirs(req);
+    const bool isHttp = (url.getIdScheme() == Url::SCHEME_HTTP || url.getIdScheme() == Url::SCHEME_HTTPS);
+
+    /* Use caches shared by all transfers (DNS, connections, SSL sessions) */
+    curl_easy_setopt(handle, CURLOPT_SHARE, m_share.get());
+
+    transfer->listResolve = createResolveList(url);
+    curl_easy_setopt(handle, CURLOPT_RESOLVE, transfer->listResolve);
+
+    if(url.getIdScheme() == Url::SCHEME_FTP || url.getIdScheme() == Url::SCHEME_FTPS){
+        curl_easy_setopt(handle, CURLOPT_FTP_FILEMETHOD, FtpHelper::getFileMethod(transfer->settings.ftpMethod, createDirs));
+    }
+
+    /* Request datas */
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer);
+    transfer->digest = createDigest(transfer->reqOrigin, transfer->settings.digestAlgorithm);
+
+    /* Manage configurations options related to the transfer type */
+    switch(req->getTypeTransfer())
+    {
+        case Request::TRANSFER_DOWNLOAD:{
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, transfer);
+
+            if(isHttp && m_cacheHttp.isEnabled() && !req->hasDataSink()){
+                configureHttpCache(transfer);
+            }else{
+                curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, nullptr);
+                curl_easy_setopt(handle, CURLOPT_HEADERDATA, nullptr);
+            }
+        }break;
+
+        case Request::TRANSFER_UPLOAD:{
+            curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(req->getData().getSize()));
+            curl_easy_setopt(handle, CURLOPT_READDATA, transfer);
+
+            // Compress datas on the fly (compressed size is unknown, so datas are sent with chunked encoding)
+            if(isHttp && transfer->settings.uploadEncoding != ENCODING_NONE){
+                transfer->encoder = StreamEncoder::create(transfer->settings.uploadEncoding);
+            }
+
+            if(transfer->encoder){
+                const std::string header = StringHelper::format("Content-Encoding: %s", StreamEncoder::getName(transfer->settings.uploadEncoding));
+                transfer->listHeaders = curl_slist_append(transfer->listHeaders, header.c_str());
+
+                curl_easy_setopt(handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(-1));
+                curl_easy_setopt(handle, CURLOPT_READFUNCTION, curlCbReadEncoded);
+            }else{
+                curl_easy_setopt(handle, CURLOPT_READFUNCTION, curlCbRead);
+            }
+
+            // Manage available options (directory may have been created by a concurrent transfer)
+            curl_easy_setopt(handle, CURLOPT_FTP_CREATE_MISSING_DIRS, createDirs ? CURLFTP_CREATE_DIR_RETRY : CURLFTP_CREATE_DIR_NONE);
+        }break;
+
+        default: break;
+    }
+
+    /* Headers built for the request (handles given back to templates keep previous lists otherwise) */
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, transfer->listHeaders);
+
+    /* Progress callback */
+    curl_easy_setopt(handle, CURLOPT_XFERINFODATA, transfer);
+
+    /* Maximum time allowed for the whole transfer (according to request and batch deadlines) */
+    long timeoutMs = 0;
+
+    const Request::TimePoint deadline = transfer->deadline;
+    if(deadline != Request::TimePoint::max()){
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Request::Clock::now());
+        timeoutMs = std::max(1L, static_cast<long>(remaining.count()));
+    }
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeoutMs);
+
+    /* Verbosity logs are associated to the request */
+    if(transfer->settings.options & FlagOption::OPT_VERBOSE){
+        curl_easy_setopt(handle, CURLOPT_DEBUGDATA, req);
+    }
+}
+
+/*!
+ * \brief Use to configure a download transfer
+ * to use HTTP cache
+ * \details
+ * If a cached entry exist, its validators are sent
+ * as conditional headers (\c If-None-Match and
+ * \c If-Modified-Since). Validators of the response
+ * are captured to be stored with the body.
+ *
+ * \param[in, out] transfer
+ * Transfer to configure.
+ *
+ * \sa manageHttpCache()
+ */
+void TransferManager::Impl::configureHttpCache(Transfer *transfer)
+{
+    CURL *handle = transfer->handle;
+    const std::string key = transfer->req->ioGetUrl().toString();
+
+    transfer->useCache = true;
+
+    /* Send conditional request if an entry is available */
+    if(m_cacheHttp.getValidators(key, transfer->validatorsSent)){
+        const HttpCache::Validators &validators = transfer->validatorsSent;
+
+        if(!validators.etag.empty()){
+            const std::string header = "If-None-Match: " + validators.etag;
+            transfer->listHeaders = curl_slist_append(transfer->listHeaders, header.c_str());
+        }
+
+        if(!validators.lastModified.empty()){
+            const std::string header = "If-Modified-Since: " + validators.lastModified;
+            transfer->listHeaders = curl_slist_append(transfer->listHeaders, header.c_str());
+        }
+    }
+
+    /* Capture validators of response */
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, curlCbHeader);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, transfer);
+}
+
+/*!
+ * \brief Use to manage HTTP cache once a
+ * download transfer succeed
+ * \details
+ * On <tt>304 Not Modified</tt> response, cached body is
+ * loaded into request datas. Otherwise, received body
+ * is stored with its validators, unless response forbid it
+ * (<tt>Cache-Control: no-store</tt> or \c private).
+ *
+ * \param[in] transfer
+ * Transfer which succeed.
+ *
+ * \return
+ * Returns \c false if remote answered <tt>304 Not Modified</tt>
+ * but cached body could not be loaded.
+ *
+ * \sa configureHttpCache()
+ */
+bool TransferManager::Impl::manageHttpCache(Transfer *transfer)
+{
+    Request *req = transfer->req;
+    const std::string key = req->ioGetUrl().toString();
+
+    long codeHttp = 0;
+    curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &codeHttp);
+
+    /* Body has not been modified, use cached one */
+    if(codeHttp == HTTP_CODE_NOT_MODIFIED && !transfer->validatorsSent.isEmpty()){
+        if(!m_cacheHttp.load(key, req->getData())){
+            const std::string err = StringHelper::format("Unable to load cached body, entry is removed [url: %s]", key.c_str());
+            TEASE_LOG_WARN(err);
+
+            m_cacheHttp.remove(key);
+            return false;
+        }
+
+        const size_t size = req->getData().getSize();
+        setSizes(transfer, size, size);
+
+        if(transfer->digest){
+            transfer->digest->reset();
+            transfer->digest->update(req->getData().dataConst(), size);
+        }
+
+        m_cacheHttp.registerHit(size);
+        return true;
+    }
+
+    /* Body has been downloaded, keep it for next requests */
+    m_cacheHttp.registerMiss(!transfer->validatorsSent.isEmpty());
+    if(transfer->storeAllowed){
+        m_cacheHttp.store(key, transfer->validatorsRecv, req->getData());
+    }else{
+        m_cacheHttp.remove(key);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Use to complete a download request
+ * from content cache
+ *
+ * \param[in, out] req
+ * Request to complete.
+ * \param[in] settings
+ * Manager configuration to use.
+ *
+ * \return
+ * Returns \c true if request content was available
+ * in cache and has been delivered.
+ */
+bool TransferManager::Impl::deliverFromCache(Request *req, const Settings &settings)
+{
+    if(req->getTypeTransfer() != Request::TRANSFER_DOWNLOAD || !m_cacheContent.isEnabled() || req->hasDataSink()){
+        return false;
+    }
+
+    /* Deliver cached content */
+    const std::string key = ContentStore::createKey(req->getUrl(), req->getExpectedDigest());
+
+    // I/O state (expected size, mirror, trials) is kept on cache misses
+    req->getData().clear();
+    req->getMappedData().close();
+
+    size_t size = 0;
+    if(settings.cacheDelivery == CACHE_DELIVERY_MAP){
+        if(!m_cacheContent.map(key, req->getMappedData())){
+            return false;
+        }
+        size = req->getMappedData().getSize();
+
+    }else{
+        if(!m_cacheContent.load(key, req->getData())){
+            return false;
+        }
+        size = req->getData().getSize();
+    }
+
+    /* Cached content may have been altered on disk */
+    Digest::PtrUnique digest = createDigest(req, settings.digestAlgorithm);
+    if(digest){
+        const bool isMapped = req->getMappedData().isOpen();
+        digest->update(isMapped ? req->getMappedData().dataConst() : req->getData().dataConst(), size);
+
+        if(!verifyDigest(*digest, req, req)){
+            req->ioSetDigest(std::string());
+            req->getData().clear();
+            req->getMappedData().close();
+            return false;
+        }
+    }else{
+        req->ioSetDigest(std::string());
+    }
+
+    req->ioSetSizeTotal(size);
+    req->ioSetSizeCurrent(size);
+    req->ioSetSizeWire(0);
+    req->ioSetSkipped(false);
+
+    return true;
+}
+
+/*!
+ * \brief Use to know if remote ressource of an upload
+ * is already up to date
+ * \details
+ * Remote ressource is considered up to date when:
+ * - Its strong \c ETag is equal to expected digest of the request
+ * (value only, or prefixed by algorithm), or
+ * - Its size is equal to size of datas and its modification time
+ * is not older than the one of the request.
+ *
+ * \param[in] req
+ * Upload request.
+ * \param[in] ctrl
+ * Informations retrieved from remote ressource.
+ *
+ * \return
+ * Returns \c true if upload can be skipped.
+ *
+ * \sa Request::setExpectedDigest(), Request::setModificationTime()
+ */
+bool TransferManager::Impl::isUnchanged(const Request &req, const ControlRequest &ctrl)
+{
+    /* Remote ressource must exist */
+    if(ctrl.result != CURLE_OK){
+        return false;
+    }
+
+    const Url::IdScheme idScheme = req.getUrl().getIdScheme();
+    const bool isHttp = (idScheme == Url::SCHEME_HTTP || idScheme == Url::SCHEME_HTTPS);
+    if(isHttp && (ctrl.codeHttp < 200 || ctrl.codeHttp >= 300)){
+        return false;
+    }
+
+    /* Compare content identity (weak validators don't guarantee same bytes) */
+    const std::string &digest = req.getExpectedDigest();
+    if(!digest.empty() && !ctrl.etag.empty() && ctrl.etag.compare(0, 2, "W/") != 0){
+        TypeDigest idDigest;
+        std::string value;
+        Digest::parse(digest, idDigest, value);
+
+        std::string etag = StringHelper::toLower(ctrl.etag);
+        if(etag.size() >= 2 && etag.front() == '"' && etag.back() == '"'){
+            etag = etag.substr(1, etag.size() - 2);
+        }
+
+        if(etag == value || etag == StringHelper::toLower(digest)){
+            return true;
+        }
+    }
+
+    /* Compare size and modification time */
+    if(ctrl.size < 0 || static_cast<size_t>(ctrl.size) != req.getData().getSize()){
+        return false;
+    }
+
+    const std::time_t mtime = req.getModificationTime();
+    return mtime > 0 && ctrl.filetime >= mtime;
+}
+
+/*!
+ * \brief Use to create digest computed during
+ * transfer of a request
+ *
+ * \param[in] req
+ * Request to use.
+ * \param[in] idDigest
+ * Configured algorithm.
+ *
+ * \return
+ * Returns digest using algorithm of request expected
+ * digest if any, configured algorithm otherwise. \n
+ * Returns \c nullptr if no digest must be computed.
+ */
+Digest::PtrUnique TransferManager::Impl::createDigest(const Request *req, TypeDigest idDigest) const
+{
+    std::string value;
+
+    if(!req->getExpectedDigest().empty()){
+        Digest::parse(req->getExpectedDigest(), idDigest, value);
+    }
+
+    return Digest::create(idDigest);
+}
+
+/*!
+ * \brief Use to verify digest of transferred datas
+ * \details
+ * Computed digest is set to request (see
+ * Request::ioGetDigest()).
+ *
+ * \param[in, out] digest
+ * Digest computed on all transferred datas.
+ * \param[in, out] req
+ * Request which received datas.
+ * \param[in] reqOrigin
+ * Request of the job (differ from \c req only for
+ * hedged transfers).
+ *
+ * \return
+ * Returns \c true if digest match the expected one, or
+ * if request doesn't have an expected digest.
+ */
+bool TransferManager::Impl::verifyDigest(Digest &digest, Request *req, const Request *reqOrigin) const
+{
+    req->ioSetDigest(digest.finalize());
+
+    const std::string &expected = reqOrigin->getExpectedDigest();
+    if(expected.empty()){
+        return true;
+    }
+
+    if(StringHelper::toLower(expected) == req->ioGetDigest()){
+        return true;
+    }
+
+    const std::string err = StringHelper::format("Digest mismatch [url: %s, expected: %s, computed: %s]", req->ioGetUrl().toString().c_str(), expected.c_str(), req->ioGetDigest().c_str());
+    TEASE_LOG_WARN(err);
+
+    return false;
+}
+
+/*!
+ * \brief Use to coalesce identical downloads
+ * \details
+ * Requests targeting the same ressource (according
+ * to <tt>Url::operator==()</tt>) and expecting the same
+ * digest are performed once: first
+ * request of the list is transferred, others wait for its
+ * result (see completeFollowers()).
+ *
+ * \param[in, out] listReqs
+ * List of requests to perform, sorted by priority. \n
+ * Coalesced requests are removed from it.
+ */
+void TransferManager::Impl::coalesceRequests(Request::List &listReqs)
+{
+    std::unordered_map<std::string, Request*> mapLeaders;
+    mapLeaders.reserve(listReqs.size());
+
+    auto itEnd = std::remove_if(listReqs.begin(), listReqs.end(), [this, &mapLeaders](const Request::PtrShared &req){
+        // Datas given to a sink are not kept, they can't be shared
+        if(req->hasDataSink()){
+            return false;
+        }
+
+        // Same fields than Url::operator==() (requests expecting different contents are not coalesced)
+        const Url &url = req->getUrl();
+        const std::string key = StringHelper::format("%d|%s|%d|%s|%s", url.getIdScheme(), url.getHost().c_str(), url.getPort(), url.getPath().c_str(),
+                                                     StringHelper::toLower(req->getExpectedDigest()).c_str());
+
+        auto result = mapLeaders.emplace(key, req.get());
+        if(result.second){
+            return false; // First request of this ressource
+        }
+
+        m_mapFollowers[result.first->second].push_back(req.get());
+        return true;
+    });
+
+    const size_t nbCoalesced = std::distance(itEnd, listReqs.end());
+    listReqs.erase(itEnd, listReqs.end());
+
+    if(nbCoalesced > 0){
+        const std::string log = StringHelper::format("Coalesce identical downloads [nb-coalesced: %zu, nb-transfers: %zu]", nbCoalesced, listReqs.size());
+        TEASE_LOG_DEBUG(log);
+    }
+}
+
+/*!
+ * \brief Use to give result of a download to
+ * requests waiting for it
+ *
+ * \param[in] req
+ * Request which succeed.
+ *
+ * \sa coalesceRequests()
+ */
+void TransferManager::Impl::completeFollowers(const Request *req)
+{
+    std::vector<Request*> listFollowers;
+    {
+        Locker locker(m_mutexFollowers);
+
+        auto it = m_mapFollowers.find(req);
+        if(it == m_mapFollowers.end()){
+            return;
+        }
+
+        listFollowers = std::move(it->second);
+        m_mapFollowers.erase(it);
+    }
+
+    for(Request *follower : listFollowers){
+        // Request may have been cancelled while waiting
+        if(follower->ioIsAbort()){
+            ++m_nbReqsCancelled;
+            ++m_nbReqsDone;
+            resolveRequest(follower, ERR_USER_ABORT);
+            continue;
+        }
+
+        follower->getData() = req->getData();
+        m_progress.update(*follower, req->ioGetSizeTotal(), req->ioGetSizeCurrent());
+        follower->ioSetDigest(req->ioGetDigest());
+
+        ++m_nbReqsDone;
+        resolveRequest(follower, ERR_NO_ERROR);
+    }
+}
+
+/*!
+ * \brief Use to know if missing directories must
+ * be created by a transfer
+ *
+ * \param[in] req
+ * Request of the transfer.
+ *
+ * \return
+ * Returns \c true for uploads using option \c TransferManager::OPT_FTP_CREATE_DIRS,
+ * unless directory is already known to exist.
+ */
+bool TransferManager::Impl::needCreateDirs(const Request *req) const
+{
+    if(req->getTypeTransfer() != Request::TRANSFER_UPLOAD || !(m_options & FlagOption::OPT_FTP_CREATE_DIRS)){
+        return false;
+    }
+
+    return !m_cacheDirs.contains(req->ioGetUrl());
+}
+
+/*!
+ * \brief Use to create resolve overrides of an URL
+ *
+ * \param[in] url
+ * URL to use.
+ *
+ * \return
+ * Returns list to use with \c CURLOPT_RESOLVE, \c nullptr
+ * if host has not been pre-resolved. \n
+ * List must be freed with \c curl_slist_free_all() once
+ * associated handle has been cleaned.
+ */
+curl_slist* TransferManager::Impl::createResolveList(const Url &url) const
+{
+    const std::string entry = m_dnsCache.getResolveEntry(url);
+    if(entry.empty()){
+        return nullptr;
+    }
+
+    return curl_slist_append(nullptr, entry.c_str());
+}
+
+/*!
+ * \brief Use to retrieve effective deadline of a request
+ *
+ * \param[in] req
+ * Request to use.
+ *
+ * \return
+ * Returns earliest deadline between request deadline and
+ * batch deadline. \n
+ * Returns \c Request::TimePoint::max() if no deadline
+ * is set.
+ */
+Request::TimePoint TransferManager::Impl::getDeadline(const Request *req) const
+{
+    return std::min(req->getDeadline(), m_deadlineBatch);
+}
+
+TransferManager::Impl::PtrWorker TransferManager::Impl::createWorker()
+{
+    PtrWorker worker = std::make_unique<Worker>();
+
+    worker->handleMulti = curl_multi_init();
+    if(!worker->handleMulti){
+        return nullptr;
+    }
+
+    return worker;
+}
+
+size_t TransferManager::Impl::curlCbWrite(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    /* Cast elements */
+    Transfer *transfer = static_cast<Transfer*>(userdata);
+    Request *req = transfer->req;
+    BytesArray::Byte *bufferData = reinterpret_cast<BytesArray::Byte*>(ptr);
+
+    /* Store datas or give them to sink (datas refused by sink will be given again once resumed) */
+    const size_t bufferSize = size * nmemb;
+    if(!req->hasDataSink()){
+        req->getData().pushBack(bufferData, bufferSize);
+    }else if(req->getDataSink()(transfer->offsetSink, bufferData, bufferSize)){
+        transfer->offsetSink += bufferSize;
+    }else{
+        // Transfer performed on calling thread can't be resumed
+        if(!transfer->canPause){
+            return 0;
+        }
+
+        req->ioSetPaused(true);
+        transfer->isPaused = true;
+        transfer->wasPaused = true;
+        return CURL_WRITEFUNC_PAUSE;
+    }
+
+    /* Compute digest while datas are still in cache */
+    if(transfer->digest){
+        transfer->digest->update(bufferData, bufferSize);
+    }
+
+    return bufferSize;
+}
+
+size_t TransferManager::Impl::curlCbHeader(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    /* Cast elements */
+    Transfer *transfer = static_cast<Transfer*>(userdata);
+
+    const size_t bufferSize = size * nitems;
+    const std::string_view line(buffer, bufferSize);
+
+    /* New response started (redirection, etc...), only validators of last one are kept */
+    if(line.compare(0, 5, "HTTP/") == 0){
+        transfer->validatorsRecv = HttpCache::Validators();
+        transfer->storeAllowed = true;
+        return bufferSize;
+    }
+
+    /* Parse header */
+    std::string name, value;
+    if(!parseHeader(line, name, value)){
+        return bufferSize;
+    }
+
+    if(name == "etag"){
+        transfer->validatorsRecv.etag = value;
+    }else if(name == "last-modified"){
+        transfer->validatorsRecv.lastModified = value;
+    }else if(name == "cache-control"){
+        transfer->storeAllowed = transfer->storeAllowed && HttpCache::isStorable(value);
+    }
+
+    return bufferSize;
+}
+
+size_t TransferManager::Impl::curlCbHeaderControl(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    /* Cast elements */
+    ControlRequest *ctrl = static_cast<ControlRequest*>(userdata);
+
+    const size_t bufferSize = size * nitems;
+    const std::string_view line(buffer, bufferSize);
+
+    /* New response started (redirection, etc...), only informations of last one are kept */
+    if(line.compare(0, 5, "HTTP/") == 0){
+        ctrl->etag.clear();
+        return bufferSize;
+    }
+
+    /* Parse header */
+    std::string name, value;
+    if(parseHeader(line, name, value) && name == "etag"){
+        ctrl->etag = value;
+    }
+
+    return bufferSize;
+}
+
+/*!
+ * \brief Use to parse an HTTP header line
+ *
+ * \param[in] line
+ * Header line to parse.
+ * \param[out] name
+ * Name of the header, in lowercase.
+ * \param[out] value
+ * Value of the header, without surrounding spaces.
+ *
+ * \return
+ * Returns \c false if line is not a header.
+ */
+bool TransferManager::Impl::parseHeader(std::string_view line, std::string &name, std::string &value)
+{
+    const size_t posSep = line.find(':');
+    if(posSep == std::string_view::npos){
+        return false;
+    }
+
+    name = StringHelper::toLower(std::string(line.substr(0, posSep)));
+    value = StringHelper::trim(std::string(line.substr(posSep + 1)));
+
+    return true;
+}
+
+size_t TransferManager::Impl::curlCbRead(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    /* Cast elements */
+    const Transfer *transfer = static_cast<Transfer*>(userdata);
+
+    /* Read request data */
+    const size_t bufferSize = size * nitems;
+    return readRequest(transfer, buffer, bufferSize);
+}
+
+size_t TransferManager::Impl::readRequest(const Transfer *transfer, char *buffer, size_t size)
+{
+    const size_t nbRead = transfer->req->ioRead(buffer, size);
+
+    /* Compute digest on raw datas */
+    if(transfer->digest){
+        transfer->digest->update(buffer, nbRead);
+    }
+
+    return nbRead;
+}
+
+size_t TransferManager::Impl::curlCbReadEncoded(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    /* Cast elements */
+    const Transfer *transfer = static_cast<Transfer*>(userdata);
+
+    /* Read compressed request data */
+    const size_t bufferSize = size * nitems;
+    const size_t nbBytes = transfer->encoder->read(buffer, bufferSize, [transfer](char *bufferRaw, size_t sizeRaw){
+        return readRequest(transfer, bufferRaw, sizeRaw);
+    });
+
+    return nbBytes != StreamEncoder::READ_ERROR ? nbBytes : CURL_READFUNC_ABORT;
+}
+
+/*!
+ * \brief Use to set sizes of the request of a transfer
+ * \details
+ * Job progress is updated accordingly, except for
+ * hedged requests (only the request of the job is
+ * part of the job progress).
+ *
+ * \param[in] transfer
+ * Transfer to use.
+ * \param[in] sizeTotal
+ * Total size of the request in bytes, \c 0 if unknown.
+ * \param[in] sizeCurrent
+ * Number of bytes transferred.
+ */
+void TransferManager::Impl::setSizes(const Transfer *transfer, size_t sizeTotal, size_t sizeCurrent)
+{
+    /* Size announced by remote is not always known, use prefetched one meanwhile */
+    if(sizeTotal == 0){
+        sizeTotal = transfer->req->ioGetSizeExpected();
+    }
+
+    if(transfer->progress){
+        transfer->progress->update(*transfer->req, sizeTotal, sizeCurrent);
+        return;
+    }
+
+    transfer->req->ioSetSizeTotal(sizeTotal);
+    transfer->req->ioSetSizeCurrent(sizeCurrent);
+}
+
+int TransferManager::Impl::curlCbProgress(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    /* Cast elements */
+    const Transfer *transfer = static_cast<Transfer*>(clientp);
+    Request *req = transfer->req;
+
+    /* Update transfer status */
+    switch(req->getTypeTransfer())
+    {
+        case Request::TRANSFER_DOWNLOAD:{
+            setSizes(transfer, dltotal, dlnow);
+        }break;
+
+        case Request::TRANSFER_UPLOAD:{
+            // Progress of compressed uploads is based on raw datas, compressed size being unknown
+            if(transfer->encoder){
+                setSizes(transfer, req->getData().getSize(), transfer->encoder->getSizeIn());
+            }else{
+                setSizes(transfer, ultotal, ulnow);
+            }
+        }break;
+
+        default: break;
+    }
+
+    /* Do we have to abort current transfer ? */
+    if(transfer->reqOrigin->ioIsAbort()){
+        return 1;
+    }
+
+    /* Continue transfer by returning 0 */
+    return 0;
+}
+
+int TransferManager::Impl::curlCbVerbose(TEASE_VAR_UNUSED CURL *handle, curl_infotype type, char *data, size_t size, void *userdata)
+{
+    /* Cast elements */
+    Request *req = static_cast<Request*>(userdata);
+
+    /* Prepare debug message according to data type */
+    std::string message;
+    switch(type)
+    {
+        case CURLINFO_DATA_IN:
+        case CURLINFO_DATA_OUT:{
+            message = StringHelper::format("binary data of %zu bytes", size);
+        }break;
+
+        case CURLINFO_SSL_DATA_IN:
+        case CURLINFO_SSL_DATA_OUT:{
+            message = StringHelper::format("SSL (binary) data of %zu bytes", size);
+        }break;
+
+        default:{
+            message = std::string(data, size);
+        }break;
+    }
+
+    const std::string fmtMess = StringHelper::format("Curl debug message [type: %d, message: '%s', url: '%s']", type, message.c_str(), req->ioGetUrl().toString().c_str());
+    TEASE_LOG_DEBUG(fmtMess);
+
+    return 0;
+}
+
+/*!
+ * \brief Use to call user callback associated
+ * to an event
+ * \details
+ * Called from the thread chosen by setCallbackDispatch().
+ *
+ * \param[in] event
+ * Event to dispatch.
+ */
+void TransferManager::Impl::dispatchEvent(const CallbackDispatcher::Event &event)
+{
+    switch(event.idType)
+    {
+        case CallbackDispatcher::EVENT_STARTED:     m_cbStarted(event.typeTransfer); break;
+        case CallbackDispatcher::EVENT_PROGRESS:
+        {
+            m_cbProgress(event.typeTransfer, event.progress.sizeTotal, event.progress.sizeCurrent);
+            if(m_cbProgressInfos){
+                m_cbProgressInfos(event.typeTransfer, event.progress);
+            }
+        }break;
+
+        case CallbackDispatcher::EVENT_COMPLETED:   m_cbCompleted(event.typeTransfer); break;
+        case CallbackDispatcher::EVENT_FAILED:      m_cbFailed(event.typeTransfer, event.idErr); break;
+
+        default: break;
+    }
+}
+
+void TransferManager::Impl::defaultCbStarted(Request::TypeTransfer typeTransfer)
+{
+    const std::string str = StringHelper::format("Default callback \"started\" [type-transfer: %d]", typeTransfer);
+    TEASE_LOG_INFO(str);
+}
+
+void TransferManager::Impl::defaultCbProgress(Request::TypeTransfer typeTransfer, size_t transferTotal, size_t transferNow)
+{
+    const std::string str = StringHelper::format("Default callback \"progress\" [type-transfer: %d, total: %zu, now: %zu]", typeTransfer, transferTotal, transferNow);
+    TEASE_LOG_INFO(str);
+}
+
+void TransferManager::Impl::defaultCbCompleted(Request::TypeTransfer typeTransfer)
+{
+    const std::string str = StringHelper::format("Default callback \"completed\" [type-transfer: %d]", typeTransfer);
+    TEASE_LOG_INFO(str);
+}
+
+void TransferManager::Impl::defaultCbFailed(Request::TypeTransfer typeTransfer, IdError idErr)
+{
+    const std::string str = StringHelper::format("Default callback \"failed\" [type-transfer: %d, id-err: %d]", typeTransfer, idErr);
+    TEASE_LOG_INFO(str);
+}
+
+/*****************************/
+/* Functions implementation  */
+/*      Public Class         */
+/*****************************/
+
+TransferManager::TransferManager() :
+    d_ptr(std::make_unique<Impl>(this))
+{
+    d_ptr->init();
+}
+
+TransferManager::~TransferManager() = default;
+
+/*!
+ * \brief Use to start downloading list of requests
+ *
+ * \param[in, out] listReqs
+ * List of requests to download. \n
+ * This argument is a list of request pointers, those will be directly
+ * filled with downloaded datas, so pointers must remains valid. \n
+ * Once transfer is finished, user can read request content directly
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * This method is asynchronous, so please use dedicated callbacks
+ * to manage transfer status.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if download succeed to be prepared. \n
+ * This method will return \c TransferManager::ERR_BUSY error if a transfer is already
+ * running or if called from a callback.
+ *
+ * \sa startUpload()
+ * \sa abortTransfer()
+ */
+TransferManager::IdError TransferManager::startDownload(const Request::List &listReqs)
+{
+    /* Perform pre-job verifications */
+    const IdError idErr = d_ptr->jobPrepare(Request::TRANSFER_DOWNLOAD, listReqs);
+    if(idErr != ERR_NO_ERROR){
+        return idErr;
+    }
+
+    /* Start download process */
+    d_ptr->jobStart();
+
+    return ERR_NO_ERROR;
+}
+
+/*!
+ * \brief Use to start upload list of requests
+ *
+ * \param[in, out] listReqs
+ * List of requests to upload. \n
+ * This argument is a list of request pointers, those will be directly
+ * read in order to upload datas, so pointers must remains valid. \n
+ * Once transfer is finished, user can still use request content.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * This method is asynchronous, so please use dedicated callbacks
+ * to manage transfer status.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if upload succeed to be prepared. \n
+ * This method will return \c TransferManager::ERR_BUSY error if a transfer is already
+ * running or if called from a callback.
+ *
+ * \sa startDownload()
+ * \sa abortTransfer()
+ */
+TransferManager::IdError TransferManager::startUpload(const Request::List &listReqs)
+{
+    /* Perform pre-job verifications */
+    const IdError idErr = d_ptr->jobPrepare(Request::TRANSFER_UPLOAD, listReqs);
+    if(idErr != ERR_NO_ERROR){
+        return idErr;
+    }
+
+    /* Start upload process */
+    d_ptr->jobStart();
+
+    return ERR_NO_ERROR;
+}
+
+/*!
+ * \brief Use to start transferring list of requests,
+ * result is given through a future
+ * \details
+ * This method behave like startDownload() and startUpload(),
+ * transfer type being deduced from requests. \n
+ * Returned future allow to wait for the end of the transfer
+ * without polling transferIsInProgress(): once ready, a new
+ * transfer can be started.
+ *
+ * \param[in, out] listReqs
+ * List of requests to transfer, all requests must have
+ * the same transfer type. Pointers must remains valid
+ * until transfer is finished.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Registered callbacks are still called. With
+ * \c TransferManager::DISPATCH_THREAD or \c TransferManager::DISPATCH_EXECUTOR,
+ * those may be called after future is ready.
+ *
+ * \return
+ * Returns future of the transfer result. If transfer failed to be
+ * prepared (\c TransferManager::ERR_BUSY, \c TransferManager::ERR_INVALID_REQUEST, etc...),
+ * returned future is already ready with associated error.
+ *
+ * \sa startDownload(), startUpload()
+ * \sa abortTransfer()
+ */
+std::future<TransferManager::BatchResult> TransferManager::submit(const Request::List &listReqs)
+{
+    return d_ptr->jobSubmit(listReqs, nullptr);
+}
+
+/*!
+ * \brief Use to start transferring list of requests,
+ * results of the transfer and of each request are given
+ * through futures
+ * \details
+ * Future of a request is ready as soon as the request is
+ * completed, its content can then be used while other
+ * requests are still transferred. \n
+ * If transfer failed, requests which were not completed
+ * are given the transfer error.
+ *
+ * \param[in, out] listReqs
+ * List of requests to transfer.
+ * \param[out] listFutures
+ * List filled with one future per request, in same
+ * order than \c listReqs.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns future of the transfer result.
+ *
+ * \sa submit(const Request::List&)
+ */
+std::future<TransferManager::BatchResult> TransferManager::submit(const Request::List &listReqs, std::vector<std::future<IdError>> &listFutures)
+{
+    return d_ptr->jobSubmit(listReqs, &listFutures);
+}
+
+/*!
+ * \brief Use to start transferring a single request,
+ * result is given through a future
+ *
+ * \param[in, out] req
+ * Request to transfer.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns future of the transfer result.
+ *
+ * \sa submit(const Request::List&)
+ */
+std::future<TransferManager::BatchResult> TransferManager::submit(const Request::PtrShared &req)
+{
+    return d_ptr->jobSubmit(Request::List{req}, nullptr);
+}
+
+/*!
+ * \brief Use to start transferring list of requests,
+ * result is given to a continuation
+ * \details
+ * This method behave like submit(const Request::List&), result
+ * being given to \c cbDone instead of a future:
+ * - If transfer failed to be prepared (\c TransferManager::ERR_BUSY,
+ * \c TransferManager::ERR_INVALID_REQUEST, etc...), it is called
+ * right away from calling thread.
+ * - Otherwise it is called from transfer thread once transfer is
+ * finished. A new transfer can already be started from it.
+ *
+ * Continuation is called exactly once, it is meant to resume
+ * a waiting task (see TransferAwaitable) without any thread
+ * dedicated to the wait.
+ *
+ * \param[in, out] listReqs
+ * List of requests to transfer, all requests must have
+ * the same transfer type. Pointers must remains valid
+ * until transfer is finished.
+ * \param[in] cbDone
+ * Continuation receiving the transfer result.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \warning
+ * Continuation must return quickly (heavy work should be
+ * posted to an executor) and must not destroy the manager.
+ *
+ * \sa submit(const Request::List&)
+ */
+void TransferManager::submit(const Request::List &listReqs, CbDone cbDone)
+{
+    d_ptr->jobSubmit(listReqs, nullptr, std::move(cbDone));
+}
+
+/*!
+ * \brief Use to transfer a request on the calling thread
+ * \details
+ * This method is meant for small latency-critical requests: no
+ * thread is started and no polling is performed, connections
+ * opened by previous transfers are reused. \n
+ * Request is configured like requests of startDownload() and
+ * startUpload() (credentials, timeouts, mirrors, digests, caches,
+ * compression, etc...) and follow same retries and errors mapping. \n
+ * Batch timeout (see setTimeoutBatch()) is not applied, only
+ * the deadline of the request (see Request::setDeadline()). \n
+ * Following features are only available to batches: limit of
+ * transfers per host, hedging, skipping unchanged uploads and
+ * sizes prefetching.
+ *
+ * \param[in, out] req
+ * Request to transfer, its type is given by its configuration.
+ *
+ * \note
+ * This method is \em thread-safe, it can be called while a batch
+ * is in progress and from multiple threads at once.
+ * \note
+ * This method is synchronous, registered callbacks are not called.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if succeed. \n
+ * Returns \c TransferManager::ERR_INVALID_REQUEST if request is invalid,
+ * otherwise error of the transfer.
+ *
+ * \sa submit()
+ */
+TransferManager::IdError TransferManager::transferNow(const Request::PtrShared &req)
+{
+    return d_ptr->transferNow(req.get());
+}
+
+/*!
+ * \brief Use to abort current transfer
+ * \details
+ * This method will return directly, that don't mean that
+ * transfer has been aborted yet. \n
+ * Once transfer aborted, callback \c TransferManager::CbFailed will be
+ * called with error code \c TransferManager::ERR_USER_ABORT. \n
+ * Nothing will be perform if no transfer is currently running
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * This method is asynchronous, so please use dedicated callbacks
+ * to manage transfer status.
+ *
+ * \sa startDownload(), startUpload()
+ * \sa cancel()
+ */
+void TransferManager::abortTransfer()
+{
+    /* Verify that a transfer is currently running */
+    if(!transferIsInProgress()){
+        return;
+    }
+
+    d_ptr->abortJob();
+}
+
+/*!
+ * \brief Use to cancel a request of current transfer
+ * \details
+ * Request transfer is removed right away (or never started
+ * if still queued), other requests are still performed. \n
+ * Cancelled request is completed with error \c TransferManager::ERR_USER_ABORT
+ * (see submit()) and transfer will fail with this error once
+ * all other requests are completed.
+ *
+ * \param[in] idReq
+ * Identifier of the request to cancel (see Request::getId()). \n
+ * Nothing is performed if request doesn't belong to current transfer.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Cancelled request keeps its abort flag (see Request::ioIsAbort())
+ * until it is reset or configured again.
+ *
+ * \sa abortTransfer()
+ */
+void TransferManager::cancel(Request::Id idReq)
+{
+    d_ptr->cancelRequests({idReq});
+}
+
+/*!
+ * \brief Use to cancel a group of requests of
+ * current transfer
+ *
+ * \param[in] listIds
+ * Identifiers of requests to cancel.
+ *
+ * \sa cancel(Request::Id)
+ */
+void TransferManager::cancel(const std::vector<Request::Id> &listIds)
+{
+    d_ptr->cancelRequests(listIds);
+}
+
+/*!
+ * \brief Use to pause all transfers
+ * \details
+ * Running transfers are paused with curl pause mechanism:
+ * their connections are kept open but no more datas are
+ * received nor sent, queued requests are not started. \n
+ * Pause is kept until resumeTransfer() is called, transfers
+ * started meanwhile are paused too.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Deadlines and batch timeout still apply to paused transfers,
+ * but no low-speed timeout (see setTimeoutTransfer()) is raised.
+ *
+ * \sa resumeTransfer(), transferIsPaused()
+ * \sa pause()
+ */
+void TransferManager::pauseTransfer()
+{
+    d_ptr->pauseJob(true);
+}
+
+/*!
+ * \brief Use to resume transfers paused
+ * by pauseTransfer()
+ * \details
+ * Requests paused individually (see pause()) stay paused.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa pauseTransfer()
+ */
+void TransferManager::resumeTransfer()
+{
+    d_ptr->pauseJob(false);
+}
+
+/*!
+ * \brief Use to pause a request of current transfer
+ * \details
+ * Request transfer is paused right away (or not started
+ * if still queued) until resume() is called, other requests
+ * are still performed. \n
+ * Transfer will not complete while a request is paused, so
+ * paused requests must be resumed or cancelled.
+ *
+ * \param[in] idReq
+ * Identifier of the request to pause (see Request::getId()). \n
+ * Nothing is performed if request doesn't belong to current transfer.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa resume(), pauseTransfer()
+ * \sa Request::ioIsPaused()
+ */
+void TransferManager::pause(Request::Id idReq)
+{
+    d_ptr->pauseRequests({idReq}, true);
+}
+
+/*!
+ * \brief Use to pause a group of requests of
+ * current transfer
+ *
+ * \param[in] listIds
+ * Identifiers of requests to pause.
+ *
+ * \sa pause(Request::Id)
+ */
+void TransferManager::pause(const std::vector<Request::Id> &listIds)
+{
+    d_ptr->pauseRequests(listIds, true);
+}
+
+/*!
+ * \brief Use to resume a request of current transfer
+ * \details
+ * Used for requests paused by pause() and for requests
+ * which data sink refused datas (see Request::setDataSink()).
+ *
+ * \param[in] idReq
+ * Identifier of the request to resume. \n
+ * Nothing is performed if request doesn't belong to current transfer.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa pause()
+ */
+void TransferManager::resume(Request::Id idReq)
+{
+    d_ptr->pauseRequests({idReq}, false);
+}
+
+/*!
+ * \brief Use to resume a group of requests of
+ * current transfer
+ *
+ * \param[in] listIds
+ * Identifiers of requests to resume.
+ *
+ * \sa resume(Request::Id)
+ */
+void TransferManager::resume(const std::vector<Request::Id> &listIds)
+{
+    d_ptr->pauseRequests(listIds, false);
+}
+
+/*!
+ * \brief Use to prepare connections to a list of hosts
+ * \details
+ * First request on each host usually has to pay DNS lookup
+ * and TCP/TLS handshakes. This method allow to pay those
+ * costs before a latency-critical batch:
+ * - Hosts are resolved in parallel, resolved addresses are cached
+ * and used by next transfers until they expire (see setDnsCacheTimeout())
+ * - If \c openConnections is set, a connection is opened to each host
+ * and kept idle in connections cache shared by all transfers of
+ * the manager
+ *
+ * \param[in] listHosts
+ * List of URLs of hosts to prepare. Only scheme, host and port
+ * are used.
+ * \param[in] openConnections
+ * Set to \c true to also open connections to each host.
+ *
+ * \note
+ * This method is \em thread-safe, it can be called while a transfer
+ * is in progress.
+ * \note
+ * This method is synchronous, it returns once all hosts have been
+ * prepared (hosts resolution and opening connections are each bounded
+ * by connection timeout).
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if succeed. \n
+ * Returns \c TransferManager::ERR_INVALID_REQUEST if an URL is invalid,
+ * \c TransferManager::ERR_HOST_NOT_FOUND if a connection could not be opened
+ * (other hosts are still prepared).
+ *
+ * \sa setDnsCacheTimeout()
+ */
+TransferManager::IdError TransferManager::prewarm(const std::vector<Url> &listHosts, bool openConnections)
+{
+    /* Verify URLs validity */
+    for(const Url &url : listHosts){
+        if(!url.isValid()){
+            const std::string err = StringHelper::format("Receive invalid URL to prewarm [id-scheme: %d, host: %s]", url.getIdScheme(), url.getHost().c_str());
+            TEASE_LOG_ERROR(err);
+            return ERR_INVALID_REQUEST;
+        }
+    }
+
+    /* Resolve hosts (bounded by connection timeout) */
+    long timeoutConnect;
+    {
+        Impl::Locker locker(d_ptr->m_mutex);
+        timeoutConnect = d_ptr->m_timeoutConnect;
+    }
+
+    d_ptr->m_dnsCache.resolve(listHosts, timeoutConnect);
+
+    /* Open connections */
+    if(openConnections){
+        return d_ptr->prewarmConnections(listHosts);
+    }
+
+    return ERR_NO_ERROR;
+}
+
+/*!
+ * \brief Verify is a tranfer is in progress
+ * or not
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns \c true if a transfer is currently running
+ */
+bool TransferManager::transferIsInProgress() const
+{
+    return d_ptr->m_jobRunning;
+}
+
+/*!
+ * \brief Verify if transfers are paused
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns \c true if pauseTransfer() has been called
+ * and transfers have not been resumed yet.
+ */
+bool TransferManager::transferIsPaused() const
+{
+    return d_ptr->m_pauseJob;
+}
+
+/*!
+ * \brief Retrieve login information currently
+ * used
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns user information login.
+ *
+ * \sa setUserInfos()
+ */
+const std::string& TransferManager::getUserLogin() const
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_username;
+}
+
+/*!
+ * \brief Retrieve password information currently
+ * used
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns user information password.
+ *
+ * \sa setUserInfos()
+ */
+const std::string& TransferManager::getUserPasswd() const
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_userpwd;
+}
+
+/*!
+ * \brief Retrieve maximum number of trials
+ * currently set.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns maximum number of trials currently set.
+ *
+ * \sa setNbMaxTrials()
+ */
+int TransferManager::getNbMaxTrials() const
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_nbMaxTrials;
+}
+
+/*!
+ * \brief Retrieve connection timeout.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns connection timeout in seconds
+ * currently set.
+ *
+ * \sa setTimeoutConnection()
+ */
+long TransferManager::getTimeoutConnection() const
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_timeoutConnect;
+}
+
+/*!
+ * \brief Retrieve transfer timeout.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns transfer timeout in seconds
+ * currently set.
+ *
+ * \sa setTimeoutTransfer()
+ */
+long TransferManager::getTimeoutTransfer() const
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_timeoutTransfer;
 }
 
-size_t TransferManager::Impl::curlCbRead(char *buffer, size_t size, size_t nitems, void *userdata)
+/*!
+ * \brief Retrieve batch timeout.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns batch timeout in seconds
+ * currently set.
+ *
+ * \sa setTimeoutBatch()
+ */
+long TransferManager::getTimeoutBatch() const
 {
-    /* Cast elements */
-    Request *req = static_cast<Request*>(userdata);
-
-    /* Read request data */
-    const size_t bufferSize = size * nitems;
-    return req->ioRead(buffer, bufferSize);
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_timeoutBatch;
 }
 
-int TransferManager::Impl::curlCbProgress(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+/*!
+ * \brief Retrieve time-to-live of resolved hosts.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns time-to-live in seconds
+ * currently set.
+ *
+ * \sa setDnsCacheTimeout()
+ */
+long TransferManager::getDnsCacheTimeout() const
 {
-    /* Cast elements */
-    Request *req = static_cast<Request*>(clientp);
-
-    /* Update transfer status */
-    switch(req->getTypeTransfer())
-    {
-        case Request::TRANSFER_DOWNLOAD:{
-            req->ioSetSizeTotal(dltotal);
-            req->ioSetSizeCurrent(dlnow);
-        }break;
-
-        case Request::TRANSFER_UPLOAD:{
-            req->ioSetSizeTotal(ultotal);
-            req->ioSetSizeCurrent(ulnow);
-        }break;
-
-        default: break;
-    }
-
-    /* Do we have to abort current transfer ? */
-    if(req->ioIsAbort()){
-        return 1;
-    }
-
-    /* Continue transfer by returning 0 */
-    return 0;
+    return d_ptr->m_dnsCache.getTimeout();
 }
 
-int TransferManager::Impl::curlCbVerbose(TEASE_VAR_UNUSED CURL *handle, curl_infotype type, char *data, size_t size, void *userdata)
+/*!
+ * \brief Retrieve transfer options.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns transfer options.
+ *
+ * \sa setOptions()
+ */
+TransferManager::FlagOption TransferManager::getOptions() const
 {
-    /* Cast elements */
-    Request *req = static_cast<Request*>(userdata);
-
-    /* Prepare debug message according to data type */
-    std::string message;
-    switch(type)
-    {
-        case CURLINFO_DATA_IN:
-        case CURLINFO_DATA_OUT:{
-            message = StringHelper::format("binary data of %zu bytes", size);
-        }break;
-
-        case CURLINFO_SSL_DATA_IN:
-        case CURLINFO_SSL_DATA_OUT:{
-            message = StringHelper::format("SSL (binary) data of %zu bytes", size);
-        }break;
-
-        default:{
-            message = std::string(data, size);
-        }break;
-    }
-
-    const std::string fmtMess = StringHelper::format("Curl debug message [type: %d, message: '%s', url: '%s']", type, message.c_str(), req->getUrl().toString().c_str());
-    TEASE_LOG_DEBUG(fmtMess);
-
-    return 0;
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_options;
 }
 
-void TransferManager::Impl::defaultCbStarted(Request::TypeTransfer typeTransfer)
+/*!
+ * \brief Retrieve maximum number of simultaneous
+ * transfers allowed per host.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns maximum number of transfers per host,
+ * \c 0 means no limit.
+ *
+ * \sa setNbMaxTransfersPerHost()
+ */
+int TransferManager::getNbMaxTransfersPerHost() const
 {
-    const std::string str = StringHelper::format("Default callback \"started\" [type-transfer: %d]", typeTransfer);
-    TEASE_LOG_INFO(str);
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_nbMaxHost;
 }
 
-void TransferManager::Impl::defaultCbProgress(Request::TypeTransfer typeTransfer, size_t transferTotal, size_t transferNow)
+/*!
+ * \brief Retrieve number of workers used
+ * to perform transfers.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns number of workers, \c 0 means one
+ * worker per hardware thread.
+ *
+ * \sa setNbWorkers()
+ */
+int TransferManager::getNbWorkers() const
 {
-    const std::string str = StringHelper::format("Default callback \"progress\" [type-transfer: %d, total: %zu, now: %zu]", typeTransfer, transferTotal, transferNow);
-    TEASE_LOG_INFO(str);
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_nbWorkers;
 }
 
-void TransferManager::Impl::defaultCbCompleted(Request::TypeTransfer typeTransfer)
+/*!
+ * \brief Retrieve hedging policy currently used
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns hedging policy.
+ *
+ * \sa setHedgingPolicy(), getHedgingPercentile()
+ */
+TransferManager::TypeHedging TransferManager::getHedgingPolicy() const
 {
-    const std::string str = StringHelper::format("Default callback \"completed\" [type-transfer: %d]", typeTransfer);
-    TEASE_LOG_INFO(str);
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_hedgingPolicy;
 }
 
-void TransferManager::Impl::defaultCbFailed(Request::TypeTransfer typeTransfer, IdError idErr)
+/*!
+ * \brief Retrieve percentile of observed latencies
+ * used to trigger hedging
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns percentile in range <tt>[0, 100]</tt>.
+ *
+ * \sa setHedgingPolicy(), getHedgingPolicy()
+ */
+double TransferManager::getHedgingPercentile() const
 {
-    const std::string str = StringHelper::format("Default callback \"failed\" [type-transfer: %d, id-err: %d]", typeTransfer, idErr);
-    TEASE_LOG_INFO(str);
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_hedgingPercentile;
 }
 
-/*****************************/
-/* Functions implementation  */
-/*      Public Class         */
-/*****************************/
-
-TransferManager::TransferManager() :
-    d_ptr(std::make_unique<Impl>(this))
+/*!
+ * \brief Retrieve method used to reach files
+ * on FTP servers
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns FTP method.
+ *
+ * \sa setFtpMethod()
+ */
+TransferManager::TypeFtpMethod TransferManager::getFtpMethod() const
 {
-    d_ptr->init();
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_ftpMethod;
 }
 
-TransferManager::~TransferManager() = default;
-
 /*!
- * \brief Use to start downloading list of requests
- *
- * \param[in, out] listReqs
- * List of requests to download. \n
- * This argument is a list of request pointers, those will be directly
- * filled with downloaded datas, so pointers must remains valid. \n
- * Once transfer is finished, user can read request content directly
+ * \brief Retrieve encoding used to compress
+ * uploaded datas
  *
  * \note
  * This method is \em thread-safe
- * \note
- * This method is asynchronous, so please use dedicated callbacks
- * to manage transfer status.
  *
  * \return
- * Returns \c TransferManager::ERR_NO_ERROR if download succeed to be prepared. \n
- * This method will return \c TransferManager::ERR_BUSY error if a transfer is already
- * running or if called from a callback.
+ * Returns upload encoding.
  *
- * \sa startUpload()
- * \sa abortTransfer()
+ * \sa setUploadEncoding()
  */
-TransferManager::IdError TransferManager::startDownload(const Request::List &listReqs)
+TransferManager::TypeEncoding TransferManager::getUploadEncoding() const
 {
-    /* Perform pre-job verifications */
-    const IdError idErr = d_ptr->jobPrepare(Request::TRANSFER_DOWNLOAD, listReqs);
-    if(idErr != ERR_NO_ERROR){
-        return idErr;
-    }
-
-    /* Start download process */
-    d_ptr->m_threadTransfer = std::async(std::launch::async, &Impl::jobPerform, d_ptr.get());
-
-    return ERR_NO_ERROR;
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_uploadEncoding;
 }
 
 /*!
- * \brief Use to start upload list of requests
- *
- * \param[in, out] listReqs
- * List of requests to upload. \n
- * This argument is a list of request pointers, those will be directly
- * read in order to upload datas, so pointers must remains valid. \n
- * Once transfer is finished, user can still use request content.
+ * \brief Retrieve algorithm used to compute digest
+ * of transferred datas
  *
  * \note
  * This method is \em thread-safe
- * \note
- * This method is asynchronous, so please use dedicated callbacks
- * to manage transfer status.
  *
  * \return
- * Returns \c TransferManager::ERR_NO_ERROR if upload succeed to be prepared. \n
- * This method will return \c TransferManager::ERR_BUSY error if a transfer is already
- * running or if called from a callback.
+ * Returns digest algorithm.
  *
- * \sa startDownload()
- * \sa abortTransfer()
+ * \sa setDigestAlgorithm()
  */
-TransferManager::IdError TransferManager::startUpload(const Request::List &listReqs)
+TransferManager::TypeDigest TransferManager::getDigestAlgorithm() const
 {
-    /* Perform pre-job verifications */
-    const IdError idErr = d_ptr->jobPrepare(Request::TRANSFER_UPLOAD, listReqs);
-    if(idErr != ERR_NO_ERROR){
-        return idErr;
-    }
-
-    /* Start upload process */
-    d_ptr->m_threadTransfer = std::async(std::launch::async, &Impl::jobPerform, d_ptr.get());
-
-    return ERR_NO_ERROR;
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_digestAlgorithm;
 }
 
 /*!
- * \brief Use to abort current transfer
- * \details
- * This method will return directly, that don't mean that
- * transfer has been aborted yet. \n
- * Once transfer aborted, callback \c TransferManager::CbFailed will be
- * called with error code \c TransferManager::ERR_USER_ABORT. \n
- * Nothing will be perform if no transfer is currently running
+ * \brief Retrieve policy used to order requests
  *
  * \note
  * This method is \em thread-safe
- * \note
- * This method is asynchronous, so please use dedicated callbacks
- * to manage transfer status.
  *
- * \sa startDownload(), startUpload()
+ * \return
+ * Returns scheduling policy.
+ *
+ * \sa setSchedulingPolicy()
  */
-void TransferManager::abortTransfer()
+TransferManager::TypeScheduling TransferManager::getSchedulingPolicy() const
 {
-    /* Verify that a transfer is currently running */
-    if(!transferIsInProgress()){
-        return;
-    }
+    Impl::Locker locker(d_ptr->m_mutex);
+    return d_ptr->m_scheduling;
+}
 
-    /* Set abort related properties */
-    for(auto it = d_ptr->m_listReqs.begin(); it != d_ptr->m_listReqs.end(); ++it){
-        (*it)->ioAbort();
-    }
+/*!
+ * \brief Retrieve method used to call callbacks
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \return
+ * Returns dispatch method.
+ *
+ * \sa setCallbackDispatch()
+ */
+TransferManager::TypeDispatch TransferManager::getCallbackDispatch() const
+{
+    return d_ptr->m_dispatcher.getTypeDispatch();
 }
 
 /*!
- * \brief Verify is a tranfer is in progress
- * or not
+ * \brief Retrieve minimum interval between
+ * two progress events
  *
  * \note
  * This method is \em thread-safe
  *
  * \return
- * Returns \c true if a transfer is currently running
+ * Returns interval in milliseconds.
+ *
+ * \sa setProgressInterval()
  */
-bool TransferManager::transferIsInProgress() const
+long TransferManager::getProgressInterval() const
 {
     Impl::Locker locker(d_ptr->m_mutex);
-
-    /* Do thread is set ? */
-    if(!d_ptr->m_threadTransfer.valid()){
-        return false;
-    }
-
-    /* Do thread is currently running ? */
-    return d_ptr->m_threadTransfer.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    return d_ptr->m_progressInterval;
 }
 
 /*!
- * \brief Retrieve login information currently
- * used
+ * \brief Retrieve minimum number of bytes
+ * transferred between two progress events
  *
  * \note
  * This method is \em thread-safe
  *
  * \return
- * Returns user information login.
+ * Returns threshold in bytes.
  *
- * \sa setUserInfos()
+ * \sa setProgressInterval()
  */
-const std::string& TransferManager::getUserLogin() const
+size_t TransferManager::getProgressThreshold() const
 {
     Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_username;
+    return d_ptr->m_progressThreshold;
 }
 
-/*!
- * \brief Retrieve password information currently
- * used
+/*!
+ * \brief Retrieve statistics of each host
+ * used by transfers
+ * \details
+ * Statistics are kept between transfers, so those
+ * can be read during or after a transfer. \n
+ * This is mainly useful for monitoring achieved
+ * concurrency and throughput when option
+ * \c TransferManager::OPT_ADAPTIVE_CONCURRENCY is used.
  *
  * \note
  * This method is \em thread-safe
  *
  * \return
- * Returns user information password.
+ * Returns list of statistics, one per host.
  *
- * \sa setUserInfos()
+ * \sa setNbMaxTransfersPerHost()
  */
-const std::string& TransferManager::getUserPasswd() const
+std::vector<TransferManager::HostStats> TransferManager::getHostsStats() const
 {
-    Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_userpwd;
+    return d_ptr->m_ctrlConcurrency.getStats();
 }
 
 /*!
- * \brief Retrieve maximum number of trials
- * currently set.
+ * \brief Retrieve progress of current transfer
+ * \details
+ * Progress is the same than the one given to
+ * progress callback, but can be polled at any time. \n
+ * Once transfer is finished, progress of last transfer
+ * is kept.
  *
  * \note
- * This method is \em thread-safe
+ * This method is \em thread-safe and \em lock-free,
+ * it can be called while transfers are running.
  *
  * \return
- * Returns maximum number of trials currently set.
+ * Returns transfer progress.
  *
- * \sa setNbMaxTrials()
+ * \sa setCbProgress()
  */
-int TransferManager::getNbMaxTrials() const
+TransferManager::Progress TransferManager::getProgress() const
 {
-    Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_nbMaxTrials;
+    return d_ptr->createProgress();
 }
 
 /*!
- * \brief Retrieve connection timeout.
+ * \brief Retrieve progress of each request
+ * of current transfer
+ * \details
+ * Contrary to getProgress(), this method browse
+ * all requests of the transfer, so it should only
+ * be used on demand (to display details, etc...). \n
+ * Once transfer is finished, returned list is empty.
  *
  * \note
- * This method is \em thread-safe
+ * This method is \em thread-safe and can be called
+ * while transfers are running.
  *
  * \return
- * Returns connection timeout in seconds
- * currently set.
+ * Returns progress of each request.
  *
- * \sa setTimeoutConnection()
+ * \sa getProgress()
  */
-long TransferManager::getTimeoutConnection() const
+std::vector<TransferManager::RequestProgress> TransferManager::getRequestsProgress() const
 {
     Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_timeoutConnect;
+
+    std::vector<RequestProgress> listProgress;
+    listProgress.reserve(d_ptr->m_listReqs.size());
+
+    for(const auto &req : d_ptr->m_listReqs){
+        listProgress.push_back(RequestProgress{req, req->ioGetSizeTotal(), req->ioGetSizeCurrent()});
+    }
+
+    return listProgress;
 }
 
 /*!
- * \brief Retrieve transfer timeout.
+ * \brief Retrieve statistics of HTTP cache
+ * \details
+ * Statistics are kept between transfers.
  *
  * \note
- * This method is \em thread-safe
+ * This method is \em thread-safe and can be called
+ * while transfers are running.
  *
  * \return
- * Returns transfer timeout in seconds
- * currently set.
+ * Returns cache statistics.
  *
- * \sa setTimeoutTransfer()
+ * \sa setHttpCache()
  */
-long TransferManager::getTimeoutTransfer() const
+TransferManager::HttpCacheStats TransferManager::getHttpCacheStats() const
 {
-    Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_timeoutTransfer;
+    return d_ptr->m_cacheHttp.getStats();
 }
 
 /*!
- * \brief Retrieve transfer options.
+ * \brief Retrieve statistics of incremental uploads
+ * \details
+ * Statistics are kept between transfers.
  *
  * \note
  * This method is \em thread-safe
  *
  * \return
- * Returns transfer options.
+ * Returns incremental uploads statistics.
  *
- * \sa setOptions()
+ * \sa OPT_SKIP_UNCHANGED, Request::ioIsSkipped()
  */
-TransferManager::FlagOption TransferManager::getOptions() const
+TransferManager::SkipStats TransferManager::getSkipStats() const
 {
     Impl::Locker locker(d_ptr->m_mutex);
-    return d_ptr->m_options;
+    return d_ptr->m_statsSkip;
 }
 
 /*!
@@ -959,6 +4982,7 @@ void TransferManager::setUserInfos(const std::string &username, const std::strin
 
     d_ptr->m_username = username;
     d_ptr->m_userpwd = passwd;
+    d_ptr->m_templates.invalidate();
 }
 
 /*!
@@ -1011,6 +5035,7 @@ void TransferManager::setTimeoutConnection(long timeout)
 
     timeout = std::max(0L, timeout);
     d_ptr->m_timeoutConnect = timeout;
+    d_ptr->m_templates.invalidate();
 }
 
 /*!
@@ -1039,6 +5064,62 @@ void TransferManager::setTimeoutTransfer(long timeout)
 
     timeout = std::max(0L, timeout);
     d_ptr->m_timeoutTransfer = timeout;
+    d_ptr->m_templates.invalidate();
+}
+
+/*!
+ * \brief Use to set the maximum time in seconds
+ * allowed for a whole batch of requests
+ * \details
+ * Contrary to setTimeoutTransfer() which only detect stalled
+ * transfers, this timeout is a wall-clock budget: once
+ * reached, transfer will fail with error
+ * \c TransferManager::ERR_DEADLINE_EXCEEDED, even if datas
+ * are still being received. \n
+ * This timeout is combined with deadline of each request,
+ * see Request::setDeadline().
+ *
+ * \param[in] timeout
+ * Timeout in seconds. \n
+ * To disable it, use value <tt>0</tt>.
+ * Default value is: \c 0
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa getTimeoutBatch()
+ */
+void TransferManager::setTimeoutBatch(long timeout)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    timeout = std::max(0L, timeout);
+    d_ptr->m_timeoutBatch = timeout;
+}
+
+/*!
+ * \brief Use to set time during which resolved
+ * hosts are kept in cache
+ * \details
+ * Applies to hosts resolved by prewarm() and to
+ * hosts resolved during transfers.
+ *
+ * \param[in] timeout
+ * Time-to-live in seconds. \n
+ * To disable cache, use value <tt>0</tt>.
+ * Default value is: \c 60
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa getDnsCacheTimeout(), prewarm()
+ */
+void TransferManager::setDnsCacheTimeout(long timeout)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    d_ptr->m_dnsCache.setTimeout(timeout);
+    d_ptr->m_templates.invalidate();
 }
 
 /*!
@@ -1057,6 +5138,322 @@ void TransferManager::setOptions(FlagOption options)
 {
     Impl::Locker locker(d_ptr->m_mutex);
     d_ptr->m_options = options;
+    d_ptr->m_templates.invalidate();
+}
+
+/*!
+ * \brief Use to set maximum number of simultaneous
+ * transfers allowed per host
+ * \details
+ * Requests exceeding this limit are queued and started
+ * as soon as a transfer on the same host finishes. \n
+ * When option \c TransferManager::OPT_ADAPTIVE_CONCURRENCY
+ * is set, this value is used as upper bound of the adaptive
+ * limit.
+ *
+ * \param[in] nbMax
+ * Maximum number of transfers per host. \n
+ * To disable it, use value <tt>0</tt>.
+ * Default value is: \c 0
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa getNbMaxTransfersPerHost(), getHostsStats()
+ */
+void TransferManager::setNbMaxTransfersPerHost(int nbMax)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    nbMax = std::max(0, nbMax);
+    d_ptr->m_nbMaxHost = nbMax;
+}
+
+/*!
+ * \brief Use to set number of workers used
+ * to perform transfers
+ * \details
+ * Each worker run in its own thread and drive its own
+ * set of transfers, allowing to spread TLS and callbacks
+ * processing over multiple cores. \n
+ * Requests are dispatched between workers at transfer start,
+ * and a worker with no more queued requests will steal queued
+ * requests of busiest workers.
+ *
+ * \param[in] nbWorkers
+ * Number of workers to use. \n
+ * Use value <tt>0</tt> to use one worker per hardware thread.
+ * Default value is: \c 1
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Registered callbacks are never called simultaneously, but
+ * can be called from any worker thread.
+ *
+ * \sa getNbWorkers()
+ */
+void TransferManager::setNbWorkers(int nbWorkers)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    nbWorkers = std::max(0, nbWorkers);
+    d_ptr->m_nbWorkers = nbWorkers;
+}
+
+/*!
+ * \brief Use to set hedging policy used to
+ * reduce tail latency of downloads
+ * \details
+ * When a running request is slower than the \c percentile
+ * of observed latencies (time to first byte or completion time,
+ * according to \c policy), a duplicate request is started. First
+ * one to complete is kept, the other one is cancelled. \n
+ * Latencies are collected over latest transfers, hedging is
+ * only performed once enough transfers have been observed.
+ *
+ * \param[in] policy
+ * Hedging policy to use. \n
+ * Default value is: \c TransferManager::HEDGING_DISABLED
+ * \param[in] percentile
+ * Percentile of observed latencies used as threshold, in
+ * range <tt>[0, 100]</tt>. \n
+ * Default value is: \c 95
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Duplicated requests count in host concurrency limit, so
+ * they will be started only if host has an available slot.
+ *
+ * \sa getHedgingPolicy(), getHedgingPercentile()
+ */
+void TransferManager::setHedgingPolicy(TypeHedging policy, double percentile)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    d_ptr->m_hedgingPolicy = policy;
+    d_ptr->m_hedgingPercentile = std::clamp(percentile, 0.0, 100.0);
+}
+
+/*!
+ * \brief Use to set method used to reach files
+ * on FTP servers
+ *
+ * \param[in] method
+ * Method to use. \n
+ * Default value is: \c TransferManager::FTP_METHOD_MULTICWD
+ * (same as curl)
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * When option \c TransferManager::OPT_FTP_CREATE_DIRS is used,
+ * uploads always use \c TransferManager::FTP_METHOD_MULTICWD since
+ * missing directories can only be created one by one.
+ *
+ * \sa getFtpMethod()
+ */
+void TransferManager::setFtpMethod(TypeFtpMethod method)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_ftpMethod = method;
+}
+
+/*!
+ * \brief Use to set encoding used to compress
+ * uploaded datas
+ * \details
+ * Datas are compressed while being sent (no compressed
+ * copy is stored) and are transferred with chunked
+ * encoding, since compressed size is unknown. \n
+ * Progress of compressed uploads is reported on raw datas,
+ * number of bytes really sent is available with
+ * Request::ioGetSizeWire() once transfer succeed.
+ *
+ * \param[in] encoding
+ * Encoding to use. \n
+ * Default value is: \c TransferManager::ENCODING_NONE
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Encoding is only applied to HTTP(S) uploads. If encoding
+ * is not supported by this build, uploads will fail
+ * with \c TransferManager::ERR_INVALID_REQUEST.
+ *
+ * \sa getUploadEncoding(), encodingIsSupported()
+ * \sa OPT_HTTP_COMPRESSION
+ */
+void TransferManager::setUploadEncoding(TypeEncoding encoding)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_uploadEncoding = encoding;
+}
+
+/*!
+ * \brief Use to set algorithm used to compute digest
+ * of transferred datas
+ * \details
+ * Digest is computed incrementally while datas are received
+ * (or sent), so that datas don't have to be read again once
+ * transfer is completed. It is available with Request::ioGetDigest()
+ * once transfer succeed.
+ *
+ * \param[in] algorithm
+ * Algorithm to use. \n
+ * Default value is: \c TransferManager::DIGEST_NONE
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Requests having an expected digest (see Request::setExpectedDigest())
+ * always compute a digest using the algorithm of the expected one.
+ *
+ * \sa getDigestAlgorithm()
+ */
+void TransferManager::setDigestAlgorithm(TypeDigest algorithm)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_digestAlgorithm = algorithm;
+}
+
+/*!
+ * \brief Use to set policy used to order requests
+ * before starting them
+ * \details
+ * When requests can't all be started at once (see
+ * setNbMaxTransfersPerHost()), order in which they are
+ * started impacts completion time of each request: few big
+ * transfers started first can hold all slots while many
+ * small ones wait.
+ *
+ * \param[in] policy
+ * Policy to use. \n
+ * Default value is: \c TransferManager::SCHEDULING_GROUPED
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa getSchedulingPolicy(), OPT_PREFETCH_SIZES
+ */
+void TransferManager::setSchedulingPolicy(TypeScheduling policy)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_scheduling = policy;
+}
+
+/*!
+ * \brief Use to set HTTP cache used by downloads
+ * \details
+ * Downloaded bodies are stored with their validators
+ * (\c ETag and \c Last-Modified headers). Next downloads
+ * of the same URL send a conditional request, and when remote
+ * answers <tt>304 Not Modified</tt>, stored body is set into
+ * Request::getData() without being transferred again. \n
+ * Responses without any validator, or using
+ * <tt>Cache-Control: no-store</tt> or \c private, are not cached.
+ *
+ * \param[in] pathDir
+ * Directory where responses are stored, kept between
+ * sessions. Use an empty path to disable disk storage (default).
+ * \param[in] inMemory
+ * Set to \c true to also keep responses in memory, avoiding
+ * to read them from disk. \n
+ * If \c pathDir is empty, responses are only kept in memory.
+ * \param[in] sizeMax
+ * Maximum size in bytes of stored responses (applied to disk
+ * and memory separately), \c 0 for no limit (default). \n
+ * Least recently used responses are removed once exceeded.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Cache is only used by HTTP(S) downloads. To disable it, call
+ * <tt>setHttpCache("", false)</tt>.
+ *
+ * \sa getHttpCacheStats()
+ */
+void TransferManager::setHttpCache(const std::string &pathDir, bool inMemory, size_t sizeMax)
+{
+    d_ptr->m_cacheHttp.configure(pathDir, inMemory, sizeMax);
+}
+
+/*!
+ * \brief Use to set local content cache used
+ * by downloads
+ * \details
+ * Downloaded contents are stored in a local directory, which can be
+ * shared by several managers and processes. Next downloads of the same
+ * content are completed from the cache without any network access. \n
+ * Contents are addressed by their expected digest when set (see
+ * Request::setExpectedDigest()), by their URL otherwise.
+ *
+ * \param[in] pathDir
+ * Directory of the cache, created if needed. \n
+ * Use an empty path to disable the cache (default).
+ * \param[in] sizeMax
+ * Maximum size of the cache in bytes, least recently used contents
+ * are removed when exceeded. \n
+ * Use \c 0 for no limit.
+ * \param[in] delivery
+ * Method used to deliver cached contents.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Unlike HTTP cache (see setHttpCache()), cached contents are never
+ * revalidated with remote: this cache is meant for immutable ressources
+ * (versioned artifacts, etc...).
+ */
+void TransferManager::setContentCache(const std::string &pathDir, size_t sizeMax, TypeCacheDelivery delivery)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    d_ptr->m_cacheContent.configure(pathDir, sizeMax);
+    d_ptr->m_cacheDelivery = delivery;
+}
+
+/*!
+ * \brief Use to limit rate of progress events
+ * \details
+ * A progress event is emitted only once both \a interval
+ * elapsed and \a threshold bytes have been transferred
+ * since previous event. Intermediate progress values are
+ * coalesced, and last progress of a transfer is always
+ * emitted before transfer completion. \n
+ * Rate-limiting applies to callbacks set with setCbProgress()
+ * and setCbProgressInfos(), getProgress() can still be
+ * polled at any time.
+ *
+ * \param[in] interval
+ * Minimum interval between two progress events in
+ * milliseconds. \n
+ * Default value is: \c 0 (progress is emitted at each
+ * transfer loop iteration)
+ * \param[in] threshold
+ * Minimum number of bytes transferred between two
+ * progress events. \n
+ * Default value is: \c 0
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Rate-limiting can't be changed while a transfer is in progress.
+ *
+ * \sa getProgressInterval(), getProgressThreshold()
+ */
+void TransferManager::setProgressInterval(long interval, size_t threshold)
+{
+    if(transferIsInProgress()){
+        TEASE_LOG_ERROR("Unable to change progress interval, transfer already in progress");
+        return;
+    }
+
+    Impl::Locker locker(d_ptr->m_mutex);
+
+    d_ptr->m_progressInterval = std::max(0L, interval);
+    d_ptr->m_progressThreshold = threshold;
 }
 
 /*!
@@ -1135,6 +5532,73 @@ void TransferManager::setCbFailed(CbFailed fct)
     d_ptr->m_cbFailed = fct;
 }
 
+/*!
+ * \brief Use to set detailed progress callback
+ * \details
+ * No callback is set by default. \n
+ * See TransferManager documentation for more details
+ * on how to set the callback.
+ *
+ * \param[in] fct
+ * Callback function to use during transfer, it
+ * receives smoothed throughput, estimated remaining
+ * time and number of requests in each state.
+ *
+ * \note
+ * This method is \em thread-safe
+ *
+ * \sa setCbProgress()
+ */
+void TransferManager::setCbProgressInfos(CbProgressInfos fct)
+{
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_cbProgressInfos = fct;
+}
+
+/*!
+ * \brief Use to set how callbacks are called
+ * \details
+ * By default, callbacks are called from transfer threads. With
+ * \c TransferManager::DISPATCH_THREAD or \c TransferManager::DISPATCH_EXECUTOR,
+ * callbacks events are queued and transfer threads never wait for
+ * user code: progress events are coalesced (only latest progress
+ * is given to callback), other events are all dispatched in order.
+ *
+ * \param[in] dispatch
+ * Dispatch method to use. \n
+ * Default value is: \c TransferManager::DISPATCH_DIRECT
+ * \param[in] executor
+ * Executor used with \c TransferManager::DISPATCH_EXECUTOR: it
+ * receives tasks which call pending callbacks, and must run them
+ * later on a thread of its choice (UI event loop, thread pool, etc...). \n
+ * Executor is called from transfer threads, so it must only
+ * schedule the task, not run it.
+ *
+ * \note
+ * This method is \em thread-safe
+ * \note
+ * Dispatch method can't be changed while a transfer is in progress.
+ * Tasks given to executor and run after manager destruction
+ * will do nothing.
+ *
+ * \sa getCallbackDispatch()
+ */
+void TransferManager::setCallbackDispatch(TypeDispatch dispatch, Executor executor)
+{
+    if(transferIsInProgress()){
+        TEASE_LOG_ERROR("Unable to change callbacks dispatch method, transfer already in progress");
+        return;
+    }
+
+    if(dispatch == DISPATCH_EXECUTOR && !executor){
+        TEASE_LOG_ERROR("Unable to dispatch callbacks to executor, no executor provided");
+        return;
+    }
+
+    Impl::Locker locker(d_ptr->m_mutex);
+    d_ptr->m_dispatcher.configure(dispatch, std::move(executor));
+}
+
 /*!
  * \brief Use to convert progress data to a percentage
  *
@@ -1157,6 +5621,26 @@ double TransferManager::transferProgressToPercent(size_t transferTotal, size_t t
     return (static_cast<double>(transferNow) / transferTotal) * 100.0;
 }
 
+/*!
+ * \brief Use to know if an upload encoding
+ * is available
+ * \details
+ * Available encodings depend on compression libraries
+ * found when library was built.
+ *
+ * \param[in] encoding
+ * Encoding to verify.
+ *
+ * \return
+ * Returns \c true if encoding can be used.
+ *
+ * \sa setUploadEncoding()
+ */
+bool TransferManager::encodingIsSupported(TypeEncoding encoding)
+{
+    return StreamEncoder::isSupported(encoding);
+}
+
 /*!
  * \brief Use to convert flags option to a string
  *
@@ -1178,8 +5662,14 @@ std::string TransferManager::flagOptionToStr(FlagOption options, char separator)
     /* Define string equivalent only once */
     static const std::unordered_map<FlagOption, std::string> MAP_FLAG_OPT_TO_STR =
     {
-        {FlagOption::OPT_NONE,              "OPT_NONE"},
-        {FlagOption::OPT_FTP_CREATE_DIRS,   "OPT_FTP_CREATE_DIRS"}
+        {FlagOption::OPT_NONE,                  "OPT_NONE"},
+        {FlagOption::OPT_VERBOSE,               "OPT_VERBOSE"},
+        {FlagOption::OPT_FTP_CREATE_DIRS,       "OPT_FTP_CREATE_DIRS"},
+        {FlagOption::OPT_ADAPTIVE_CONCURRENCY,  "OPT_ADAPTIVE_CONCURRENCY"},
+        {FlagOption::OPT_MIRROR_BY_THROUGHPUT,  "OPT_MIRROR_BY_THROUGHPUT"},
+        {FlagOption::OPT_HTTP_COMPRESSION,      "OPT_HTTP_COMPRESSION"},
+        {FlagOption::OPT_SKIP_UNCHANGED,        "OPT_SKIP_UNCHANGED"},
+        {FlagOption::OPT_PREFETCH_SIZES,        "OPT_PREFETCH_SIZES"}
     };
 
     /* Convert flags to string */
@@ -1204,7 +5694,9 @@ const std::string &TransferManager::idErrorToStr(IdError idErr)
         {IdError::ERR_MEMORY_FULL_REMOTE,   "ERR_MEMORY_FULL_REMOTE"},
         {IdError::ERR_HOST_NOT_FOUND,       "ERR_HOST_NOT_FOUND"},
         {IdError::ERR_HOST_REFUSED,         "ERR_HOST_REFUSED"},
-        {IdError::ERR_CONTENT_NOT_FOUND,    "ERR_CONTENT_NOT_FOUND"}
+        {IdError::ERR_CONTENT_NOT_FOUND,    "ERR_CONTENT_NOT_FOUND"},
+        {IdError::ERR_DEADLINE_EXCEEDED,    "ERR_DEADLINE_EXCEEDED"},
+        {IdError::ERR_INTEGRITY,            "ERR_INTEGRITY"}
     };
 
     /* Return associated string */
@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+
+#include "net/callbackdispatcher.h"
+
+#include <future>
+
+using CallbackDispatcher = tease::CallbackDispatcher;
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class CallbackDispatcherTest : public ::testing::Test
+{
+protected:
+    CallbackDispatcher::Handler createHandler()
+    {
+        return [this](const CallbackDispatcher::Event &event){
+            if(m_blocked){
+                m_gate.wait();
+            }
+
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_listEvents.push_back(event);
+            m_listThreads.push_back(std::this_thread::get_id());
+        };
+    }
+
+    void block()
+    {
+        m_blocked = true;
+        m_gate = m_promiseGate.get_future().share();
+    }
+
+    void unblock()
+    {
+        m_promiseGate.set_value();
+    }
+
+    /* Post terminal events following a known pattern */
+    static void postTerminals(CallbackDispatcher &dispatcher, int idxFirst, int nbEvents)
+    {
+        for(int i = idxFirst; i < idxFirst + nbEvents; ++i){
+            switch(i % 3)
+            {
+                case 0:     dispatcher.postStarted(Request::TRANSFER_DOWNLOAD); break;
+                case 1:     dispatcher.postCompleted(Request::TRANSFER_DOWNLOAD); break;
+                default:    dispatcher.postFailed(Request::TRANSFER_UPLOAD, (i % 2) ? TransferManager::ERR_USER_ABORT : TransferManager::ERR_CONTENT_NOT_FOUND); break;
+            }
+        }
+    }
+
+    static bool matchTerminal(const CallbackDispatcher::Event &event, int idx)
+    {
+        switch(idx % 3)
+        {
+            case 0:     return event.idType == CallbackDispatcher::EVENT_STARTED;
+            case 1:     return event.idType == CallbackDispatcher::EVENT_COMPLETED;
+            default:    break;
+        }
+
+        return event.idType == CallbackDispatcher::EVENT_FAILED && event.typeTransfer == Request::TRANSFER_UPLOAD
+            && event.idErr == ((idx % 2) ? TransferManager::ERR_USER_ABORT : TransferManager::ERR_CONTENT_NOT_FOUND);
+    }
+
+    std::vector<CallbackDispatcher::Event> getTerminals()
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+
+        std::vector<CallbackDispatcher::Event> listTerminals;
+        for(const auto &event : m_listEvents){
+            if(event.idType != CallbackDispatcher::EVENT_PROGRESS){
+                listTerminals.push_back(event);
+            }
+        }
+
+        return listTerminals;
+    }
+
+protected:
+    std::mutex m_mutex;
+    std::vector<CallbackDispatcher::Event> m_listEvents;
+    std::vector<std::thread::id> m_listThreads;
+
+    std::atomic<bool> m_blocked{false};
+    std::promise<void> m_promiseGate;
+    std::shared_future<void> m_gate;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(CallbackDispatcherTest, dispatchDirect)
+{
+    CallbackDispatcher dispatcher(createHandler());
+    EXPECT_EQ(dispatcher.getTypeDispatch(), TransferManager::DISPATCH_DIRECT);
+
+    postTerminals(dispatcher, 0, 3);
+
+    /* Events are given from posting thread, before post returns */
+    ASSERT_EQ(m_listEvents.size(), 3);
+    for(size_t i = 0; i < m_listEvents.size(); ++i){
+        EXPECT_TRUE(matchTerminal(m_listEvents[i], static_cast<int>(i))) << i;
+        EXPECT_EQ(m_listThreads[i], std::this_thread::get_id()) << i;
+    }
+}
+
+TEST_F(CallbackDispatcherTest, dispatchThreadBlockedConsumer)
+{
+    constexpr int NB_EVENTS = 2000;
+    constexpr size_t NB_PROGRESS = 500;
+
+    CallbackDispatcher dispatcher(createHandler());
+    dispatcher.configure(TransferManager::DISPATCH_THREAD, nullptr);
+    block();
+
+    /* Producer never wait for the consumer, even once queue is full */
+    for(int i = 0; i < NB_EVENTS; ++i){
+        postTerminals(dispatcher, i, 1);
+
+        if(i % (NB_EVENTS / NB_PROGRESS) == 0){
+            TransferManager::Progress progress{};
+            progress.sizeCurrent = static_cast<size_t>(i);
+            dispatcher.postProgress(Request::TRANSFER_DOWNLOAD, progress);
+        }
+    }
+
+    TransferManager::Progress progressLast{};
+    progressLast.sizeCurrent = NB_EVENTS;
+    dispatcher.postProgress(Request::TRANSFER_DOWNLOAD, progressLast);
+
+    unblock();
+    dispatcher.stop();
+
+    /* Terminal events are never lost, and keep their order */
+    const auto listTerminals = getTerminals();
+    ASSERT_EQ(listTerminals.size(), NB_EVENTS);
+    for(int i = 0; i < NB_EVENTS; ++i){
+        ASSERT_TRUE(matchTerminal(listTerminals[i], i)) << i;
+    }
+
+    /* Progress events are coalesced, latest one is always dispatched */
+    std::lock_guard<std::mutex> locker(m_mutex);
+    size_t nbProgress = 0;
+    const CallbackDispatcher::Event *eventLast = nullptr;
+    for(size_t i = 0; i < m_listEvents.size(); ++i){
+        EXPECT_NE(m_listThreads[i], std::this_thread::get_id());
+        if(m_listEvents[i].idType == CallbackDispatcher::EVENT_PROGRESS){
+            ++nbProgress;
+            eventLast = &m_listEvents[i];
+        }
+    }
+
+    EXPECT_LT(nbProgress, NB_PROGRESS);
+    ASSERT_NE(eventLast, nullptr);
+    EXPECT_EQ(eventLast->progress.sizeCurrent, progressLast.sizeCurrent);
+}
+
+TEST_F(CallbackDispatcherTest, dispatchExecutor)
+{
+    std::vector<std::function<void()>> listTasks;
+
+    CallbackDispatcher dispatcher(createHandler());
+    dispatcher.configure(TransferManager::DISPATCH_EXECUTOR, [&listTasks](std::function<void()> task){
+        listTasks.push_back(std::move(task));
+    });
+
+    /* One task is scheduled at a time */
+    postTerminals(dispatcher, 0, 600);
+    ASSERT_EQ(listTasks.size(), 1);
+    EXPECT_TRUE(m_listEvents.empty());
+
+    listTasks[0]();
+    postTerminals(dispatcher, 600, 3);
+    ASSERT_EQ(listTasks.size(), 2);
+    listTasks[1]();
+
+    const auto listTerminals = getTerminals();
+    ASSERT_EQ(listTerminals.size(), 603);
+    for(int i = 0; i < 603; ++i){
+        ASSERT_TRUE(matchTerminal(listTerminals[i], i)) << i;
+    }
+
+    /* Tasks executed once dispatcher is stopped do nothing */
+    postTerminals(dispatcher, 0, 1);
+    ASSERT_EQ(listTasks.size(), 3);
+
+    dispatcher.stop();
+    listTasks[2]();
+    EXPECT_EQ(getTerminals().size(), 603);
+}
@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include "net/concurrencycontroller.h"
+
+using ConcurrencyController = tease::ConcurrencyController;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+static const std::string HOST = "example.com";
+
+static int getLimit(const ConcurrencyController &controller, const std::string &host)
+{
+    for(const auto &stats : controller.getStats()){
+        if(stats.host == host){
+            return stats.nbMaxActive;
+        }
+    }
+
+    return -1;
+}
+
+static int acquireAll(ConcurrencyController &controller, const std::string &host, int nbMax)
+{
+    int nbAcquired = 0;
+    while(nbAcquired < nbMax && controller.tryAcquire(host)){
+        ++nbAcquired;
+    }
+
+    return nbAcquired;
+}
+
+/*****************************/
+/* Tests - Fixed limit       */
+/*****************************/
+
+TEST(ConcurrencyControllerTest, fixedLimit)
+{
+    ConcurrencyController controller;
+    controller.configure(false, 2);
+
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 2);
+    EXPECT_TRUE(controller.tryAcquire("other.com"));
+
+    controller.release(HOST);
+    EXPECT_TRUE(controller.tryAcquire(HOST));
+    EXPECT_FALSE(controller.tryAcquire(HOST));
+
+    controller.resetActive();
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 2);
+}
+
+TEST(ConcurrencyControllerTest, noLimit)
+{
+    ConcurrencyController controller;
+    controller.configure(false, 0);
+
+    EXPECT_EQ(acquireAll(controller, HOST, 100), 100);
+    EXPECT_EQ(getLimit(controller, HOST), 0);
+}
+
+/*****************************/
+/* Tests - Adaptive limit    */
+/*****************************/
+
+TEST(ConcurrencyControllerTest, adaptiveSlowStart)
+{
+    ConcurrencyController controller;
+    controller.configure(true, 0);
+
+    /* Initial limit */
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 2);
+    controller.resetActive();
+
+    /* Each success increase limit by one */
+    for(int i = 0; i < 3; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 5);
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 5);
+}
+
+TEST(ConcurrencyControllerTest, adaptiveMultiplicativeDecrease)
+{
+    ConcurrencyController controller;
+    controller.configure(true, 0);
+
+    for(int i = 0; i < 6; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 8);
+
+    /* Failure divide limit by two and stop slow-start */
+    controller.registerFailure(HOST);
+    EXPECT_EQ(getLimit(controller, HOST), 4);
+
+    /* Additive increase: about one more transfer per round of transfers */
+    for(int i = 0; i < 4; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 4);
+
+    for(int i = 0; i < 2; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 5);
+
+    /* Limit never goes below one */
+    for(int i = 0; i < 10; ++i){
+        controller.registerFailure(HOST);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 1);
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 1);
+}
+
+TEST(ConcurrencyControllerTest, adaptiveLatencyGradient)
+{
+    ConcurrencyController controller;
+    controller.configure(true, 0);
+
+    for(int i = 0; i < 8; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 10);
+
+    /* Time to first byte much higher than best observed one */
+    controller.registerSuccess(HOST, 0.5, 0.6, 1000);
+    EXPECT_EQ(getLimit(controller, HOST), 9);
+}
+
+TEST(ConcurrencyControllerTest, adaptiveMaximum)
+{
+    ConcurrencyController controller;
+    controller.configure(true, 4);
+
+    for(int i = 0; i < 20; ++i){
+        controller.registerSuccess(HOST, 0.01, 0.1, 1000);
+    }
+    EXPECT_EQ(getLimit(controller, HOST), 4);
+    EXPECT_EQ(acquireAll(controller, HOST, 10), 4);
+}
+
+/*****************************/
+/* Tests - Statistics        */
+/*****************************/
+
+TEST(ConcurrencyControllerTest, statistics)
+{
+    ConcurrencyController controller;
+    controller.configure(false, 0);
+
+    EXPECT_DOUBLE_EQ(controller.getThroughput(HOST), -1.0);
+
+    controller.registerSuccess(HOST, 0.01, 0.5, 1000);
+    controller.registerFailure(HOST);
+    EXPECT_DOUBLE_EQ(controller.getThroughput(HOST), 2000.0);
+
+    const auto listStats = controller.getStats();
+    ASSERT_EQ(listStats.size(), 1);
+    EXPECT_EQ(listStats[0].host, HOST);
+    EXPECT_EQ(listStats[0].nbSucceed, 1);
+    EXPECT_EQ(listStats[0].nbFailed, 1);
+    EXPECT_EQ(listStats[0].nbActive, 0);
+}
@@ -0,0 +1,180 @@
+#include "gtest/gtest.h"
+
+#include "net/contentstore.h"
+
+#include "testshelper.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using ContentStore = tease::ContentStore;
+using MappedFile = tease::MappedFile;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class ContentStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_pathDir = std::filesystem::temp_directory_path() / ("tease-tests-contentstore-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(m_pathDir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code errId;
+        std::filesystem::remove_all(m_pathDir, errId);
+    }
+
+    std::vector<std::filesystem::path> listFiles() const
+    {
+        std::vector<std::filesystem::path> listPaths;
+        for(const auto &item : std::filesystem::directory_iterator(m_pathDir)){
+            listPaths.push_back(item.path());
+        }
+
+        return listPaths;
+    }
+
+    static void waitMtime()
+    {
+        // Files modification times may use a coarse clock
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+protected:
+    std::filesystem::path m_pathDir;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(ContentStoreTest, createKey)
+{
+    const Url url("https://example.com/file.bin");
+
+    EXPECT_EQ(ContentStore::createKey(url, ""), "url:https://example.com/file.bin");
+    EXPECT_EQ(ContentStore::createKey(url, "sha256:ABCDEF"), "digest:sha256:abcdef");
+    EXPECT_EQ(ContentStore::createKey(Url("https://other.com/file.bin"), "sha256:abcdef"), ContentStore::createKey(url, "sha256:ABCDEF"));
+}
+
+TEST_F(ContentStoreTest, disabled)
+{
+    ContentStore store;
+    EXPECT_FALSE(store.isEnabled());
+
+    BytesArray data;
+    EXPECT_FALSE(store.insert("key", BytesArray(16, 0x01)));
+    EXPECT_FALSE(store.load("key", data));
+}
+
+TEST_F(ContentStoreTest, insertAndRead)
+{
+    const BytesArray dataStored(10000, 0x3C);
+    {
+        ContentStore store;
+        store.configure(m_pathDir.string(), 0);
+        EXPECT_TRUE(store.isEnabled());
+
+        EXPECT_TRUE(store.insert("key", BytesArray(64, 0x01)));
+        EXPECT_TRUE(store.insert("key", dataStored));
+    }
+
+    /* Entry replaced atomically, no temporary file is kept */
+    const auto listPaths = listFiles();
+    ASSERT_EQ(listPaths.size(), 1);
+    EXPECT_EQ(listPaths[0].extension(), ".data");
+
+    /* Entries are kept between sessions */
+    ContentStore store;
+    store.configure(m_pathDir.string(), 0);
+
+    BytesArray data;
+    ASSERT_TRUE(store.load("key", data));
+    EXPECT_EQ(data, dataStored);
+    EXPECT_FALSE(store.load("other", data));
+
+    /* Header of the entry is not part of mapped content */
+    MappedFile file;
+    ASSERT_TRUE(store.map("key", file));
+    EXPECT_EQ(file.getSize(), dataStored.getSize());
+    EXPECT_EQ(file.toBytesArray(), dataStored);
+}
+
+TEST_F(ContentStoreTest, ignoreAlteredEntries)
+{
+    ContentStore store;
+    store.configure(m_pathDir.string(), 0);
+    ASSERT_TRUE(store.insert("key", BytesArray(128, 0x7E)));
+
+    /* Entry doesn't start with header of its key anymore */
+    const auto listPaths = listFiles();
+    ASSERT_EQ(listPaths.size(), 1);
+    {
+        std::ofstream outFile(listPaths[0], std::ios::in | std::ios::out | std::ios::binary);
+        outFile.seekp(12);
+        outFile.put('X');
+    }
+
+    BytesArray data;
+    MappedFile file;
+    EXPECT_FALSE(store.load("key", data));
+    EXPECT_FALSE(store.map("key", file));
+}
+
+TEST_F(ContentStoreTest, evictLeastRecentlyUsed)
+{
+    /* Each entry use 1016 bytes (header of 16 bytes) */
+    ContentStore store;
+    store.configure(m_pathDir.string(), 3100);
+
+    for(const std::string key : {"key1", "key2", "key3"}){
+        ASSERT_TRUE(store.insert(key, BytesArray(1000, 0x01)));
+        waitMtime();
+    }
+
+    BytesArray data;
+    ASSERT_TRUE(store.load("key1", data));
+    waitMtime();
+
+    ASSERT_TRUE(store.insert("key4", BytesArray(1000, 0x02)));
+    EXPECT_EQ(listFiles().size(), 3);
+
+    EXPECT_TRUE(store.load("key1", data));
+    EXPECT_FALSE(store.load("key2", data));
+    EXPECT_TRUE(store.load("key3", data));
+    EXPECT_TRUE(store.load("key4", data));
+
+    /* Entries bigger than store are never inserted */
+    EXPECT_FALSE(store.insert("key5", BytesArray(4000, 0x03)));
+    EXPECT_FALSE(store.load("key5", data));
+}
+
+TEST_F(ContentStoreTest, evictAtConfiguration)
+{
+    {
+        ContentStore store;
+        store.configure(m_pathDir.string(), 0);
+
+        for(const std::string key : {"key1", "key2", "key3"}){
+            ASSERT_TRUE(store.insert(key, BytesArray(1000, 0x01)));
+            waitMtime();
+        }
+    }
+
+    /* Existing entries are indexed, oldest ones are removed */
+    ContentStore store;
+    store.configure(m_pathDir.string(), 2100);
+    EXPECT_EQ(listFiles().size(), 2);
+
+    BytesArray data;
+    EXPECT_FALSE(store.load("key1", data));
+    EXPECT_TRUE(store.load("key2", data));
+    EXPECT_TRUE(store.load("key3", data));
+}
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+
+#include "net/directorycache.h"
+
+#include "testshelper.h"
+
+using DirectoryCache = tease::DirectoryCache;
+
+/*****************************/
+/* Tests - Keys              */
+/*****************************/
+
+TEST(DirectoryCacheTest, createKey)
+{
+    EXPECT_EQ(DirectoryCache::createKey(Url("ftp://example.com/dir1/dir2/file.bin")), "ftp://example.com:21/dir1/dir2/");
+    EXPECT_EQ(DirectoryCache::createKey(Url("ftps://example.com:2121/file.bin")), "ftps://example.com:2121/");
+
+    /* Equivalent URLs share the same key */
+    EXPECT_EQ(DirectoryCache::createKey(Url("ftp://example.com/dir/file1.bin")), DirectoryCache::createKey(Url("ftp://example.com:21/dir/file2.bin")));
+}
+
+/*****************************/
+/* Tests - Known directories */
+/*****************************/
+
+TEST(DirectoryCacheTest, insertAndRemove)
+{
+    DirectoryCache cache;
+
+    const Url url("ftp://example.com/dir/file1.bin");
+    EXPECT_FALSE(cache.contains(url));
+
+    cache.insert(url);
+    EXPECT_TRUE(cache.contains(url));
+    EXPECT_TRUE(cache.contains(Url("ftp://example.com/dir/file2.bin")));
+    EXPECT_FALSE(cache.contains(Url("ftp://example.com/dir/sub/file1.bin")));
+    EXPECT_FALSE(cache.contains(Url("ftp://other.com/dir/file1.bin")));
+
+    cache.remove(Url("ftp://example.com/dir/file2.bin"));
+    EXPECT_FALSE(cache.contains(url));
+
+    cache.insert(url);
+    cache.clear();
+    EXPECT_FALSE(cache.contains(url));
+}
+
+TEST(DirectoryCacheTest, listMissing)
+{
+    DirectoryCache cache;
+    cache.insert(Url("ftp://example.com/known/file.bin"));
+
+    const std::vector<Url> listUrls = {
+        Url("ftp://example.com/known/file1.bin"),
+        Url("ftp://example.com/dir1/file1.bin"),
+        Url("ftp://example.com/dir1/file2.bin"),
+        Url("ftp://example.com/dir1/dir2/file1.bin"),
+        Url("ftp://example.com:21/dir1/file3.bin")
+    };
+
+    /* One file per unknown directory, in order of appearance */
+    const std::vector<Url> listMissing = cache.listMissing(listUrls);
+    ASSERT_EQ(listMissing.size(), 2);
+    EXPECT_EQ(listMissing[0].toString(), "ftp://example.com/dir1/file1.bin");
+    EXPECT_EQ(listMissing[1].toString(), "ftp://example.com/dir1/dir2/file1.bin");
+}
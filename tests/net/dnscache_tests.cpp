@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include "net/dnscache.h"
+
+#include "testshelper.h"
+
+using DnsCache = tease::DnsCache;
+
+/*****************************/
+/* Tests - Effective port    */
+/*****************************/
+
+TEST(DnsCacheTest, portEffective)
+{
+    EXPECT_EQ(DnsCache::getPortEffective(Url("http://example.com/file.bin")), 80);
+    EXPECT_EQ(DnsCache::getPortEffective(Url("https://example.com/file.bin")), 443);
+    EXPECT_EQ(DnsCache::getPortEffective(Url("ftp://example.com/file.bin")), 21);
+    EXPECT_EQ(DnsCache::getPortEffective(Url("ftps://example.com/file.bin")), 990);
+    EXPECT_EQ(DnsCache::getPortEffective(Url("http://example.com:8080/file.bin")), 8080);
+}
+
+/*****************************/
+/* Tests - Resolution        */
+/*****************************/
+
+TEST(DnsCacheTest, resolveHosts)
+{
+    DnsCache cache;
+
+    /* Same host and port is resolved once */
+    const Url url("http://localhost:8080/file1.bin");
+    EXPECT_EQ(cache.resolve({url, Url("http://localhost:8080/file2.bin")}, 0), 1);
+
+    const std::string entry = cache.getResolveEntry(url);
+    EXPECT_EQ(entry.rfind("+localhost:8080:", 0), 0);
+    EXPECT_GT(entry.size(), std::string("+localhost:8080:").size());
+
+    /* Entries are specific to a port */
+    EXPECT_TRUE(cache.getResolveEntry(Url("http://localhost:8081/file1.bin")).empty());
+    EXPECT_EQ(cache.getResolveEntry(Url("http://localhost:8080/other.bin")), entry);
+}
+
+TEST(DnsCacheTest, ignoreAddresses)
+{
+    DnsCache cache;
+
+    const Url urlV4("http://127.0.0.1:8080/file.bin");
+    const Url urlV6("http://[::1]:8080/file.bin");
+    EXPECT_EQ(cache.resolve({urlV4, urlV6}, 0), 0);
+
+    EXPECT_TRUE(cache.getResolveEntry(urlV4).empty());
+    EXPECT_TRUE(cache.getResolveEntry(urlV6).empty());
+}
+
+TEST(DnsCacheTest, entriesExpire)
+{
+    DnsCache cache;
+    cache.setTimeout(0);
+    EXPECT_EQ(cache.getTimeout(), 0);
+
+    const Url url("http://localhost:8080/file.bin");
+    EXPECT_EQ(cache.resolve({url}, 0), 1);
+    EXPECT_TRUE(cache.getResolveEntry(url).empty());
+
+    /* Negative values disable the cache */
+    cache.setTimeout(-5);
+    EXPECT_EQ(cache.getTimeout(), 0);
+}
@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+
+#include "net/ftphelper.h"
+
+using FtpHelper = tease::FtpHelper;
+using TransferManager = tease::TransferManager;
+
+/*****************************/
+/* Tests - File method       */
+/*****************************/
+
+TEST(FtpHelperTest, defaultMethod)
+{
+    /* Curl default is kept unless caller opts in for another method */
+    TransferManager manager;
+    EXPECT_EQ(manager.getFtpMethod(), TransferManager::FTP_METHOD_MULTICWD);
+    EXPECT_EQ(FtpHelper::getFileMethod(manager.getFtpMethod(), false), CURLFTPMETHOD_MULTICWD);
+}
+
+TEST(FtpHelperTest, configuredMethod)
+{
+    EXPECT_EQ(FtpHelper::getFileMethod(TransferManager::FTP_METHOD_MULTICWD, false), CURLFTPMETHOD_MULTICWD);
+    EXPECT_EQ(FtpHelper::getFileMethod(TransferManager::FTP_METHOD_AUTO, false), CURLFTPMETHOD_SINGLECWD);
+    EXPECT_EQ(FtpHelper::getFileMethod(TransferManager::FTP_METHOD_SINGLECWD, false), CURLFTPMETHOD_SINGLECWD);
+    EXPECT_EQ(FtpHelper::getFileMethod(TransferManager::FTP_METHOD_NOCWD, false), CURLFTPMETHOD_NOCWD);
+}
+
+TEST(FtpHelperTest, createDirectories)
+{
+    /* Missing directories can only be created one by one */
+    for(auto method : {TransferManager::FTP_METHOD_MULTICWD, TransferManager::FTP_METHOD_AUTO, TransferManager::FTP_METHOD_SINGLECWD, TransferManager::FTP_METHOD_NOCWD}){
+        EXPECT_EQ(FtpHelper::getFileMethod(method, true), CURLFTPMETHOD_MULTICWD) << method;
+    }
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include "net/handletemplates.h"
+
+using HandleTemplates = tease::HandleTemplates;
+using Request = tease::Request;
+using Url = tease::Url;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class HandleTemplatesTest : public ::testing::Test
+{
+protected:
+    /* Each template is tagged with the number of configured templates */
+    void configure(CURL *handle, Url::IdScheme, Request::TypeTransfer)
+    {
+        ++m_nbConfigured;
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, reinterpret_cast<void*>(static_cast<intptr_t>(m_nbConfigured)));
+    }
+
+    CURL* createHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer)
+    {
+        return m_templates.createHandle(idScheme, typeTransfer, m_templates.getGeneration(), m_fctConfigure);
+    }
+
+    CURL* acquireHandle(Url::IdScheme idScheme, Request::TypeTransfer typeTransfer, int &generation)
+    {
+        generation = m_templates.getGeneration();
+        return m_templates.acquireHandle(idScheme, typeTransfer, generation, m_fctConfigure);
+    }
+
+    static intptr_t getTag(CURL *handle)
+    {
+        char *tag = nullptr;
+        curl_easy_getinfo(handle, CURLINFO_PRIVATE, &tag);
+
+        return reinterpret_cast<intptr_t>(tag);
+    }
+
+protected:
+    HandleTemplates m_templates;
+    HandleTemplates::FctConfigure m_fctConfigure = [this](CURL *handle, Url::IdScheme idScheme, Request::TypeTransfer typeTransfer){
+        configure(handle, idScheme, typeTransfer);
+    };
+    int m_nbConfigured = 0;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(HandleTemplatesTest, createHandles)
+{
+    /* Template is configured once, then cloned */
+    CURL *handle1 = createHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD);
+    CURL *handle2 = createHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD);
+    ASSERT_NE(handle1, nullptr);
+    ASSERT_NE(handle2, nullptr);
+    EXPECT_NE(handle1, handle2);
+    EXPECT_EQ(m_nbConfigured, 1);
+    EXPECT_EQ(getTag(handle1), 1);
+    EXPECT_EQ(getTag(handle2), 1);
+
+    /* Each scheme and type of transfer has its own template */
+    CURL *handle3 = createHandle(Url::SCHEME_HTTP, Request::TRANSFER_UPLOAD);
+    CURL *handle4 = createHandle(Url::SCHEME_FTP, Request::TRANSFER_DOWNLOAD);
+    EXPECT_EQ(m_nbConfigured, 3);
+    EXPECT_EQ(getTag(handle3), 2);
+    EXPECT_EQ(getTag(handle4), 3);
+
+    for(CURL *handle : {handle1, handle2, handle3, handle4}){
+        curl_easy_cleanup(handle);
+    }
+}
+
+TEST_F(HandleTemplatesTest, reuseIdleHandles)
+{
+    int generation1 = -1, generation2 = -1;
+    CURL *handle1 = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation1);
+    ASSERT_NE(handle1, nullptr);
+
+    /* Handle given back is used again by same scheme and type of transfer only */
+    m_templates.releaseHandle(handle1, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation1);
+
+    CURL *handleOther = acquireHandle(Url::SCHEME_HTTPS, Request::TRANSFER_DOWNLOAD, generation2);
+    EXPECT_NE(handleOther, handle1);
+    m_templates.releaseHandle(handleOther, Url::SCHEME_HTTPS, Request::TRANSFER_DOWNLOAD, generation2);
+
+    CURL *handle2 = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation2);
+    EXPECT_EQ(handle2, handle1);
+    EXPECT_EQ(generation2, generation1);
+    EXPECT_EQ(m_nbConfigured, 2);
+
+    /* Idle handles are used one at a time */
+    int generation3 = -1;
+    CURL *handle3 = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation3);
+    EXPECT_NE(handle3, handle2);
+
+    m_templates.releaseHandle(handle2, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation2);
+    m_templates.releaseHandle(handle3, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation3);
+}
+
+TEST_F(HandleTemplatesTest, invalidate)
+{
+    int generationOld = -1;
+    CURL *handleIdle = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld);
+    CURL *handleBusy = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld);
+    m_templates.releaseHandle(handleIdle, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld);
+
+    /* Templates are configured again, idle handles are dropped */
+    m_templates.invalidate();
+
+    int generationNew = -1;
+    CURL *handleNew = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationNew);
+    EXPECT_NE(generationNew, generationOld);
+    EXPECT_EQ(m_nbConfigured, 2);
+    EXPECT_EQ(getTag(handleNew), 2);
+
+    /* Handles using outdated configuration are never used again */
+    m_templates.releaseHandle(handleBusy, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld);
+    m_templates.releaseHandle(handleNew, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationNew);
+
+    int generation = -1;
+    for(int i = 0; i < 2; ++i){
+        CURL *handle = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generation);
+        EXPECT_EQ(getTag(handle), 2) << i;
+        EXPECT_EQ(generation, generationNew) << i;
+        curl_easy_cleanup(handle);
+    }
+}
+
+TEST_F(HandleTemplatesTest, outdatedConfiguration)
+{
+    /* Configuration retrieved before an invalidation is used for the handle only */
+    const int generationOld = m_templates.getGeneration();
+    m_templates.invalidate();
+
+    CURL *handleOld = m_templates.createHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld, m_fctConfigure);
+    ASSERT_NE(handleOld, nullptr);
+    EXPECT_EQ(getTag(handleOld), 1);
+
+    int generationAcquired = -1;
+    CURL *handleAcquired = m_templates.acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld, m_fctConfigure);
+    EXPECT_EQ(getTag(handleAcquired), 2);
+    m_templates.releaseHandle(handleAcquired, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationOld);
+
+    /* Template is built from current configuration */
+    CURL *handleNew = acquireHandle(Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationAcquired);
+    EXPECT_NE(handleNew, handleAcquired);
+    EXPECT_EQ(getTag(handleNew), 3);
+    EXPECT_EQ(m_nbConfigured, 3);
+
+    curl_easy_cleanup(handleOld);
+    m_templates.releaseHandle(handleNew, Url::SCHEME_HTTP, Request::TRANSFER_DOWNLOAD, generationAcquired);
+}
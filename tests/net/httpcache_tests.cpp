@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+
+#include "net/httpcache.h"
+
+#include "testshelper.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using HttpCache = tease::HttpCache;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class HttpCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_pathDir = std::filesystem::temp_directory_path() / ("tease-tests-httpcache-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(m_pathDir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code errId;
+        std::filesystem::remove_all(m_pathDir, errId);
+    }
+
+    static HttpCache::Validators createValidators(const std::string &etag, const std::string &lastModified)
+    {
+        HttpCache::Validators validators;
+        validators.etag = etag;
+        validators.lastModified = lastModified;
+
+        return validators;
+    }
+
+    std::vector<std::filesystem::path> listFiles() const
+    {
+        std::vector<std::filesystem::path> listPaths;
+        for(const auto &item : std::filesystem::directory_iterator(m_pathDir)){
+            listPaths.push_back(item.path());
+        }
+
+        return listPaths;
+    }
+
+    static void waitMtime()
+    {
+        // Files modification times may use a coarse clock
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+protected:
+    std::filesystem::path m_pathDir;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(HttpCacheTest, disabled)
+{
+    HttpCache cache;
+    EXPECT_FALSE(cache.isEnabled());
+
+    cache.store("http://example.com/file.bin", createValidators("\"v1\"", ""), BytesArray(16, 0x01));
+
+    HttpCache::Validators validators;
+    BytesArray body;
+    EXPECT_FALSE(cache.getValidators("http://example.com/file.bin", validators));
+    EXPECT_FALSE(cache.load("http://example.com/file.bin", body));
+}
+
+TEST_F(HttpCacheTest, storeInMemory)
+{
+    HttpCache cache;
+    cache.configure("", true);
+    EXPECT_TRUE(cache.isEnabled());
+
+    const std::string key = "http://example.com/file.bin";
+    const BytesArray bodyStored(64, 0x42);
+    cache.store(key, createValidators("\"v1\"", "Wed, 21 Oct 2015 07:28:00 GMT"), bodyStored);
+
+    HttpCache::Validators validators;
+    ASSERT_TRUE(cache.getValidators(key, validators));
+    EXPECT_EQ(validators.etag, "\"v1\"");
+    EXPECT_EQ(validators.lastModified, "Wed, 21 Oct 2015 07:28:00 GMT");
+
+    BytesArray body;
+    ASSERT_TRUE(cache.load(key, body));
+    EXPECT_EQ(body, bodyStored);
+
+    /* Responses without validators can't be revalidated */
+    cache.store(key, createValidators("", ""), bodyStored);
+    EXPECT_FALSE(cache.getValidators(key, validators));
+
+    /* Configuring cache clear entries kept in memory */
+    cache.store(key, createValidators("\"v1\"", ""), bodyStored);
+    cache.configure("", true);
+    EXPECT_FALSE(cache.getValidators(key, validators));
+}
+
+TEST_F(HttpCacheTest, storeOnDisk)
+{
+    const std::string key = "http://example.com/dir/file.bin";
+    const BytesArray bodyStored(4096, 0x24);
+    {
+        HttpCache cache;
+        cache.configure(m_pathDir.string(), false);
+        cache.store(key, createValidators("\"v2\"", ""), bodyStored);
+    }
+
+    /* Entries are kept between sessions */
+    HttpCache cache;
+    cache.configure(m_pathDir.string(), false);
+
+    HttpCache::Validators validators;
+    ASSERT_TRUE(cache.getValidators(key, validators));
+    EXPECT_EQ(validators.etag, "\"v2\"");
+    EXPECT_TRUE(validators.lastModified.empty());
+
+    BytesArray body;
+    ASSERT_TRUE(cache.load(key, body));
+    EXPECT_EQ(body, bodyStored);
+
+    EXPECT_FALSE(cache.getValidators("http://example.com/dir/other.bin", validators));
+
+    cache.remove(key);
+    EXPECT_FALSE(cache.getValidators(key, validators));
+    EXPECT_FALSE(cache.load(key, body));
+}
+
+TEST_F(HttpCacheTest, ignoreAlteredEntries)
+{
+    HttpCache cache;
+    cache.configure(m_pathDir.string(), false);
+
+    const std::string key = "http://example.com/file.bin";
+    cache.store(key, createValidators("\"v1\"", ""), BytesArray(128, 0x7E));
+
+    /* Body doesn't match its digest anymore */
+    const auto listPaths = listFiles();
+    ASSERT_EQ(listPaths.size(), 1);
+    {
+        std::ofstream outFile(listPaths[0], std::ios::in | std::ios::out | std::ios::binary);
+        outFile.seekp(-1, std::ios::end);
+        outFile.put('X');
+    }
+
+    HttpCache::Validators validators;
+    BytesArray body;
+    EXPECT_TRUE(cache.getValidators(key, validators));
+    EXPECT_FALSE(cache.load(key, body));
+    EXPECT_TRUE(body.isEmpty());
+}
+
+TEST_F(HttpCacheTest, evictFromMemory)
+{
+    HttpCache cache;
+    cache.configure("", true, 3100);
+
+    for(const std::string key : {"key1", "key2", "key3"}){
+        cache.store(key, createValidators("\"v1\"", ""), BytesArray(1000, 0x01));
+    }
+
+    BytesArray body;
+    ASSERT_TRUE(cache.load("key1", body));
+
+    cache.store("key4", createValidators("\"v1\"", ""), BytesArray(1000, 0x02));
+
+    HttpCache::Validators validators;
+    EXPECT_TRUE(cache.getValidators("key1", validators));
+    EXPECT_FALSE(cache.getValidators("key2", validators));
+    EXPECT_TRUE(cache.getValidators("key3", validators));
+    EXPECT_TRUE(cache.getValidators("key4", validators));
+
+    /* Entries bigger than cache are never stored, previous one is removed */
+    cache.store("key4", createValidators("\"v2\"", ""), BytesArray(4000, 0x03));
+    EXPECT_FALSE(cache.getValidators("key4", validators));
+    EXPECT_TRUE(cache.getValidators("key3", validators));
+}
+
+TEST_F(HttpCacheTest, evictFromDisk)
+{
+    /* Each entry use less than 1100 bytes (header included) */
+    HttpCache cache;
+    cache.configure(m_pathDir.string(), false, 3400);
+
+    for(const std::string key : {"key1", "key2", "key3"}){
+        cache.store(key, createValidators("\"v1\"", ""), BytesArray(1000, 0x01));
+        waitMtime();
+    }
+
+    BytesArray body;
+    ASSERT_TRUE(cache.load("key1", body));
+    waitMtime();
+
+    cache.store("key4", createValidators("\"v1\"", ""), BytesArray(1000, 0x02));
+    EXPECT_EQ(listFiles().size(), 3);
+
+    EXPECT_TRUE(cache.load("key1", body));
+    EXPECT_FALSE(cache.load("key2", body));
+    EXPECT_TRUE(cache.load("key3", body));
+    EXPECT_TRUE(cache.load("key4", body));
+
+    cache.store("key5", createValidators("\"v1\"", ""), BytesArray(4000, 0x03));
+    EXPECT_FALSE(cache.load("key5", body));
+    EXPECT_EQ(listFiles().size(), 3);
+}
+
+TEST_F(HttpCacheTest, storableResponses)
+{
+    EXPECT_TRUE(HttpCache::isStorable(""));
+    EXPECT_TRUE(HttpCache::isStorable("max-age=3600"));
+    EXPECT_TRUE(HttpCache::isStorable("public, no-cache"));
+
+    EXPECT_FALSE(HttpCache::isStorable("no-store"));
+    EXPECT_FALSE(HttpCache::isStorable("max-age=0, No-Store"));
+    EXPECT_FALSE(HttpCache::isStorable("private"));
+    EXPECT_FALSE(HttpCache::isStorable(" private=\"Set-Cookie\", max-age=60"));
+}
+
+TEST_F(HttpCacheTest, statistics)
+{
+    HttpCache cache;
+
+    cache.registerMiss(false);
+    cache.registerMiss(true);
+    cache.registerHit(100);
+    cache.registerHit(50);
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(stats.nbHits, 2);
+    EXPECT_EQ(stats.nbMisses, 2);
+    EXPECT_EQ(stats.nbRevalidations, 3);
+    EXPECT_EQ(stats.nbBytesSaved, 150);
+}
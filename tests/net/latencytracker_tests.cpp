@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+
+#include "net/latencytracker.h"
+
+using LatencyTracker = tease::LatencyTracker;
+
+/*****************************/
+/* Tests - Percentiles       */
+/*****************************/
+
+TEST(LatencyTrackerTest, empty)
+{
+    const LatencyTracker tracker(10);
+
+    EXPECT_EQ(tracker.getNbSamples(), 0);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(50.0), 0.0);
+}
+
+TEST(LatencyTrackerTest, nearestRank)
+{
+    LatencyTracker tracker(100);
+    for(int i = 100; i >= 1; --i){
+        tracker.addSample(i / 100.0);
+    }
+
+    EXPECT_EQ(tracker.getNbSamples(), 100);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(0.0), 0.01);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(50.0), 0.50);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(95.0), 0.95);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(100.0), 1.00);
+
+    // Out of range percentiles are clamped
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(-5.0), 0.01);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(150.0), 1.00);
+}
+
+TEST(LatencyTrackerTest, oldestSamplesReplaced)
+{
+    LatencyTracker tracker(4);
+    for(double latency : {10.0, 20.0, 30.0, 40.0}){
+        tracker.addSample(latency);
+    }
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(100.0), 40.0);
+
+    /* Only latest samples are kept */
+    for(double latency : {1.0, 2.0, 3.0}){
+        tracker.addSample(latency);
+    }
+
+    EXPECT_EQ(tracker.getNbSamples(), 4);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(75.0), 3.0);
+    EXPECT_DOUBLE_EQ(tracker.getPercentile(100.0), 40.0);
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+
+#include "net/progressaggregator.h"
+
+#include <thread>
+
+using ProgressAggregator = tease::ProgressAggregator;
+using Request = tease::Request;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+static Request::List createRequests(size_t nbReqs)
+{
+    Request::List listReqs;
+    for(size_t i = 0; i < nbReqs; ++i){
+        listReqs.push_back(std::make_shared<Request>());
+    }
+
+    return listReqs;
+}
+
+/*****************************/
+/* Tests - Totals            */
+/*****************************/
+
+TEST(ProgressAggregatorTest, reset)
+{
+    Request::List listReqs = createRequests(3);
+    listReqs[0]->ioSetSizeTotal(100);
+    listReqs[0]->ioSetSizeCurrent(40);
+    listReqs[1]->ioSetSizeTotal(300);
+    listReqs[1]->ioSetSizeCurrent(10);
+
+    /* Unknown sizes are estimated with biggest known size */
+    ProgressAggregator aggregator;
+    aggregator.reset(listReqs);
+
+    const auto progress = aggregator.getProgress();
+    EXPECT_EQ(progress.sizeTotal, 700);
+    EXPECT_EQ(progress.sizeCurrent, 50);
+
+    aggregator.reset({});
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 0);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 0);
+}
+
+TEST(ProgressAggregatorTest, update)
+{
+    Request::List listReqs = createRequests(2);
+
+    ProgressAggregator aggregator;
+    aggregator.reset(listReqs);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 0);
+
+    /* Sizes of requests are updated too */
+    aggregator.update(*listReqs[0], 1000, 200);
+    EXPECT_EQ(listReqs[0]->ioGetSizeTotal(), 1000);
+    EXPECT_EQ(listReqs[0]->ioGetSizeCurrent(), 200);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 2000);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 200);
+
+    aggregator.update(*listReqs[1], 500, 500);
+    aggregator.update(*listReqs[0], 1000, 1000);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 1500);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 1500);
+
+    /* Sizes can decrease, and become unknown again */
+    aggregator.update(*listReqs[1], 0, 0);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 2000);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 1000);
+}
+
+TEST(ProgressAggregatorTest, remove)
+{
+    Request::List listReqs = createRequests(2);
+    listReqs[0]->ioSetSizeExpected(800);
+
+    ProgressAggregator aggregator;
+    aggregator.reset(listReqs);
+
+    aggregator.update(*listReqs[0], 1000, 600);
+    aggregator.update(*listReqs[1], 400, 400);
+
+    /* Request falls back to its expected size */
+    aggregator.remove(*listReqs[0]);
+    EXPECT_EQ(listReqs[0]->ioGetSizeTotal(), 800);
+    EXPECT_EQ(listReqs[0]->ioGetSizeCurrent(), 0);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 1200);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 400);
+
+    /* Biggest size ever known is used as estimation */
+    aggregator.remove(*listReqs[1]);
+    EXPECT_EQ(aggregator.getProgress().sizeTotal, 1800);
+    EXPECT_EQ(aggregator.getProgress().sizeCurrent, 0);
+}
+
+TEST(ProgressAggregatorTest, concurrentUpdates)
+{
+    constexpr size_t NB_THREADS = 4;
+    constexpr size_t NB_REQS_PER_THREAD = 50;
+    constexpr size_t SIZE_REQ = 10000;
+
+    Request::List listReqs = createRequests(NB_THREADS * NB_REQS_PER_THREAD);
+
+    ProgressAggregator aggregator;
+    aggregator.reset(listReqs);
+
+    /* Each request is updated by a single thread */
+    std::vector<std::thread> listThreads;
+    for(size_t idThread = 0; idThread < NB_THREADS; ++idThread){
+        listThreads.emplace_back([&, idThread](){
+            for(size_t i = 0; i < NB_REQS_PER_THREAD; ++i){
+                Request &req = *listReqs[idThread * NB_REQS_PER_THREAD + i];
+                for(size_t size = 0; size <= SIZE_REQ; size += 1000){
+                    aggregator.update(req, SIZE_REQ, size);
+
+                    const auto progress = aggregator.getProgress();
+                    EXPECT_LE(progress.sizeCurrent, progress.sizeTotal);
+                }
+            }
+        });
+    }
+
+    for(std::thread &thread : listThreads){
+        thread.join();
+    }
+
+    const auto progress = aggregator.getProgress();
+    EXPECT_EQ(progress.sizeTotal, listReqs.size() * SIZE_REQ);
+    EXPECT_EQ(progress.sizeCurrent, listReqs.size() * SIZE_REQ);
+}
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+
+#include "net/requestscheduler.h"
+
+#include "testshelper.h"
+
+using Request = tease::Request;
+using RequestScheduler = tease::RequestScheduler;
+using TransferManager = tease::TransferManager;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+static Request::PtrShared createDownload(const std::string &url, size_t size = 0, Request::TimePoint deadline = Request::TimePoint::max())
+{
+    Request::PtrShared req = std::make_shared<Request>();
+    req->configureDownload(Url(url));
+    req->ioSetSizeExpected(size);
+    req->setDeadline(deadline);
+
+    return req;
+}
+
+static std::vector<size_t> getSizes(const Request::List &listReqs)
+{
+    std::vector<size_t> listSizes;
+    for(const auto &req : listReqs){
+        listSizes.push_back(req->getTypeTransfer() == Request::TRANSFER_UPLOAD ? req->getData().getSize() : req->ioGetSizeExpected());
+    }
+
+    return listSizes;
+}
+
+static std::vector<std::string> getUrls(const Request::List &listReqs)
+{
+    std::vector<std::string> listUrls;
+    for(const auto &req : listReqs){
+        listUrls.push_back(req->getUrl().toString());
+    }
+
+    return listUrls;
+}
+
+/*****************************/
+/* Tests - Grouping          */
+/*****************************/
+
+TEST(RequestSchedulerTest, groupByHostAndDirectory)
+{
+    Request::List listReqs = {
+        createDownload("ftp://host-b.com/dir1/file1.bin"),
+        createDownload("ftp://host-a.com/dir2/file1.bin"),
+        createDownload("ftp://host-b.com/dir2/file1.bin"),
+        createDownload("ftp://host-a.com/dir1/file1.bin"),
+        createDownload("ftp://host-b.com/dir1/file2.bin"),
+        createDownload("ftp://host-a.com/dir2/file2.bin"),
+        createDownload("ftp://host-a.com/file.bin")
+    };
+
+    /* Files of a directory keep their relative order */
+    RequestScheduler::schedule(listReqs, TransferManager::SCHEDULING_GROUPED);
+
+    const std::vector<std::string> listExpected = {
+        Url("ftp://host-a.com/file.bin").toString(),
+        Url("ftp://host-a.com/dir1/file1.bin").toString(),
+        Url("ftp://host-a.com/dir2/file1.bin").toString(),
+        Url("ftp://host-a.com/dir2/file2.bin").toString(),
+        Url("ftp://host-b.com/dir1/file1.bin").toString(),
+        Url("ftp://host-b.com/dir1/file2.bin").toString(),
+        Url("ftp://host-b.com/dir2/file1.bin").toString()
+    };
+    EXPECT_EQ(getUrls(listReqs), listExpected);
+}
+
+/*****************************/
+/* Tests - Sizes             */
+/*****************************/
+
+TEST(RequestSchedulerTest, shortestFirst)
+{
+    Request::List listReqs = {
+        createDownload("http://host-a.com/file1.bin", 300),
+        createDownload("http://host-b.com/file2.bin", 100),
+        createDownload("http://host-a.com/file3.bin", 200)
+    };
+
+    RequestScheduler::schedule(listReqs, TransferManager::SCHEDULING_SHORTEST_FIRST);
+    EXPECT_EQ(getSizes(listReqs), std::vector<size_t>({100, 200, 300}));
+}
+
+TEST(RequestSchedulerTest, largestFirst)
+{
+    Request::List listReqs = {
+        createDownload("http://host-a.com/file1.bin", 100),
+        createDownload("http://host-b.com/file2.bin", 300),
+        createDownload("http://host-a.com/file3.bin", 200)
+    };
+
+    /* Uploads are ordered with size of their datas */
+    Request::PtrShared reqUpload = std::make_shared<Request>();
+    reqUpload->configureUpload(Url("http://host-c.com/file4.bin"), BytesArray(250, 0x00));
+    listReqs.push_back(reqUpload);
+
+    RequestScheduler::schedule(listReqs, TransferManager::SCHEDULING_LARGEST_FIRST);
+    EXPECT_EQ(getSizes(listReqs), std::vector<size_t>({300, 250, 200, 100}));
+}
+
+TEST(RequestSchedulerTest, unknownSizesLast)
+{
+    for(auto policy : {TransferManager::SCHEDULING_SHORTEST_FIRST, TransferManager::SCHEDULING_LARGEST_FIRST}){
+        Request::List listReqs = {
+            createDownload("http://host-a.com/unknown1.bin"),
+            createDownload("http://host-a.com/file1.bin", 200),
+            createDownload("http://host-b.com/unknown2.bin"),
+            createDownload("http://host-b.com/file2.bin", 100)
+        };
+
+        RequestScheduler::schedule(listReqs, policy);
+
+        const std::vector<size_t> listSizes = getSizes(listReqs);
+        EXPECT_NE(listSizes[0], 0) << policy;
+        EXPECT_NE(listSizes[1], 0) << policy;
+        EXPECT_EQ(listSizes[2], 0) << policy;
+        EXPECT_EQ(listSizes[3], 0) << policy;
+    }
+}
+
+/*****************************/
+/* Tests - Hosts             */
+/*****************************/
+
+TEST(RequestSchedulerTest, roundRobinHosts)
+{
+    Request::List listReqs = {
+        createDownload("http://host-a.com/file1.bin"),
+        createDownload("http://host-a.com/file2.bin"),
+        createDownload("http://host-a.com/file3.bin"),
+        createDownload("http://host-b.com/file1.bin"),
+        createDownload("http://host-c.com/file1.bin"),
+        createDownload("http://host-c.com/file2.bin")
+    };
+
+    /* Each host receive one request at a time */
+    RequestScheduler::schedule(listReqs, TransferManager::SCHEDULING_ROUND_ROBIN_HOSTS);
+
+    const std::vector<std::string> listExpected = {
+        Url("http://host-a.com/file1.bin").toString(),
+        Url("http://host-b.com/file1.bin").toString(),
+        Url("http://host-c.com/file1.bin").toString(),
+        Url("http://host-a.com/file2.bin").toString(),
+        Url("http://host-c.com/file2.bin").toString(),
+        Url("http://host-a.com/file3.bin").toString()
+    };
+    EXPECT_EQ(getUrls(listReqs), listExpected);
+}
+
+/*****************************/
+/* Tests - Deadlines         */
+/*****************************/
+
+TEST(RequestSchedulerTest, deadlinePrecedence)
+{
+    const Request::TimePoint now = Request::Clock::now();
+    const Request::TimePoint deadlineShort = now + std::chrono::seconds(10);
+    const Request::TimePoint deadlineLong = now + std::chrono::seconds(20);
+
+    /* Shorter deadline is started first, whatever the policy */
+    for(auto policy : {TransferManager::SCHEDULING_GROUPED, TransferManager::SCHEDULING_SHORTEST_FIRST, TransferManager::SCHEDULING_LARGEST_FIRST, TransferManager::SCHEDULING_ROUND_ROBIN_HOSTS}){
+        Request::List listReqs = {
+            createDownload("http://host-a.com/file1.bin", 100),
+            createDownload("http://host-a.com/file2.bin", 400, deadlineLong),
+            createDownload("http://host-b.com/file3.bin", 0, deadlineShort),
+            createDownload("http://host-a.com/file4.bin", 200, deadlineShort)
+        };
+
+        RequestScheduler::schedule(listReqs, policy);
+
+        ASSERT_EQ(listReqs.size(), 4);
+        EXPECT_EQ(listReqs[0]->getDeadline(), deadlineShort) << policy;
+        EXPECT_EQ(listReqs[1]->getDeadline(), deadlineShort) << policy;
+        EXPECT_EQ(listReqs[2]->getDeadline(), deadlineLong) << policy;
+        EXPECT_EQ(listReqs[3]->getDeadline(), Request::TimePoint::max()) << policy;
+    }
+}
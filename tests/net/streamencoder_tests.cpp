@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include "net/streamencoder.h"
+
+#include "testshelper.h"
+
+#if defined(TEASE_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+using StreamEncoder = tease::StreamEncoder;
+using TransferManager = tease::TransferManager;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+static BytesArray createDatas(size_t size)
+{
+    BytesArray datas;
+    for(size_t i = 0; i < size; ++i){
+        const uint8_t byte = static_cast<uint8_t>((i % 7 == 0) ? i * 31 : 'a' + i % 13);
+        datas.pushBack(byte);
+    }
+
+    return datas;
+}
+
+/*!
+ * \brief Encode datas by reading them and writing encoded
+ * ones through small buffers, as done by curl callbacks
+ */
+static bool encode(StreamEncoder &encoder, const BytesArray &datas, size_t sizeRead, size_t sizeWrite, BytesArray &encoded)
+{
+    size_t pos = 0;
+    const StreamEncoder::Source source = [&datas, &pos, sizeRead](char *buffer, size_t size){
+        const size_t nbCopy = std::min({size, sizeRead, datas.getSize() - pos});
+        std::copy_n(datas.dataConst() + pos, nbCopy, reinterpret_cast<uint8_t*>(buffer));
+        pos += nbCopy;
+
+        return nbCopy;
+    };
+
+    std::vector<char> buffer(sizeWrite);
+    for(;;){
+        const size_t nbRead = encoder.read(buffer.data(), buffer.size(), source);
+        if(nbRead == StreamEncoder::READ_ERROR){
+            return false;
+        }
+        if(nbRead == 0){
+            return true;
+        }
+
+        encoded.pushBack(reinterpret_cast<const uint8_t*>(buffer.data()), nbRead);
+    }
+}
+
+/*****************************/
+/* Tests - Encodings         */
+/*****************************/
+
+TEST(StreamEncoderTest, encodings)
+{
+    EXPECT_TRUE(StreamEncoder::isSupported(TransferManager::ENCODING_NONE));
+    EXPECT_EQ(StreamEncoder::create(TransferManager::ENCODING_NONE), nullptr);
+
+    EXPECT_STREQ(StreamEncoder::getName(TransferManager::ENCODING_NONE), "identity");
+    EXPECT_STREQ(StreamEncoder::getName(TransferManager::ENCODING_GZIP), "gzip");
+    EXPECT_STREQ(StreamEncoder::getName(TransferManager::ENCODING_ZSTD), "zstd");
+
+    /* Encoders are available only when supported */
+    for(const auto idEncoding : {TransferManager::ENCODING_GZIP, TransferManager::ENCODING_ZSTD}){
+        EXPECT_EQ(StreamEncoder::isSupported(idEncoding), StreamEncoder::create(idEncoding) != nullptr);
+        EXPECT_EQ(StreamEncoder::isSupported(idEncoding), TransferManager::encodingIsSupported(idEncoding));
+    }
+}
+
+/*****************************/
+/* Tests - Round-trip        */
+/*****************************/
+
+#if defined(TEASE_HAS_ZLIB)
+static bool decodeGzip(const BytesArray &encoded, BytesArray &decoded)
+{
+    z_stream stream{};
+    if(inflateInit2(&stream, 15 + 16) != Z_OK){
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(encoded.dataConst());
+    stream.avail_in = static_cast<uInt>(encoded.getSize());
+
+    int idErr = Z_OK;
+    while(idErr == Z_OK){
+        uint8_t buffer[1024];
+        stream.next_out = buffer;
+        stream.avail_out = sizeof(buffer);
+
+        idErr = inflate(&stream, Z_NO_FLUSH);
+        decoded.pushBack(buffer, sizeof(buffer) - stream.avail_out);
+    }
+
+    inflateEnd(&stream);
+    return idErr == Z_STREAM_END && stream.avail_in == 0;
+}
+
+struct DataRoundTrip
+{
+    size_t sizeDatas;
+    size_t sizeRead;
+    size_t sizeWrite;
+};
+
+class TestStreamEncoderGzip : public ::testing::TestWithParam<DataRoundTrip>{};
+
+TEST_P(TestStreamEncoderGzip, roundTrip)
+{
+    const auto &params = GetParam();
+
+    auto encoder = StreamEncoder::create(TransferManager::ENCODING_GZIP);
+    ASSERT_NE(encoder, nullptr);
+
+    const BytesArray datas = createDatas(params.sizeDatas);
+    BytesArray encoded;
+    ASSERT_TRUE(encode(*encoder, datas, params.sizeRead, params.sizeWrite, encoded));
+
+    EXPECT_EQ(encoder->getSizeIn(), datas.getSize());
+    EXPECT_EQ(encoder->getSizeOut(), encoded.getSize());
+
+    BytesArray decoded;
+    ASSERT_TRUE(decodeGzip(encoded, decoded));
+    EXPECT_EQ(decoded, datas);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    StreamEncoderTest,
+    TestStreamEncoderGzip,
+    ::testing::Values(
+        DataRoundTrip{.sizeDatas = 0, .sizeRead = 4096, .sizeWrite = 4096},
+        DataRoundTrip{.sizeDatas = 10, .sizeRead = 4096, .sizeWrite = 4096},
+        DataRoundTrip{.sizeDatas = 100000, .sizeRead = 4096, .sizeWrite = 4096},
+        DataRoundTrip{.sizeDatas = 100000, .sizeRead = 7, .sizeWrite = 4096},
+        DataRoundTrip{.sizeDatas = 100000, .sizeRead = 65536, .sizeWrite = 16},
+        DataRoundTrip{.sizeDatas = 1000000, .sizeRead = 65536, .sizeWrite = 65536}
+    )
+);
+#endif
@@ -0,0 +1,571 @@
+#include "testsserver.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <future>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+ * \class TestsServer
+ * \brief Minimal HTTP/1.1 server used by tests
+ * \details
+ * Server listen on loopback interface (port chosen by the system)
+ * and serve configured routes:
+ * - \c GET and \c HEAD return route body (\c If-None-Match is
+ * answered with <tt>304 Not Modified</tt> when matching route \c ETag)
+ * - \c PUT replace route body
+ *
+ * Each connection is managed by its own thread and kept alive,
+ * number of requests received for each route is recorded.
+ */
+
+/*!
+ * \class TransferTest
+ * \brief Fixture of tests performing transfers
+ * \details
+ * Server is started before each test, routes needed by
+ * the test are then set with setRoutes().
+ */
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+#define POLL_INTERVAL_MS    50
+#define SIZE_READ           4096
+#define TIMEOUT_START_MS    2000
+
+/*****************************/
+/* Start namespace           */
+/*****************************/
+
+/*****************************/
+/* Internal functions        */
+/*****************************/
+
+static std::string toLower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c){
+        return static_cast<char>(std::tolower(c));
+    });
+
+    return str;
+}
+
+static const char* getReason(int code)
+{
+    switch(code)
+    {
+        case 200:   return "OK";
+        case 201:   return "Created";
+        case 304:   return "Not Modified";
+        case 401:   return "Unauthorized";
+        case 403:   return "Forbidden";
+        case 404:   return "Not Found";
+        case 500:   return "Internal Server Error";
+        case 503:   return "Service Unavailable";
+
+        default: break;
+    }
+
+    return "Unknown";
+}
+
+/*****************************/
+/* Functions implementations */
+/*****************************/
+
+TestsServer::TestsServer() :
+    m_fdListen(-1), m_port(0), m_stop(false)
+{
+
+}
+
+TestsServer::~TestsServer()
+{
+    stop();
+}
+
+/*!
+ * \brief Use to start listening
+ *
+ * \return
+ * Returns \c true if succeed.
+ */
+bool TestsServer::start()
+{
+    m_fdListen = socket(AF_INET, SOCK_STREAM, 0);
+    if(m_fdListen < 0){
+        return false;
+    }
+
+    const int enable = 1;
+    setsockopt(m_fdListen, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    socklen_t sizeAddr = sizeof(addr);
+    if(bind(m_fdListen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || listen(m_fdListen, SOMAXCONN) != 0
+        || getsockname(m_fdListen, reinterpret_cast<sockaddr*>(&addr), &sizeAddr) != 0){
+        close(m_fdListen);
+        m_fdListen = -1;
+        return false;
+    }
+
+    m_port = ntohs(addr.sin_port);
+    m_stop = false;
+    m_threadAccept = std::thread(&TestsServer::runAccept, this);
+
+    return true;
+}
+
+/*!
+ * \brief Use to stop server
+ * \details
+ * Opened connections are closed and all
+ * threads are joined.
+ */
+void TestsServer::stop()
+{
+    if(m_fdListen < 0){
+        return;
+    }
+
+    m_stop = true;
+    m_threadAccept.join();
+
+    close(m_fdListen);
+    m_fdListen = -1;
+
+    /* Unblock connections threads */
+    std::vector<std::thread> listThreads;
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        for(const int fd : m_listFds){
+            if(fd >= 0){
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+
+        listThreads.swap(m_listThreads);
+    }
+
+    for(std::thread &thread : listThreads){
+        thread.join();
+    }
+
+    m_listFds.clear();
+}
+
+uint16_t TestsServer::getPort() const
+{
+    return m_port;
+}
+
+Url TestsServer::createUrl(const std::string &path) const
+{
+    return Url("http://127.0.0.1:" + std::to_string(m_port) + path);
+}
+
+void TestsServer::setRoute(const std::string &path, const Route &route)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_mapRoutes[path] = route;
+}
+
+TestsServer::Route TestsServer::getRoute(const std::string &path) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapRoutes.find(path);
+    if(it == m_mapRoutes.end()){
+        Route route;
+        route.code = 404;
+        return route;
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve number of requests received
+ *
+ * \param[in] method
+ * HTTP method (example: \c GET).
+ * \param[in] path
+ * Path of the route.
+ *
+ * \return
+ * Returns number of requests received.
+ */
+int TestsServer::getNbRequests(const std::string &method, const std::string &path) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+
+    auto it = m_mapNbRequests.find(method + " " + path);
+    return it != m_mapNbRequests.end() ? it->second : 0;
+}
+
+void TestsServer::resetNbRequests()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_mapNbRequests.clear();
+}
+
+void TestsServer::runAccept()
+{
+    while(!m_stop){
+        pollfd item{m_fdListen, POLLIN, 0};
+        if(poll(&item, 1, POLL_INTERVAL_MS) <= 0){
+            continue;
+        }
+
+        const int fd = accept(m_fdListen, nullptr, nullptr);
+        if(fd < 0){
+            continue;
+        }
+
+        // Headers and body are sent separately, they must not wait for acknowledgements
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_listFds.push_back(fd);
+        m_listThreads.emplace_back(&TestsServer::runConnection, this, fd);
+    }
+}
+
+void TestsServer::runConnection(int fd)
+{
+    std::string buffer;
+    Query query;
+
+    while(!m_stop && readQuery(fd, buffer, query)){
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_mapNbRequests[query.method + " " + query.path];
+        }
+
+        if(!answer(fd, query) || toLower(query.mapHeaders["connection"]) == "close"){
+            break;
+        }
+    }
+
+    /* Forget descriptor before closing it, so that stop() never shut down a reused one */
+    std::lock_guard<std::mutex> locker(m_mutex);
+    auto it = std::find(m_listFds.begin(), m_listFds.end(), fd);
+    if(it != m_listFds.end()){
+        *it = -1;
+    }
+    close(fd);
+}
+
+bool TestsServer::readQuery(int fd, std::string &buffer, Query &query)
+{
+    query = Query();
+
+    /* Parse request line */
+    std::string line;
+    if(!readLine(fd, buffer, line)){
+        return false;
+    }
+
+    const size_t posMethod = line.find(' ');
+    const size_t posPath = line.find(' ', posMethod + 1);
+    if(posMethod == std::string::npos || posPath == std::string::npos){
+        return false;
+    }
+
+    query.method = line.substr(0, posMethod);
+    query.path = line.substr(posMethod + 1, posPath - posMethod - 1);
+
+    /* Parse headers */
+    while(readLine(fd, buffer, line) && !line.empty()){
+        const size_t posSep = line.find(':');
+        if(posSep == std::string::npos){
+            continue;
+        }
+
+        const size_t posValue = line.find_first_not_of(' ', posSep + 1);
+        query.mapHeaders[toLower(line.substr(0, posSep))] = (posValue != std::string::npos) ? line.substr(posValue) : "";
+    }
+
+    /* Read body */
+    if(toLower(query.mapHeaders["expect"]) == "100-continue"){
+        const std::string answerContinue = "HTTP/1.1 100 Continue\r\n\r\n";
+        if(!sendAll(fd, answerContinue.data(), answerContinue.size())){
+            return false;
+        }
+    }
+
+    if(toLower(query.mapHeaders["transfer-encoding"]) == "chunked"){
+        for(;;){
+            if(!readLine(fd, buffer, line)){
+                return false;
+            }
+
+            const size_t sizeChunk = std::stoul(line, nullptr, 16);
+            BytesArray chunk;
+            if(!readBytes(fd, buffer, sizeChunk, chunk) || !readLine(fd, buffer, line)){
+                return false;
+            }
+            query.body.pushBack(chunk.dataConst(), chunk.getSize());
+
+            if(sizeChunk == 0){
+                return true;
+            }
+        }
+    }
+
+    const auto itLength = query.mapHeaders.find("content-length");
+    if(itLength != query.mapHeaders.end()){
+        return readBytes(fd, buffer, std::stoul(itLength->second), query.body);
+    }
+
+    return true;
+}
+
+bool TestsServer::readLine(int fd, std::string &buffer, std::string &line)
+{
+    for(;;){
+        const size_t posEnd = buffer.find("\r\n");
+        if(posEnd != std::string::npos){
+            line = buffer.substr(0, posEnd);
+            buffer.erase(0, posEnd + 2);
+            return true;
+        }
+
+        char data[SIZE_READ];
+        const ssize_t nbRead = recv(fd, data, sizeof(data), 0);
+        if(nbRead <= 0){
+            return false;
+        }
+        buffer.append(data, static_cast<size_t>(nbRead));
+    }
+}
+
+bool TestsServer::readBytes(int fd, std::string &buffer, size_t size, BytesArray &data)
+{
+    while(buffer.size() < size){
+        char chunk[SIZE_READ];
+        const ssize_t nbRead = recv(fd, chunk, sizeof(chunk), 0);
+        if(nbRead <= 0){
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(nbRead));
+    }
+
+    data.clear();
+    data.pushBack(std::string_view(buffer.data(), size));
+    buffer.erase(0, size);
+
+    return true;
+}
+
+bool TestsServer::answer(int fd, const Query &query)
+{
+    /* Uploads replace route body */
+    if(query.method == "PUT"){
+        Route route;
+        route.code = 201;
+        route.body = query.body;
+
+        setRoute(query.path, route);
+
+        const std::string header = "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n";
+        return sendAll(fd, header.data(), header.size());
+    }
+
+    /* Prepare answer */
+    const Route route = getRoute(query.path);
+    const bool isDelayed = route.nbDelayed == 0 || getNbRequests(query.method, query.path) <= route.nbDelayed;
+    if(isDelayed && !waitMs(route.delayMs)){
+        return false;
+    }
+
+    auto itMatch = query.mapHeaders.find("if-none-match");
+    const bool notModified = !route.etag.empty() && itMatch != query.mapHeaders.end() && itMatch->second == route.etag;
+    int code = notModified ? 304 : route.code;
+    if(query.method == "HEAD" && route.codeHead != 0){
+        code = route.codeHead;
+    }else if(query.method == "GET" && getNbRequests(query.method, query.path) <= route.nbErrors){
+        code = 503;
+    }
+
+    std::string header = "HTTP/1.1 " + std::to_string(code) + " " + getReason(code) + "\r\n";
+    if(!route.etag.empty()){
+        header += "ETag: " + route.etag + "\r\n";
+    }
+    if(!route.lastModified.empty()){
+        header += "Last-Modified: " + route.lastModified + "\r\n";
+    }
+    if(!route.cacheControl.empty()){
+        header += "Cache-Control: " + route.cacheControl + "\r\n";
+    }
+    header += "Content-Length: " + std::to_string(notModified ? 0 : route.body.getSize()) + "\r\n\r\n";
+
+    if(!sendAll(fd, header.data(), header.size())){
+        return false;
+    }
+
+    /* Send body */
+    if(query.method == "HEAD" || notModified){
+        return true;
+    }
+
+    const size_t sizeChunk = (route.sizeChunk > 0) ? route.sizeChunk : std::max<size_t>(1, route.body.getSize());
+    for(size_t pos = 0; pos < route.body.getSize(); pos += sizeChunk){
+        if(pos > 0 && !waitMs(route.delayChunkMs)){
+            return false;
+        }
+
+        const size_t size = std::min(sizeChunk, route.body.getSize() - pos);
+        if(!sendAll(fd, route.body.dataConst() + pos, size)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TestsServer::sendAll(int fd, const void *data, size_t size)
+{
+    const char *pos = static_cast<const char*>(data);
+    while(size > 0){
+        const ssize_t nbSent = send(fd, pos, size, MSG_NOSIGNAL);
+        if(nbSent <= 0){
+            return false;
+        }
+
+        pos += nbSent;
+        size -= static_cast<size_t>(nbSent);
+    }
+
+    return true;
+}
+
+bool TestsServer::waitMs(int delayMs) const
+{
+    const auto tsEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+    while(std::chrono::steady_clock::now() < tsEnd){
+        if(m_stop){
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min(delayMs, 5)));
+    }
+
+    return !m_stop;
+}
+
+void TransferTest::SetUp()
+{
+    ASSERT_TRUE(m_server.start());
+    setRoutes();
+}
+
+Request::PtrShared TransferTest::createDownload(const std::string &path) const
+{
+    auto req = std::make_shared<Request>();
+    req->configureDownload(m_server.createUrl(path));
+
+    return req;
+}
+
+Request::PtrShared TransferTest::createUpload(const std::string &path, const BytesArray &data) const
+{
+    auto req = std::make_shared<Request>();
+    req->configureUpload(m_server.createUrl(path), data);
+
+    return req;
+}
+
+/*!
+ * \brief Use to transfer requests and wait
+ * until transfer is finished
+ *
+ * \param[in] manager
+ * Transfer manager to use (its completion callbacks are replaced).
+ * \param[in] listReqs
+ * List of requests to transfer, type of transfer is
+ * deduced from first request.
+ *
+ * \return
+ * Returns \c TransferManager::ERR_NO_ERROR if all requests succeed.
+ */
+TransferManager::IdError TransferTest::transfer(TransferManager &manager, const Request::List &listReqs)
+{
+    auto promise = std::make_shared<std::promise<TransferManager::IdError>>();
+    auto future = promise->get_future();
+
+    manager.setCbCompleted([promise](Request::TypeTransfer){
+        promise->set_value(TransferManager::ERR_NO_ERROR);
+    });
+    manager.setCbFailed([promise](Request::TypeTransfer, TransferManager::IdError idErr){
+        promise->set_value(idErr);
+    });
+
+    const bool isUpload = !listReqs.empty() && listReqs.front()->getTypeTransfer() == Request::TRANSFER_UPLOAD;
+    const TransferManager::IdError idErr = isUpload ? manager.startUpload(listReqs) : manager.startDownload(listReqs);
+    if(idErr != TransferManager::ERR_NO_ERROR){
+        return idErr;
+    }
+
+    /* Transfer thread may still be running once callback is called */
+    const TransferManager::IdError idErrTransfer = future.get();
+    while(manager.transferIsInProgress()){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return idErrTransfer;
+}
+
+/*!
+ * \brief Use to wait until first bytes of a
+ * request have been received
+ *
+ * \param[in] req
+ * Request being transferred.
+ *
+ * \return
+ * Returns \c false if transfer didn't start in time.
+ */
+bool TransferTest::waitStarted(const Request::PtrShared &req)
+{
+    const auto tsLimit = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_START_MS);
+    while(req->ioGetSizeCurrent() == 0){
+        if(std::chrono::steady_clock::now() >= tsLimit){
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    return true;
+}
+
+double TransferTest::getElapsed(const Request::TimePoint &tsStart)
+{
+    return std::chrono::duration<double>(Request::Clock::now() - tsStart).count();
+}
+
+/*****************************/
+/* End namespace             */
+/*****************************/
+
+/*****************************/
+/* End file                  */
+/*****************************/
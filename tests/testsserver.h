@@ -0,0 +1,110 @@
+#ifndef TEASE_TESTSSERVER_H
+#define TEASE_TESTSSERVER_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "transferease/transfermanager.h"
+
+#include "testshelper.h"
+
+using Request = tease::Request;
+using TransferManager = tease::TransferManager;
+
+class TestsServer
+{
+
+public:
+    struct Route
+    {
+        int code = 200;
+        int codeHead = 0;       /**< Code answered to \c HEAD requests, \c 0 to use \c code */
+        int nbErrors = 0;       /**< Number of first \c GET requests answered with code \c 503 */
+        BytesArray body;
+        std::string etag;
+        std::string lastModified;
+        std::string cacheControl;
+
+        int delayMs = 0;        /**< Delay before answering */
+        int nbDelayed = 0;      /**< Number of first requests which are delayed, \c 0 to delay all of them */
+        size_t sizeChunk = 0;   /**< Body is sent by chunks of this size, \c 0 to send it at once */
+        int delayChunkMs = 0;   /**< Delay between two chunks */
+    };
+
+public:
+    TestsServer();
+    ~TestsServer();
+
+public:
+    bool start();
+    void stop();
+
+    uint16_t getPort() const;
+    Url createUrl(const std::string &path) const;
+
+    void setRoute(const std::string &path, const Route &route);
+    Route getRoute(const std::string &path) const;
+
+    int getNbRequests(const std::string &method, const std::string &path) const;
+    void resetNbRequests();
+
+private:
+    struct Query
+    {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> mapHeaders; /* Names are in lowercase */
+        BytesArray body;
+    };
+
+private:
+    void runAccept();
+    void runConnection(int fd);
+
+    bool readQuery(int fd, std::string &buffer, Query &query);
+    bool readLine(int fd, std::string &buffer, std::string &line);
+    bool readBytes(int fd, std::string &buffer, size_t size, BytesArray &data);
+    bool answer(int fd, const Query &query);
+
+    bool sendAll(int fd, const void *data, size_t size);
+    bool waitMs(int delayMs) const;
+
+private:
+    int m_fdListen;
+    uint16_t m_port;
+
+    std::atomic<bool> m_stop;
+    std::thread m_threadAccept;
+
+    std::vector<std::thread> m_listThreads;
+    std::vector<int> m_listFds;
+
+    std::map<std::string, Route> m_mapRoutes;
+    std::map<std::string, int> m_mapNbRequests;  /* Indexed by "METHOD path" */
+
+    mutable std::mutex m_mutex;
+};
+
+class TransferTest : public ::testing::Test
+{
+protected:
+    void SetUp() override;
+    virtual void setRoutes() {}
+
+    Request::PtrShared createDownload(const std::string &path) const;
+    Request::PtrShared createUpload(const std::string &path, const BytesArray &data) const;
+
+    static TransferManager::IdError transfer(TransferManager &manager, const Request::List &listReqs);
+    static bool waitStarted(const Request::PtrShared &req);
+    static double getElapsed(const Request::TimePoint &tsStart);
+
+protected:
+    TestsServer m_server;
+};
+
+#endif // TEASE_TESTSSERVER_H
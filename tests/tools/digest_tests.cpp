@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include "tools/digest.h"
+
+using Digest = tease::Digest;
+using TransferManager = tease::TransferManager;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+static std::string computeDigest(TransferManager::TypeDigest idDigest, const std::string &data, size_t sizeChunk)
+{
+    Digest::PtrUnique digest = Digest::create(idDigest);
+    if(!digest){
+        return std::string();
+    }
+
+    for(size_t pos = 0; pos < data.size(); pos += sizeChunk){
+        digest->update(data.data() + pos, std::min(sizeChunk, data.size() - pos));
+    }
+
+    return digest->finalize();
+}
+
+/*****************************/
+/* Tests - Known answers     */
+/*****************************/
+
+struct DataKnownAnswer
+{
+    TransferManager::TypeDigest idDigest;
+    std::string input;
+    std::string expDigest;
+};
+
+class TestDigestKnownAnswers : public ::testing::TestWithParam<DataKnownAnswer>{};
+
+TEST_P(TestDigestKnownAnswers, computeDigest)
+{
+    const auto &params = GetParam();
+
+    /* Result must not depend on how datas are split (unaligned chunks use other code paths) */
+    for(size_t sizeChunk : {params.input.size() + 1, size_t(1), size_t(3), size_t(63), size_t(64), size_t(4099)}){
+        EXPECT_EQ(computeDigest(params.idDigest, params.input, sizeChunk), params.expDigest) << "chunk size: " << sizeChunk;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DigestTest,
+    TestDigestKnownAnswers,
+    ::testing::Values(
+        /* FIPS 180-2 examples */
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_SHA256, .input = "", .expDigest = "sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_SHA256, .input = "abc", .expDigest = "sha256:ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_SHA256, .input = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", .expDigest = "sha256:248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_SHA256, .input = std::string(1000000, 'a'), .expDigest = "sha256:cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+
+        /* CRC catalogue check value and RFC 3720 examples */
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_CRC32C, .input = "", .expDigest = "crc32c:00000000"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_CRC32C, .input = "123456789", .expDigest = "crc32c:e3069283"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_CRC32C, .input = std::string(32, '\x00'), .expDigest = "crc32c:8a9136aa"},
+        DataKnownAnswer{.idDigest = TransferManager::DIGEST_CRC32C, .input = std::string(32, '\xFF'), .expDigest = "crc32c:62a8ab43"}
+    )
+);
+
+/*****************************/
+/* Tests - Usage             */
+/*****************************/
+
+TEST(DigestTest, create)
+{
+    EXPECT_EQ(Digest::create(TransferManager::DIGEST_NONE), nullptr);
+
+    for(const auto idDigest : {TransferManager::DIGEST_SHA256, TransferManager::DIGEST_CRC32C}){
+        Digest::PtrUnique digest = Digest::create(idDigest);
+        ASSERT_NE(digest, nullptr);
+        EXPECT_EQ(digest->getType(), idDigest);
+    }
+}
+
+TEST(DigestTest, reset)
+{
+    for(const auto idDigest : {TransferManager::DIGEST_SHA256, TransferManager::DIGEST_CRC32C}){
+        Digest::PtrUnique digest = Digest::create(idDigest);
+        digest->update("garbage", 7);
+        digest->reset();
+        digest->update("123456789", 9);
+
+        EXPECT_EQ(digest->finalize(), computeDigest(idDigest, "123456789", 9));
+    }
+}
+
+TEST(DigestTest, parse)
+{
+    TransferManager::TypeDigest idDigest = TransferManager::DIGEST_NONE;
+    std::string value;
+
+    EXPECT_TRUE(Digest::parse("CRC32C:E3069283", idDigest, value));
+    EXPECT_EQ(idDigest, TransferManager::DIGEST_CRC32C);
+    EXPECT_EQ(value, "e3069283");
+
+    EXPECT_TRUE(Digest::parse("sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", idDigest, value));
+    EXPECT_EQ(idDigest, TransferManager::DIGEST_SHA256);
+
+    EXPECT_FALSE(Digest::parse("e3069283", idDigest, value));
+    EXPECT_FALSE(Digest::parse("md5:e3069283", idDigest, value));
+    EXPECT_FALSE(Digest::parse("crc32c:e306928", idDigest, value));
+    EXPECT_FALSE(Digest::parse("crc32c:e306928g", idDigest, value));
+}
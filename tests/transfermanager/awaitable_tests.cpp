@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transferawaitable.h"
+
+#include "testsserver.h"
+
+#include <condition_variable>
+#include <deque>
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Helpers                   */
+/*****************************/
+
+/* Coroutine started at once, frame is destroyed when it ends */
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct Outcome
+{
+    TransferManager::BatchResult result{Request::TRANSFER_UNK, TransferManager::ERR_INTERNAL};
+    std::thread::id idThreadResumed;
+    std::promise<void> done;
+};
+
+/* Awaitable is created from the coroutine, it can't be moved */
+template<typename FctAwaitable>
+static Task awaitTransfer(FctAwaitable fctAwaitable, Outcome &outcome)
+{
+    outcome.result = co_await fctAwaitable();
+    outcome.idThreadResumed = std::this_thread::get_id();
+    outcome.done.set_value();
+}
+
+/* Executor running tasks on the thread calling runOne() */
+class QueueExecutor
+{
+public:
+    TransferManager::Executor get()
+    {
+        return [this](std::function<void()> task){
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_queueTasks.push_back(std::move(task));
+            m_cond.notify_one();
+        };
+    }
+
+    bool runOne(std::chrono::milliseconds timeout)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            if(!m_cond.wait_for(locker, timeout, [this](){ return !m_queueTasks.empty(); })){
+                return false;
+            }
+
+            task = std::move(m_queueTasks.front());
+            m_queueTasks.pop_front();
+        }
+
+        task();
+        return true;
+    }
+
+private:
+    std::deque<std::function<void()>> m_queueTasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class AwaitableTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(2048, 0x2E);
+        m_server.setRoute("/fast.bin", route);
+
+        // Answer is delayed, so that coroutine is always suspended before transfer ends
+        route.delayMs = 100;
+        m_server.setRoute("/delayed.bin", route);
+
+        route.delayMs = 0;
+        // Body takes about one second to be sent
+        route.body = BytesArray(16 * 1024, 0x2F);
+        route.sizeChunk = 1024;
+        route.delayChunkMs = 60;
+        m_server.setRoute("/slow.bin", route);
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(AwaitableTest, resumeOnTransferThread)
+{
+    TransferManager manager;
+    Request::PtrShared req = createDownload("/delayed.bin");
+
+    Outcome outcome;
+    auto future = outcome.done.get_future();
+    awaitTransfer([&](){ return tease::download(manager, req); }, outcome);
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(outcome.result.idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(outcome.result.typeTransfer, Request::TRANSFER_DOWNLOAD);
+    EXPECT_NE(outcome.idThreadResumed, std::this_thread::get_id());
+    EXPECT_EQ(req->getData(), m_server.getRoute("/delayed.bin").body);
+}
+
+TEST_F(AwaitableTest, resumeOnExecutor)
+{
+    TransferManager manager;
+    QueueExecutor executor;
+
+    Request::PtrShared req = createDownload("/delayed.bin");
+
+    Outcome outcome;
+    auto future = outcome.done.get_future();
+    awaitTransfer([&](){ return tease::download(manager, req, executor.get()); }, outcome);
+
+    /* Coroutine is only resumed by the executor */
+    EXPECT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_TRUE(executor.runOne(std::chrono::seconds(5)));
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+    EXPECT_EQ(outcome.result.idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(outcome.idThreadResumed, std::this_thread::get_id());
+    EXPECT_EQ(req->getData(), m_server.getRoute("/delayed.bin").body);
+}
+
+TEST_F(AwaitableTest, upload)
+{
+    TransferManager manager;
+    const BytesArray data(1024, 0x30);
+
+    /* Upload may end before coroutine is suspended, resuming thread isn't verified */
+    Outcome outcome;
+    auto future = outcome.done.get_future();
+    awaitTransfer([&](){ return tease::upload(manager, createUpload("/uploaded.bin", data)); }, outcome);
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(outcome.result.idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(outcome.result.typeTransfer, Request::TRANSFER_UPLOAD);
+    EXPECT_EQ(m_server.getRoute("/uploaded.bin").body, data);
+}
+
+TEST_F(AwaitableTest, noSuspendOnPreparationError)
+{
+    TransferManager manager;
+    QueueExecutor executor;
+
+    /* Awaited type of transfer isn't respected */
+    Outcome outcomeType;
+    awaitTransfer([&](){ return tease::download(manager, createUpload("/uploaded.bin", BytesArray(16, 0x31)), executor.get()); }, outcomeType);
+
+    EXPECT_EQ(outcomeType.done.get_future().wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(outcomeType.result.idErr, TransferManager::ERR_INVALID_REQUEST);
+    EXPECT_EQ(outcomeType.idThreadResumed, std::this_thread::get_id());
+
+    /* Manager already busy, coroutine continues right away without using the executor */
+    auto futureBusy = manager.submit(createDownload("/slow.bin"));
+
+    Outcome outcomeBusy;
+    awaitTransfer([&](){ return tease::download(manager, createDownload("/fast.bin"), executor.get()); }, outcomeBusy);
+
+    EXPECT_EQ(outcomeBusy.done.get_future().wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(outcomeBusy.result.idErr, TransferManager::ERR_BUSY);
+    EXPECT_EQ(outcomeBusy.idThreadResumed, std::this_thread::get_id());
+    EXPECT_FALSE(executor.runOne(std::chrono::milliseconds(0)));
+
+    manager.abortTransfer();
+    futureBusy.wait();
+}
+
+TEST_F(AwaitableTest, stopBeforeSuspension)
+{
+    TransferManager manager;
+
+    std::stop_source source;
+    source.request_stop();
+
+    /* Transfer is never started */
+    Outcome outcome;
+    awaitTransfer([&](){ return tease::download(manager, createDownload("/fast.bin"), nullptr, source.get_token()); }, outcome);
+
+    EXPECT_EQ(outcome.done.get_future().wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(outcome.result.idErr, TransferManager::ERR_USER_ABORT);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/fast.bin"), 0);
+    EXPECT_FALSE(manager.transferIsInProgress());
+}
+
+TEST_F(AwaitableTest, stopAfterSuspension)
+{
+    TransferManager manager;
+    QueueExecutor executor;
+
+    Request::PtrShared req = createDownload("/slow.bin");
+    std::stop_source source;
+
+    Outcome outcome;
+    auto future = outcome.done.get_future();
+    awaitTransfer([&](){ return tease::download(manager, req, executor.get(), source.get_token()); }, outcome);
+    ASSERT_TRUE(waitStarted(req));
+
+    /* Running transfer is cancelled, coroutine is resumed soon after */
+    EXPECT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    source.request_stop();
+
+    ASSERT_TRUE(executor.runOne(std::chrono::milliseconds(500)));
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(outcome.result.idErr, TransferManager::ERR_USER_ABORT);
+    EXPECT_TRUE(req->ioIsAbort());
+    EXPECT_LT(req->ioGetSizeCurrent(), m_server.getRoute("/slow.bin").body.getSize());
+}
@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class CancelTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        /* Body takes about one second to be sent */
+        TestsServer::Route route;
+        route.body = BytesArray(16 * 1024, 0x4D);
+        route.sizeChunk = 1024;
+        route.delayChunkMs = 60;
+
+        for(int i = 0; i < 4; ++i){
+            m_server.setRoute(getPath(i), route);
+        }
+
+        route.sizeChunk = 0;
+        route.delayChunkMs = 0;
+        m_server.setRoute("/fast.bin", route);
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/slow" + std::to_string(idRoute) + ".bin";
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(CancelTest, cancelRunningRequest)
+{
+    TransferManager manager;
+    const Request::List listReqs = {createDownload(getPath(0)), createDownload(getPath(1))};
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    auto future = manager.submit(listReqs, listFutures);
+    ASSERT_TRUE(waitStarted(listReqs[0]));
+
+    /* Cancelled request is completed right away, other one is still transferred */
+    const auto tsCancel = std::chrono::steady_clock::now();
+    manager.cancel(listReqs[0]->getId());
+
+    ASSERT_EQ(listFutures[0].wait_for(std::chrono::milliseconds(300)), std::future_status::ready);
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_USER_ABORT);
+    EXPECT_TRUE(listReqs[0]->ioIsAbort());
+
+    EXPECT_EQ(listFutures[1].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listReqs[1]->getData(), m_server.getRoute(getPath(1)).body);
+    EXPECT_GT(std::chrono::steady_clock::now() - tsCancel, std::chrono::milliseconds(300));
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_USER_ABORT);
+}
+
+TEST_F(CancelTest, cancelQueuedRequests)
+{
+    TransferManager manager;
+    manager.setNbMaxTransfersPerHost(1);
+
+    Request::List listReqs;
+    for(int i = 0; i < 4; ++i){
+        listReqs.push_back(createDownload(getPath(i)));
+    }
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    auto future = manager.submit(listReqs, listFutures);
+
+    /* Queued requests are never started */
+    manager.cancel({listReqs[1]->getId(), listReqs[2]->getId(), listReqs[3]->getId()});
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_USER_ABORT);
+
+    int nbStarted = 0;
+    for(int i = 0; i < 4; ++i){
+        nbStarted += m_server.getNbRequests("GET", getPath(i));
+    }
+    EXPECT_EQ(nbStarted, 1);
+
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_NO_ERROR);
+    for(size_t i = 1; i < listFutures.size(); ++i){
+        EXPECT_EQ(listFutures[i].get(), TransferManager::ERR_USER_ABORT) << i;
+    }
+}
+
+TEST_F(CancelTest, cancelCoalescedRequests)
+{
+    TransferManager manager;
+
+    /* Waiting request is cancelled, transferred one isn't affected */
+    Request::List listReqs = {createDownload(getPath(0)), createDownload(getPath(0))};
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+
+    auto future = manager.submit(listReqs, listFutures);
+    manager.cancel(listReqs[1]->getId());
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_USER_ABORT);
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listFutures[1].get(), TransferManager::ERR_USER_ABORT);
+
+    /* Transferred request is cancelled, first waiting one is transferred and others wait for its result */
+    m_server.resetNbRequests();
+    listReqs.clear();
+    for(int i = 0; i < 4; ++i){
+        listReqs.push_back(createDownload(getPath(1)));
+    }
+
+    future = manager.submit(listReqs, listFutures);
+    ASSERT_TRUE(waitStarted(listReqs[0]));
+    manager.cancel(listReqs[0]->getId());
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_USER_ABORT);
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_USER_ABORT);
+    for(size_t i = 1; i < listReqs.size(); ++i){
+        EXPECT_EQ(listFutures[i].get(), TransferManager::ERR_NO_ERROR) << i;
+        EXPECT_EQ(listReqs[i]->getData(), m_server.getRoute(getPath(1)).body) << i;
+    }
+    EXPECT_EQ(m_server.getNbRequests("GET", getPath(1)), 2);
+}
+
+TEST_F(CancelTest, cancelUnknownRequest)
+{
+    TransferManager manager;
+
+    Request::PtrShared reqOther = createDownload("/fast.bin");
+    Request::PtrShared req = createDownload("/fast.bin");
+
+    auto future = manager.submit(req);
+    manager.cancel(reqOther->getId());
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_FALSE(reqOther->ioIsAbort());
+}
+
+TEST_F(CancelTest, abortTransfer)
+{
+    TransferManager manager;
+    const Request::List listReqs = {createDownload(getPath(0)), createDownload(getPath(1))};
+
+    auto future = manager.submit(listReqs);
+    ASSERT_TRUE(waitStarted(listReqs[0]));
+
+    const auto tsAbort = std::chrono::steady_clock::now();
+    manager.abortTransfer();
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_USER_ABORT);
+    EXPECT_LT(std::chrono::steady_clock::now() - tsAbort, std::chrono::milliseconds(300));
+}
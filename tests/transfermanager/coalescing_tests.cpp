@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class CoalescingTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        for(int i = 0; i < NB_ROUTES; ++i){
+            TestsServer::Route route;
+            route.body = BytesArray(4096 + i, static_cast<BytesArray::Byte>(i));
+            route.delayMs = 20;
+
+            m_server.setRoute(getPath(i), route);
+        }
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/file" + std::to_string(idRoute) + ".bin";
+    }
+
+protected:
+    static constexpr int NB_ROUTES = 3;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(CoalescingTest, identicalDownloads)
+{
+    TransferManager manager;
+
+    Request::List listReqs;
+    for(int i = 0; i < 30; ++i){
+        listReqs.push_back(createDownload(getPath(i % NB_ROUTES)));
+    }
+
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+
+    /* Each ressource is transferred once, every request receive its datas */
+    for(int i = 0; i < NB_ROUTES; ++i){
+        EXPECT_EQ(m_server.getNbRequests("GET", getPath(i)), 1) << getPath(i);
+    }
+
+    for(size_t i = 0; i < listReqs.size(); ++i){
+        const TestsServer::Route route = m_server.getRoute(getPath(static_cast<int>(i % NB_ROUTES)));
+
+        EXPECT_EQ(listReqs[i]->getData(), route.body) << i;
+        EXPECT_EQ(listReqs[i]->ioGetSizeCurrent(), route.body.getSize()) << i;
+    }
+}
+
+TEST_F(CoalescingTest, ignoreDataSinks)
+{
+    TransferManager manager;
+
+    /* Datas given to a sink are not kept, they can't be shared */
+    Request::List listReqs;
+    std::vector<size_t> listSizes(2, 0);
+    for(size_t i = 0; i < listSizes.size(); ++i){
+        Request::PtrShared req = createDownload(getPath(0));
+        req->setDataSink([&listSizes, i](size_t, const BytesArray::Byte*, size_t size){
+            listSizes[i] += size;
+            return true;
+        });
+        listReqs.push_back(req);
+    }
+
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(m_server.getNbRequests("GET", getPath(0)), 2);
+
+    for(size_t size : listSizes){
+        EXPECT_EQ(size, m_server.getRoute(getPath(0)).body.getSize());
+    }
+}
+
+TEST_F(CoalescingTest, failedDownload)
+{
+    TransferManager manager;
+
+    Request::List listReqs;
+    for(int i = 0; i < 3; ++i){
+        listReqs.push_back(createDownload("/missing.bin"));
+    }
+
+    /* Requests waiting for the failed download fail too, without being transferred */
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_CONTENT_NOT_FOUND);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/missing.bin"), 1);
+
+    for(const auto &req : listReqs){
+        EXPECT_TRUE(req->getData().isEmpty());
+    }
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class DeadlineTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(2048, 0x42);
+        m_server.setRoute("/fast.bin", route);
+
+        route.delayMs = 3000;
+        m_server.setRoute("/slow.bin", route);
+
+        // About 50 kB/s, whole body would need 10 seconds
+        route.delayMs = 0;
+        route.body = BytesArray(500 * 1024, 0x24);
+        route.sizeChunk = 1024;
+        route.delayChunkMs = 20;
+        m_server.setRoute("/throttled.bin", route);
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(DeadlineTest, requestDeadline)
+{
+    TransferManager manager;
+
+    Request::PtrShared reqSlow = createDownload("/slow.bin");
+    Request::PtrShared reqFast = createDownload("/fast.bin");
+    reqSlow->setDeadline(Request::Clock::now() + std::chrono::milliseconds(300));
+
+    /* Only request missing its deadline fails */
+    const Request::TimePoint tsStart = Request::Clock::now();
+
+    EXPECT_EQ(transfer(manager, {reqSlow, reqFast}), TransferManager::ERR_DEADLINE_EXCEEDED);
+
+    EXPECT_LT(getElapsed(tsStart), 2.0);
+    EXPECT_EQ(reqSlow->ioGetSizeCurrent(), 0);
+    EXPECT_EQ(reqFast->getData(), m_server.getRoute("/fast.bin").body);
+}
+
+TEST_F(DeadlineTest, requestDeadlineAlreadyPassed)
+{
+    TransferManager manager;
+
+    Request::PtrShared req = createDownload("/fast.bin");
+    req->setDeadline(Request::Clock::now() - std::chrono::milliseconds(1));
+
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_DEADLINE_EXCEEDED);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/fast.bin"), 0);
+}
+
+TEST_F(DeadlineTest, requestDeadlineUnreachable)
+{
+    TransferManager manager;
+
+    /* Request is stopped as soon as its speed show that deadline can't be met */
+    Request::PtrShared req = createDownload("/throttled.bin");
+    req->setDeadline(Request::Clock::now() + std::chrono::seconds(4));
+
+    const Request::TimePoint tsStart = Request::Clock::now();
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_DEADLINE_EXCEEDED);
+    EXPECT_LT(getElapsed(tsStart), 3.5);
+}
+
+TEST_F(DeadlineTest, batchTimeout)
+{
+    TransferManager manager;
+    manager.setTimeoutBatch(1);
+
+    Request::PtrShared reqSlow = createDownload("/slow.bin");
+    Request::PtrShared reqFast = createDownload("/fast.bin");
+
+    const Request::TimePoint tsStart = Request::Clock::now();
+    EXPECT_EQ(transfer(manager, {reqFast, reqSlow}), TransferManager::ERR_DEADLINE_EXCEEDED);
+
+    const double elapsed = getElapsed(tsStart);
+    EXPECT_GE(elapsed, 0.9);
+    EXPECT_LT(elapsed, 2.5);
+}
+
+TEST_F(DeadlineTest, batchTimeoutNotReached)
+{
+    TransferManager manager;
+    manager.setTimeoutBatch(5);
+
+    Request::PtrShared req = createDownload("/fast.bin");
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/fast.bin").body);
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class HedgingTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(4096, 0x5A);
+        for(int i = 0; i < NB_SAMPLES; ++i){
+            m_server.setRoute(getPathFast(i), route);
+        }
+
+        // Only first request is stuck, a duplicated request is answered at once
+        route.delayMs = 2000;
+        route.nbDelayed = 1;
+        m_server.setRoute("/stuck.bin", route);
+    }
+
+    static std::string getPathFast(int idRoute)
+    {
+        return "/fast" + std::to_string(idRoute) + ".bin";
+    }
+
+    void observeLatencies(TransferManager &manager) const
+    {
+        // Ressources must differ, duplicated downloads would be coalesced
+        Request::List listReqs;
+        for(int i = 0; i < NB_SAMPLES; ++i){
+            listReqs.push_back(createDownload(getPathFast(i)));
+        }
+
+        ASSERT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+    }
+
+protected:
+    static constexpr int NB_SAMPLES = 20;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(HedgingTest, disabled)
+{
+    TransferManager manager;
+    observeLatencies(manager);
+
+    Request::PtrShared req = createDownload("/stuck.bin");
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/stuck.bin"), 1);
+}
+
+TEST_F(HedgingTest, firstByte)
+{
+    TransferManager manager;
+    manager.setHedgingPolicy(TransferManager::HEDGING_FIRST_BYTE, 90.0);
+    observeLatencies(manager);
+
+    /* Duplicated request complete before the stuck one */
+    Request::PtrShared req = createDownload("/stuck.bin");
+
+    const Request::TimePoint tsStart = Request::Clock::now();
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_LT(getElapsed(tsStart), 1.0);
+
+    EXPECT_EQ(m_server.getNbRequests("GET", "/stuck.bin"), 2);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/stuck.bin").body);
+}
+
+TEST_F(HedgingTest, completion)
+{
+    TransferManager manager;
+    manager.setHedgingPolicy(TransferManager::HEDGING_COMPLETION, 90.0);
+    observeLatencies(manager);
+
+    Request::PtrShared req = createDownload("/stuck.bin");
+
+    const Request::TimePoint tsStart = Request::Clock::now();
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_LT(getElapsed(tsStart), 1.0);
+
+    EXPECT_EQ(m_server.getNbRequests("GET", "/stuck.bin"), 2);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/stuck.bin").body);
+}
+
+TEST_F(HedgingTest, notEnoughSamples)
+{
+    TransferManager manager;
+    manager.setHedgingPolicy(TransferManager::HEDGING_FIRST_BYTE, 90.0);
+
+    /* Without observed latencies, requests are never duplicated */
+    Request::PtrShared req = createDownload("/stuck.bin");
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/stuck.bin"), 1);
+}
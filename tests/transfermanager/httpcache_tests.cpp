@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+#include <filesystem>
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+using Url = tease::Url;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class HttpCacheTransferTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(8192, 0x5A);
+        route.etag = "\"v1\"";
+        m_server.setRoute("/cached.bin", route);
+
+        route.cacheControl = "no-store";
+        m_server.setRoute("/no-store.bin", route);
+
+        route.cacheControl.clear();
+        route.etag.clear();
+        m_server.setRoute("/no-etag.bin", route);
+    }
+
+    Request::PtrShared download(TransferManager &manager, const std::string &path) const
+    {
+        Request::PtrShared req = createDownload(path);
+
+        EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+        return req;
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(HttpCacheTransferTest, revalidateEntry)
+{
+    TransferManager manager;
+    manager.setHttpCache("", true);
+
+    const BytesArray body = m_server.getRoute("/cached.bin").body;
+    EXPECT_EQ(download(manager, "/cached.bin")->getData(), body);
+
+    /* Remote answer "304 Not Modified", stored body is used */
+    Request::PtrShared req = download(manager, "/cached.bin");
+    EXPECT_EQ(req->getData(), body);
+
+    auto stats = manager.getHttpCacheStats();
+    EXPECT_EQ(stats.nbMisses, 1);
+    EXPECT_EQ(stats.nbHits, 1);
+    EXPECT_EQ(stats.nbRevalidations, 1);
+    EXPECT_EQ(stats.nbBytesSaved, body.getSize());
+
+    /* Modified body is downloaded again */
+    TestsServer::Route route = m_server.getRoute("/cached.bin");
+    route.body = BytesArray(1024, 0x33);
+    route.etag = "\"v2\"";
+    m_server.setRoute("/cached.bin", route);
+
+    EXPECT_EQ(download(manager, "/cached.bin")->getData(), route.body);
+    EXPECT_EQ(download(manager, "/cached.bin")->getData(), route.body);
+
+    stats = manager.getHttpCacheStats();
+    EXPECT_EQ(stats.nbMisses, 2);
+    EXPECT_EQ(stats.nbHits, 2);
+    EXPECT_EQ(stats.nbRevalidations, 3);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/cached.bin"), 4);
+}
+
+TEST_F(HttpCacheTransferTest, ignoreResponsesWithoutValidators)
+{
+    TransferManager manager;
+    manager.setHttpCache("", true);
+
+    download(manager, "/no-etag.bin");
+    download(manager, "/no-etag.bin");
+
+    const auto stats = manager.getHttpCacheStats();
+    EXPECT_EQ(stats.nbMisses, 2);
+    EXPECT_EQ(stats.nbHits, 0);
+    EXPECT_EQ(stats.nbRevalidations, 0);
+}
+
+TEST_F(HttpCacheTransferTest, ignoreNoStoreResponses)
+{
+    TransferManager manager;
+    manager.setHttpCache("", true);
+
+    /* Response has a validator, but remote forbid to store it */
+    download(manager, "/no-store.bin");
+    EXPECT_EQ(download(manager, "/no-store.bin")->getData(), m_server.getRoute("/no-store.bin").body);
+
+    const auto stats = manager.getHttpCacheStats();
+    EXPECT_EQ(stats.nbMisses, 2);
+    EXPECT_EQ(stats.nbHits, 0);
+    EXPECT_EQ(stats.nbRevalidations, 0);
+}
+
+TEST_F(HttpCacheTransferTest, keepEntriesOnDisk)
+{
+    const std::filesystem::path pathDir = std::filesystem::temp_directory_path() / ("tease-tests-httpcache-transfer-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+    std::filesystem::remove_all(pathDir);
+
+    {
+        TransferManager manager;
+        manager.setHttpCache(pathDir.string());
+        download(manager, "/cached.bin");
+    }
+
+    /* Entries are shared between managers using same directory */
+    TransferManager manager;
+    manager.setHttpCache(pathDir.string());
+
+    EXPECT_EQ(download(manager, "/cached.bin")->getData(), m_server.getRoute("/cached.bin").body);
+    EXPECT_EQ(manager.getHttpCacheStats().nbHits, 1);
+
+    std::error_code errId;
+    std::filesystem::remove_all(pathDir, errId);
+}
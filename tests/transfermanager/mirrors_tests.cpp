@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+using Url = tease::Url;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class MirrorsTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(2048, 0x11);
+        m_server.setRoute("/mirror.bin", route);
+
+        route.body = BytesArray();
+        for(int code : {401, 404, 500, 503}){
+            route.code = code;
+            m_server.setRoute(getPathError(code), route);
+        }
+    }
+
+    static std::string getPathError(int code)
+    {
+        return "/error" + std::to_string(code) + ".bin";
+    }
+
+    static Request::PtrShared createMirrored(const Url &url, const std::vector<Url> &listMirrors)
+    {
+        auto req = std::make_shared<Request>();
+        req->configureDownload(url);
+        req->setMirrors(listMirrors);
+
+        return req;
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(MirrorsTest, failoverOnServerError)
+{
+    TransferManager manager;
+
+    for(int code : {500, 503}){
+        Request::PtrShared req = createMirrored(m_server.createUrl(getPathError(code)), {m_server.createUrl("/mirror.bin")});
+
+        EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR) << code;
+        EXPECT_EQ(req->getData(), m_server.getRoute("/mirror.bin").body) << code;
+        EXPECT_EQ(req->ioGetNbFailovers(), 1) << code;
+        EXPECT_EQ(req->ioGetUrl().toString(), m_server.createUrl("/mirror.bin").toString()) << code;
+    }
+}
+
+TEST_F(MirrorsTest, failoverOnUnreachableHost)
+{
+    /* Retrieve a port nobody listen to */
+    TestsServer serverClosed;
+    ASSERT_TRUE(serverClosed.start());
+    const Url urlClosed = serverClosed.createUrl("/mirror.bin");
+    serverClosed.stop();
+
+    TransferManager manager;
+    Request::PtrShared req = createMirrored(urlClosed, {m_server.createUrl("/mirror.bin")});
+
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/mirror.bin").body);
+}
+
+TEST_F(MirrorsTest, noFailoverOnClientError)
+{
+    TransferManager manager;
+
+    /* Mirrors would give same answer, error is reported at once */
+    Request::PtrShared req = createMirrored(m_server.createUrl(getPathError(404)), {m_server.createUrl("/mirror.bin")});
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_CONTENT_NOT_FOUND);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/mirror.bin"), 0);
+
+    req = createMirrored(m_server.createUrl(getPathError(401)), {m_server.createUrl("/mirror.bin")});
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_INVALID_LOGIN);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/mirror.bin"), 0);
+}
+
+TEST_F(MirrorsTest, allMirrorsFailed)
+{
+    TransferManager manager;
+
+    /* Once all mirrors have been tried, retries are performed on last one */
+    Request::PtrShared req = createMirrored(m_server.createUrl(getPathError(500)), {m_server.createUrl(getPathError(503))});
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_MAX_TRIALS);
+    EXPECT_EQ(m_server.getNbRequests("GET", getPathError(500)), 1);
+    EXPECT_EQ(m_server.getNbRequests("GET", getPathError(503)), 1 + manager.getNbMaxTrials());
+}
+
+TEST_F(MirrorsTest, noMirrors)
+{
+    TransferManager manager;
+    manager.setNbMaxTrials(3);
+
+    /* Server errors are retried on same URL (first transfer is not counted as a trial) */
+    Request::PtrShared req = createMirrored(m_server.createUrl(getPathError(503)), {});
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_MAX_TRIALS);
+    EXPECT_EQ(m_server.getNbRequests("GET", getPathError(503)), 1 + 3);
+}
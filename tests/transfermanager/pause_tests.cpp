@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class PauseTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        /* Body takes about half a second to be sent */
+        for(int i = 0; i < 2; ++i){
+            TestsServer::Route route;
+            route.body = BytesArray(16 * 1024, 0x00);
+            for(size_t pos = 0; pos < route.body.getSize(); ++pos){
+                route.body[pos] = static_cast<BytesArray::Byte>(pos * 7 + i);
+            }
+            route.sizeChunk = 1024;
+            route.delayChunkMs = 30;
+
+            m_server.setRoute(getPath(i), route);
+        }
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/slow" + std::to_string(idRoute) + ".bin";
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(PauseTest, pauseRequest)
+{
+    TransferManager manager;
+    const Request::List listReqs = {createDownload(getPath(0)), createDownload(getPath(1))};
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    auto future = manager.submit(listReqs, listFutures);
+    ASSERT_TRUE(waitStarted(listReqs[0]));
+
+    /* Paused request doesn't receive datas anymore, other one still does */
+    manager.pause(listReqs[0]->getId());
+    EXPECT_TRUE(listReqs[0]->ioIsPaused());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const size_t sizePaused = listReqs[0]->ioGetSizeCurrent();
+    EXPECT_EQ(listFutures[1].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listReqs[0]->ioGetSizeCurrent(), sizePaused);
+    EXPECT_LT(sizePaused, m_server.getRoute(getPath(0)).body.getSize());
+
+    /* Transfer goes on once resumed */
+    manager.resume(listReqs[0]->getId());
+    EXPECT_FALSE(listReqs[0]->ioIsPaused());
+
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listReqs[0]->getData(), m_server.getRoute(getPath(0)).body);
+}
+
+TEST_F(PauseTest, pauseTransfer)
+{
+    TransferManager manager;
+
+    /* Pause is kept for next transfers */
+    manager.pauseTransfer();
+    EXPECT_TRUE(manager.transferIsPaused());
+
+    const Request::List listReqs = {createDownload(getPath(0)), createDownload(getPath(1))};
+    auto future = manager.submit(listReqs);
+
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds(700)), std::future_status::timeout);
+    for(const auto &req : listReqs){
+        EXPECT_EQ(req->ioGetSizeCurrent(), 0);
+    }
+
+    manager.resumeTransfer();
+    EXPECT_FALSE(manager.transferIsPaused());
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    for(int i = 0; i < 2; ++i){
+        EXPECT_EQ(listReqs[i]->getData(), m_server.getRoute(getPath(i)).body) << i;
+    }
+}
+
+TEST_F(PauseTest, sinkBackpressure)
+{
+    TransferManager manager;
+    Request::PtrShared req = createDownload(getPath(0));
+
+    /* Sink refuse each chunk the first time it is given */
+    BytesArray dataSink;
+    size_t nbRefused = 0;
+    bool refuseNext = true;
+    bool offsetsValid = true;
+
+    req->setDataSink([&](size_t offset, const BytesArray::Byte *data, size_t size){
+        if(refuseNext){
+            refuseNext = false;
+            ++nbRefused;
+            return false;
+        }
+
+        offsetsValid = offsetsValid && offset == dataSink.getSize();
+        dataSink.pushBack(data, size);
+        refuseNext = true;
+        return true;
+    });
+
+    auto future = manager.submit(req);
+    while(future.wait_for(std::chrono::milliseconds(5)) != std::future_status::ready){
+        if(req->ioIsPaused()){
+            manager.resume(req->getId());
+        }
+    }
+
+    /* Refused datas are given again, nothing is kept by the request */
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_TRUE(offsetsValid);
+    EXPECT_GT(nbRefused, 1);
+    EXPECT_EQ(dataSink, m_server.getRoute(getPath(0)).body);
+    EXPECT_TRUE(req->getData().isEmpty());
+}
+
+TEST_F(PauseTest, sinkRefusedWithoutResume)
+{
+    TransferManager manager;
+
+    /* Synchronous transfers can't be resumed */
+    Request::PtrShared req = createDownload(getPath(0));
+    req->setDataSink([](size_t, const BytesArray::Byte*, size_t){
+        return false;
+    });
+
+    EXPECT_NE(manager.transferNow(req), TransferManager::ERR_NO_ERROR);
+}
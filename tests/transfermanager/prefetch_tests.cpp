@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class PrefetchTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        /* Bodies are sent slowly, so that several progress events are emitted */
+        for(int i = 0; i < NB_ROUTES; ++i){
+            TestsServer::Route route;
+            route.body = BytesArray(getSize(i), static_cast<BytesArray::Byte>(i));
+            route.sizeChunk = 4096;
+            route.delayChunkMs = 10;
+
+            m_server.setRoute(getPath(i), route);
+        }
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/file" + std::to_string(idRoute) + ".bin";
+    }
+
+    static size_t getSize(int idRoute)
+    {
+        return 16 * 1024 * (idRoute + 1);
+    }
+
+    std::vector<TransferManager::Progress> download(TransferManager &manager, const Request::List &listReqs, TransferManager::IdError idErrExp = TransferManager::ERR_NO_ERROR)
+    {
+        std::vector<TransferManager::Progress> listProgress;
+        std::mutex mutex;
+
+        manager.setCbProgressInfos([&listProgress, &mutex](Request::TypeTransfer, const TransferManager::Progress &progress){
+            std::lock_guard<std::mutex> locker(mutex);
+            listProgress.push_back(progress);
+        });
+
+        EXPECT_EQ(transfer(manager, listReqs), idErrExp);
+
+        manager.setCbProgressInfos(nullptr);
+        return listProgress;
+    }
+
+protected:
+    static constexpr int NB_ROUTES = 3;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(PrefetchTest, exactTotalFromStart)
+{
+    TransferManager manager;
+    manager.setOptions(TransferManager::OPT_PREFETCH_SIZES);
+
+    Request::List listReqs;
+    size_t sizeTotal = 0;
+    for(int i = 0; i < NB_ROUTES; ++i){
+        listReqs.push_back(createDownload(getPath(i)));
+        sizeTotal += getSize(i);
+    }
+
+    /* Total never changes, even before first bytes are received */
+    const auto listProgress = download(manager, listReqs);
+    ASSERT_FALSE(listProgress.empty());
+    for(size_t i = 0; i < listProgress.size(); ++i){
+        EXPECT_EQ(listProgress[i].sizeTotal, sizeTotal) << i;
+    }
+
+    for(int i = 0; i < NB_ROUTES; ++i){
+        EXPECT_EQ(listReqs[i]->ioGetSizeExpected(), getSize(i)) << i;
+        EXPECT_EQ(listReqs[i]->getData(), m_server.getRoute(getPath(i)).body) << i;
+        EXPECT_EQ(m_server.getNbRequests("HEAD", getPath(i)), 1) << i;
+    }
+}
+
+TEST_F(PrefetchTest, optionDisabled)
+{
+    TransferManager manager;
+
+    Request::PtrShared req = createDownload(getPath(0));
+    EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->ioGetSizeExpected(), 0);
+    EXPECT_EQ(m_server.getNbRequests("HEAD", getPath(0)), 0);
+}
+
+TEST_F(PrefetchTest, sizeKeptOnRetry)
+{
+    TransferManager manager;
+    manager.setOptions(TransferManager::OPT_PREFETCH_SIZES);
+    manager.setNbMaxTrials(1);
+
+    TestsServer::Route route = m_server.getRoute(getPath(0));
+    route.nbErrors = 1;
+    m_server.setRoute("/flaky.bin", route);
+
+    Request::PtrShared req = createDownload("/flaky.bin");
+    const auto listProgress = download(manager, {req});
+
+    EXPECT_EQ(req->ioGetNbTrials(), 1);
+    EXPECT_EQ(req->ioGetSizeExpected(), getSize(0));
+    EXPECT_EQ(req->getData(), route.body);
+
+    ASSERT_FALSE(listProgress.empty());
+    for(size_t i = 0; i < listProgress.size(); ++i){
+        EXPECT_EQ(listProgress[i].sizeTotal, getSize(0)) << i;
+    }
+}
+
+TEST_F(PrefetchTest, sizeKeptOnFailover)
+{
+    TransferManager manager;
+    manager.setOptions(TransferManager::OPT_PREFETCH_SIZES);
+
+    /* Size is retrieved from first URL, mirror serves same ressource */
+    TestsServer::Route route = m_server.getRoute(getPath(1));
+    route.code = 503;
+    route.codeHead = 200;
+    m_server.setRoute("/broken.bin", route);
+
+    Request::PtrShared req = createDownload("/broken.bin");
+    req->setMirrors({m_server.createUrl(getPath(1))});
+
+    const auto listProgress = download(manager, {req});
+
+    EXPECT_EQ(req->ioGetNbFailovers(), 1);
+    EXPECT_EQ(req->ioGetSizeExpected(), getSize(1));
+    EXPECT_EQ(req->getData(), m_server.getRoute(getPath(1)).body);
+
+    ASSERT_FALSE(listProgress.empty());
+    for(size_t i = 0; i < listProgress.size(); ++i){
+        EXPECT_EQ(listProgress[i].sizeTotal, getSize(1)) << i;
+    }
+}
+
+TEST_F(PrefetchTest, unknownSizeOnFailure)
+{
+    TransferManager manager;
+    manager.setOptions(TransferManager::OPT_PREFETCH_SIZES);
+
+    /* Remote doesn't support HEAD requests */
+    TestsServer::Route route = m_server.getRoute(getPath(2));
+    route.codeHead = 404;
+    m_server.setRoute("/no-head.bin", route);
+
+    const Request::List listReqs = {createDownload("/no-head.bin"), createDownload(getPath(0))};
+    download(manager, listReqs);
+
+    EXPECT_EQ(listReqs[0]->ioGetSizeExpected(), 0);
+    EXPECT_EQ(listReqs[0]->getData(), route.body);
+    EXPECT_EQ(listReqs[1]->ioGetSizeExpected(), getSize(0));
+    EXPECT_EQ(listReqs[1]->getData(), m_server.getRoute(getPath(0)).body);
+
+    const TransferManager::Progress progress = manager.getProgress();
+    EXPECT_EQ(progress.sizeTotal, getSize(2) + getSize(0));
+    EXPECT_EQ(progress.sizeCurrent, progress.sizeTotal);
+}
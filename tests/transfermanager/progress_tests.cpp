@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+#include <future>
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class ProgressTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        /* Bodies are sent slowly, so that several progress events are emitted */
+        for(int i = 0; i < NB_ROUTES; ++i){
+            TestsServer::Route route;
+            route.body = BytesArray(SIZE_ROUTE, static_cast<BytesArray::Byte>(i));
+            route.sizeChunk = SIZE_ROUTE / 16;
+            route.delayChunkMs = 20;
+
+            m_server.setRoute(getPath(i), route);
+        }
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/file" + std::to_string(idRoute) + ".bin";
+    }
+
+    Request::List createRequests() const
+    {
+        Request::List listReqs;
+        for(int i = 0; i < NB_ROUTES; ++i){
+            listReqs.push_back(createDownload(getPath(i)));
+        }
+
+        return listReqs;
+    }
+
+    std::vector<TransferManager::Progress> download(TransferManager &manager)
+    {
+        std::vector<TransferManager::Progress> listProgress;
+        std::mutex mutex;
+
+        manager.setCbProgressInfos([&listProgress, &mutex](Request::TypeTransfer, const TransferManager::Progress &progress){
+            std::lock_guard<std::mutex> locker(mutex);
+            listProgress.push_back(progress);
+        });
+
+        EXPECT_EQ(transfer(manager, createRequests()), TransferManager::ERR_NO_ERROR);
+
+        manager.setCbProgressInfos(nullptr);
+        return listProgress;
+    }
+
+protected:
+    static constexpr int NB_ROUTES = 4;
+    static constexpr size_t SIZE_ROUTE = 64 * 1024;
+    static constexpr size_t SIZE_TOTAL = NB_ROUTES * SIZE_ROUTE;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(ProgressTest, progressInfos)
+{
+    TransferManager manager;
+
+    const auto listProgress = download(manager);
+    ASSERT_GT(listProgress.size(), 2);
+
+    /* Transferred bytes never decrease, nor exceed total size */
+    bool hasThroughput = false;
+    for(size_t i = 0; i < listProgress.size(); ++i){
+        EXPECT_LE(listProgress[i].sizeCurrent, listProgress[i].sizeTotal) << i;
+        EXPECT_LE(listProgress[i].nbActive + listProgress[i].nbQueued + listProgress[i].nbCompleted, NB_ROUTES) << i;
+        if(i > 0){
+            EXPECT_GE(listProgress[i].sizeCurrent, listProgress[i - 1].sizeCurrent) << i;
+        }
+
+        hasThroughput = hasThroughput || listProgress[i].throughput > 0.0;
+    }
+    EXPECT_TRUE(hasThroughput);
+
+    /* Final progress is always emitted */
+    const TransferManager::Progress &progressLast = listProgress.back();
+    EXPECT_EQ(progressLast.sizeCurrent, SIZE_TOTAL);
+    EXPECT_EQ(progressLast.sizeTotal, SIZE_TOTAL);
+    EXPECT_DOUBLE_EQ(progressLast.eta, 0.0);
+
+    /* Progress of last transfer is kept */
+    const TransferManager::Progress progress = manager.getProgress();
+    EXPECT_EQ(progress.sizeCurrent, SIZE_TOTAL);
+    EXPECT_EQ(progress.nbCompleted, NB_ROUTES);
+    EXPECT_TRUE(manager.getRequestsProgress().empty());
+}
+
+TEST_F(ProgressTest, rateLimited)
+{
+    TransferManager manager;
+    const size_t nbEvents = download(manager).size();
+
+    /* Events are coalesced according to interval */
+    manager.setProgressInterval(150);
+    EXPECT_EQ(manager.getProgressInterval(), 150);
+
+    const auto listProgress = download(manager);
+    ASSERT_FALSE(listProgress.empty());
+    EXPECT_LT(listProgress.size(), nbEvents);
+    EXPECT_LE(listProgress.size(), 6);
+    EXPECT_EQ(listProgress.back().sizeCurrent, SIZE_TOTAL);
+
+    /* And according to threshold */
+    manager.setProgressInterval(0, 2 * SIZE_TOTAL);
+    EXPECT_EQ(manager.getProgressThreshold(), 2 * SIZE_TOTAL);
+
+    const auto listFinal = download(manager);
+    ASSERT_FALSE(listFinal.empty());
+    EXPECT_LE(listFinal.size(), 2);
+    EXPECT_EQ(listFinal.back().sizeCurrent, SIZE_TOTAL);
+}
+
+TEST_F(ProgressTest, requestsProgress)
+{
+    TransferManager manager;
+    Request::List listReqs = createRequests();
+
+    auto future = std::async(std::launch::async, [&manager, &listReqs](){
+        return transfer(manager, listReqs);
+    });
+
+    /* Breakdown is available while transfer is running */
+    std::vector<TransferManager::RequestProgress> listProgress;
+    while(listProgress.empty() && future.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready){
+        listProgress = manager.getRequestsProgress();
+    }
+
+    ASSERT_EQ(listProgress.size(), listReqs.size());
+    for(const auto &item : listProgress){
+        EXPECT_NE(std::find(listReqs.begin(), listReqs.end(), item.req), listReqs.end());
+        EXPECT_LE(item.sizeCurrent, SIZE_ROUTE);
+    }
+
+    /* Rate-limiting can't be changed meanwhile */
+    manager.setProgressInterval(500);
+    EXPECT_EQ(manager.getProgressInterval(), 0);
+
+    EXPECT_EQ(future.get(), TransferManager::ERR_NO_ERROR);
+}
@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "tools/digest.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+using Digest = tease::Digest;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class SkipUnchangedTest : public TransferTest
+{
+protected:
+    void SetUp() override
+    {
+        TransferTest::SetUp();
+
+        m_data = BytesArray(4096, 0x6B);
+
+        Digest::PtrUnique digest = Digest::create(TransferManager::DIGEST_SHA256);
+        digest->update(m_data.dataConst(), m_data.getSize());
+        m_digest = digest->finalize();
+
+        TransferManager::TypeDigest idDigest;
+        Digest::parse(m_digest, idDigest, m_digestValue);
+    }
+
+    void setRemote(const std::string &etag, const std::string &lastModified, size_t size)
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(size, 0x00);
+        route.etag = etag;
+        route.lastModified = lastModified;
+
+        m_server.setRoute(PATH, route);
+    }
+
+    Request::PtrShared upload(TransferManager &manager, const std::string &digest, std::time_t mtime) const
+    {
+        Request::PtrShared req = createUpload(PATH, m_data);
+        req->setExpectedDigest(digest);
+        req->setModificationTime(mtime);
+
+        EXPECT_EQ(transfer(manager, {req}), TransferManager::ERR_NO_ERROR);
+        return req;
+    }
+
+protected:
+    static constexpr const char *PATH = "/upload.bin";
+    static constexpr const char *DATE_REMOTE = "Wed, 21 Oct 2015 07:28:00 GMT";
+    static constexpr std::time_t TIME_REMOTE = 1445412480;
+
+    BytesArray m_data;
+    std::string m_digest;
+    std::string m_digestValue;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(SkipUnchangedTest, etagMatchDigest)
+{
+    for(const std::string &etag : {"\"" + m_digestValue + "\"", "\"" + m_digest + "\""}){
+        setRemote(etag, "", 1);
+        m_server.resetNbRequests();
+
+        TransferManager manager;
+        manager.setOptions(TransferManager::OPT_SKIP_UNCHANGED);
+
+        Request::PtrShared req = upload(manager, m_digest, 0);
+        EXPECT_TRUE(req->ioIsSkipped()) << etag;
+        EXPECT_EQ(m_server.getNbRequests("HEAD", PATH), 1) << etag;
+        EXPECT_EQ(m_server.getNbRequests("PUT", PATH), 0) << etag;
+
+        const auto stats = manager.getSkipStats();
+        EXPECT_EQ(stats.nbChecked, 1) << etag;
+        EXPECT_EQ(stats.nbSkipped, 1) << etag;
+        EXPECT_EQ(stats.nbBytesSkipped, m_data.getSize()) << etag;
+    }
+}
+
+TEST_F(SkipUnchangedTest, etagMismatch)
+{
+    /* Weak validators don't guarantee same bytes */
+    for(const std::string &etag : {"W/\"" + m_digestValue + "\"", std::string("\"other\"")}){
+        setRemote(etag, "", m_data.getSize());
+        m_server.resetNbRequests();
+
+        TransferManager manager;
+        manager.setOptions(TransferManager::OPT_SKIP_UNCHANGED);
+
+        EXPECT_FALSE(upload(manager, m_digest, 0)->ioIsSkipped()) << etag;
+        EXPECT_EQ(m_server.getNbRequests("PUT", PATH), 1) << etag;
+        EXPECT_EQ(manager.getSkipStats().nbSkipped, 0) << etag;
+    }
+}
+
+TEST_F(SkipUnchangedTest, sizeAndModificationTime)
+{
+    struct Case
+    {
+        size_t sizeRemote;
+        std::time_t mtime;
+        bool expSkipped;
+    };
+
+    const Case listCases[] = {
+        {m_data.getSize(), TIME_REMOTE - 10, true},
+        {m_data.getSize(), TIME_REMOTE, true},
+        {m_data.getSize(), TIME_REMOTE + 10, false},    // Local datas are more recent
+        {m_data.getSize(), 0, false},                   // Local modification time is unknown
+        {m_data.getSize() - 1, TIME_REMOTE - 10, false}
+    };
+
+    for(const Case &item : listCases){
+        setRemote("", DATE_REMOTE, item.sizeRemote);
+        m_server.resetNbRequests();
+
+        TransferManager manager;
+        manager.setOptions(TransferManager::OPT_SKIP_UNCHANGED);
+
+        EXPECT_EQ(upload(manager, "", item.mtime)->ioIsSkipped(), item.expSkipped) << item.mtime << ", " << item.sizeRemote;
+        EXPECT_EQ(m_server.getNbRequests("PUT", PATH), item.expSkipped ? 0 : 1) << item.mtime << ", " << item.sizeRemote;
+    }
+}
+
+TEST_F(SkipUnchangedTest, remoteMissing)
+{
+    TransferManager manager;
+    manager.setOptions(TransferManager::OPT_SKIP_UNCHANGED);
+
+    EXPECT_FALSE(upload(manager, m_digest, TIME_REMOTE)->ioIsSkipped());
+    EXPECT_EQ(m_server.getNbRequests("PUT", PATH), 1);
+    EXPECT_EQ(m_server.getRoute(PATH).body, m_data);
+}
+
+TEST_F(SkipUnchangedTest, optionDisabled)
+{
+    setRemote("\"" + m_digestValue + "\"", DATE_REMOTE, m_data.getSize());
+
+    TransferManager manager;
+    EXPECT_FALSE(upload(manager, m_digest, TIME_REMOTE)->ioIsSkipped());
+    EXPECT_EQ(m_server.getNbRequests("HEAD", PATH), 0);
+    EXPECT_EQ(m_server.getNbRequests("PUT", PATH), 1);
+    EXPECT_EQ(manager.getSkipStats().nbChecked, 0);
+}
@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class SubmitTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(1024, 0x01);
+        m_server.setRoute("/fast.bin", route);
+
+        route.body = BytesArray(2048, 0x02);
+        route.delayMs = 400;
+        m_server.setRoute("/slow.bin", route);
+
+        route.code = 404;
+        route.body = BytesArray();
+        route.delayMs = 200;
+        m_server.setRoute("/missing.bin", route);
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(SubmitTest, typeDeduced)
+{
+    TransferManager manager;
+
+    TransferManager::BatchResult result = manager.submit(createDownload("/fast.bin")).get();
+    EXPECT_EQ(result.typeTransfer, Request::TRANSFER_DOWNLOAD);
+    EXPECT_EQ(result.idErr, TransferManager::ERR_NO_ERROR);
+
+    /* A new transfer can be submitted as soon as future is ready */
+    result = manager.submit(createUpload("/uploaded.bin", BytesArray(512, 0x03))).get();
+    EXPECT_EQ(result.typeTransfer, Request::TRANSFER_UPLOAD);
+    EXPECT_EQ(result.idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(m_server.getRoute("/uploaded.bin").body, BytesArray(512, 0x03));
+}
+
+TEST_F(SubmitTest, requestsFutures)
+{
+    TransferManager manager;
+    const Request::List listReqs = {createDownload("/slow.bin"), createDownload("/fast.bin")};
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    auto future = manager.submit(listReqs, listFutures);
+    ASSERT_EQ(listFutures.size(), listReqs.size());
+
+    /* Fast request can be used while slow one is still transferred */
+    EXPECT_EQ(listFutures[1].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listReqs[1]->getData(), m_server.getRoute("/fast.bin").body);
+    EXPECT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listReqs[0]->getData(), m_server.getRoute("/slow.bin").body);
+}
+
+TEST_F(SubmitTest, requestsFuturesOnFailure)
+{
+    TransferManager manager;
+    const Request::List listReqs = {createDownload("/fast.bin"), createDownload("/missing.bin"), createDownload("/slow.bin")};
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    EXPECT_EQ(manager.submit(listReqs, listFutures).get().idErr, TransferManager::ERR_CONTENT_NOT_FOUND);
+
+    ASSERT_EQ(listFutures.size(), listReqs.size());
+    EXPECT_EQ(listFutures[0].get(), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(listFutures[1].get(), TransferManager::ERR_CONTENT_NOT_FOUND);
+
+    /* Requests left incomplete get transfer error */
+    EXPECT_EQ(listFutures[2].get(), TransferManager::ERR_CONTENT_NOT_FOUND);
+}
+
+TEST_F(SubmitTest, preparationErrors)
+{
+    TransferManager manager;
+
+    /* Mixed transfer types */
+    const Request::List listReqs = {createDownload("/fast.bin"), createUpload("/uploaded.bin", BytesArray(512, 0x03))};
+
+    std::vector<std::future<TransferManager::IdError>> listFutures;
+    auto future = manager.submit(listReqs, listFutures);
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_INVALID_REQUEST);
+
+    ASSERT_EQ(listFutures.size(), listReqs.size());
+    for(auto &futureReq : listFutures){
+        EXPECT_EQ(futureReq.get(), TransferManager::ERR_INVALID_REQUEST);
+    }
+
+    /* Manager already busy */
+    auto futureSlow = manager.submit(createDownload("/slow.bin"));
+    auto futureBusy = manager.submit(createDownload("/fast.bin"));
+    ASSERT_EQ(futureBusy.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(futureBusy.get().idErr, TransferManager::ERR_BUSY);
+    EXPECT_EQ(futureSlow.get().idErr, TransferManager::ERR_NO_ERROR);
+}
+
+TEST_F(SubmitTest, continuation)
+{
+    TransferManager manager;
+
+    /* Called from transfer thread, exactly once */
+    std::promise<TransferManager::BatchResult> promise;
+    std::atomic<int> nbCalls{0};
+    manager.submit({createDownload("/fast.bin")}, [&promise, &nbCalls](const TransferManager::BatchResult &result){
+        if(nbCalls++ == 0){
+            promise.set_value(result);
+        }
+    });
+
+    const TransferManager::BatchResult result = promise.get_future().get();
+    EXPECT_EQ(result.idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(result.typeTransfer, Request::TRANSFER_DOWNLOAD);
+
+    /* Called right away on preparation error */
+    TransferManager::IdError idErr = TransferManager::ERR_NO_ERROR;
+    manager.submit(Request::List{}, [&idErr, &nbCalls](const TransferManager::BatchResult &result){
+        ++nbCalls;
+        idErr = result.idErr;
+    });
+    EXPECT_NE(idErr, TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(nbCalls, 2);
+}
@@ -0,0 +1,197 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+#include <thread>
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+using Url = tease::Url;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class TransferNowTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        TestsServer::Route route;
+        route.body = BytesArray(2048, 0x21);
+        m_server.setRoute("/fast.bin", route);
+
+        route.delayMs = 3000;
+        m_server.setRoute("/slow.bin", route);
+
+        // Batch requests take about half a second
+        route.delayMs = 0;
+        route.sizeChunk = 256;
+        route.delayChunkMs = 60;
+        for(int i = 0; i < 4; ++i){
+            m_server.setRoute(getPathBatch(i), route);
+        }
+
+        route = TestsServer::Route();
+        for(int code : {401, 404, 503}){
+            route.code = code;
+            m_server.setRoute(getPathError(code), route);
+        }
+    }
+
+    static std::string getPathBatch(int idRoute)
+    {
+        return "/batch" + std::to_string(idRoute) + ".bin";
+    }
+
+    static std::string getPathError(int code)
+    {
+        return "/error" + std::to_string(code) + ".bin";
+    }
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(TransferNowTest, download)
+{
+    TransferManager manager;
+
+    Request::PtrShared req = createDownload("/fast.bin");
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/fast.bin").body);
+    EXPECT_EQ(req->ioGetNbTrials(), 0);
+
+    /* Request can be transferred again */
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/fast.bin").body);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/fast.bin"), 2);
+}
+
+TEST_F(TransferNowTest, upload)
+{
+    TransferManager manager;
+
+    const BytesArray data(4096, 0x3C);
+    EXPECT_EQ(manager.transferNow(createUpload("/uploaded.bin", data)), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(m_server.getRoute("/uploaded.bin").body, data);
+}
+
+TEST_F(TransferNowTest, retry)
+{
+    TransferManager manager;
+    manager.setNbMaxTrials(2);
+
+    /* Server errors are retried on same URL */
+    Request::PtrShared req = createDownload(getPathError(503));
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_MAX_TRIALS);
+    EXPECT_EQ(m_server.getNbRequests("GET", getPathError(503)), 1 + 2);
+
+    /* Until one succeed */
+    TestsServer::Route route = m_server.getRoute("/fast.bin");
+    route.nbErrors = 1;
+    m_server.setRoute("/flaky.bin", route);
+
+    req = createDownload("/flaky.bin");
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), route.body);
+    EXPECT_EQ(req->ioGetNbTrials(), 1);
+}
+
+TEST_F(TransferNowTest, failover)
+{
+    TransferManager manager;
+
+    Request::PtrShared req = createDownload(getPathError(503));
+    req->setMirrors({m_server.createUrl("/fast.bin")});
+
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_NO_ERROR);
+    EXPECT_EQ(req->getData(), m_server.getRoute("/fast.bin").body);
+    EXPECT_EQ(req->ioGetNbFailovers(), 1);
+    EXPECT_EQ(req->ioGetUrl().toString(), m_server.createUrl("/fast.bin").toString());
+}
+
+TEST_F(TransferNowTest, errorMapping)
+{
+    TransferManager manager;
+    manager.setNbMaxTrials(2);
+
+    /* Client errors are reported at once, without retry nor failover */
+    struct Case
+    {
+        int code;
+        TransferManager::IdError idErr;
+    };
+
+    for(const Case &item : {Case{404, TransferManager::ERR_CONTENT_NOT_FOUND}, Case{401, TransferManager::ERR_INVALID_LOGIN}}){
+        Request::PtrShared req = createDownload(getPathError(item.code));
+        req->setMirrors({m_server.createUrl("/fast.bin")});
+
+        EXPECT_EQ(manager.transferNow(req), item.idErr) << item.code;
+        EXPECT_EQ(m_server.getNbRequests("GET", getPathError(item.code)), 1) << item.code;
+    }
+    EXPECT_EQ(m_server.getNbRequests("GET", "/fast.bin"), 0);
+
+    /* Invalid request is never transferred */
+    EXPECT_EQ(manager.transferNow(std::make_shared<Request>()), TransferManager::ERR_INVALID_REQUEST);
+}
+
+TEST_F(TransferNowTest, deadline)
+{
+    TransferManager manager;
+
+    /* Transfer is stopped once deadline is reached */
+    Request::PtrShared req = createDownload("/slow.bin");
+    req->setDeadline(Request::Clock::now() + std::chrono::milliseconds(300));
+
+    const Request::TimePoint tsStart = Request::Clock::now();
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_DEADLINE_EXCEEDED);
+    EXPECT_LT(getElapsed(tsStart), 1.5);
+
+    /* Retries are not performed past deadline */
+    manager.setNbMaxTrials(5);
+    req = createDownload(getPathError(503));
+    req->setDeadline(Request::Clock::now() - std::chrono::milliseconds(1));
+
+    EXPECT_EQ(manager.transferNow(req), TransferManager::ERR_DEADLINE_EXCEEDED);
+    EXPECT_LE(m_server.getNbRequests("GET", getPathError(503)), 1);
+}
+
+TEST_F(TransferNowTest, duringBatch)
+{
+    TransferManager manager;
+
+    Request::List listReqs;
+    for(int i = 0; i < 4; ++i){
+        listReqs.push_back(createDownload(getPathBatch(i)));
+    }
+    auto future = manager.submit(listReqs);
+
+    /* Synchronous transfers don't wait for the batch, from any thread */
+    std::atomic<int> nbFailed{0};
+    auto performNow = [this, &manager, &nbFailed](int nbReqs){
+        for(int i = 0; i < nbReqs; ++i){
+            Request::PtrShared req = createDownload("/fast.bin");
+            if(manager.transferNow(req) != TransferManager::ERR_NO_ERROR || req->getData() != m_server.getRoute("/fast.bin").body){
+                ++nbFailed;
+            }
+        }
+    };
+
+    std::thread thread(performNow, 10);
+    performNow(10);
+    thread.join();
+
+    EXPECT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(nbFailed, 0);
+    EXPECT_EQ(m_server.getNbRequests("GET", "/fast.bin"), 20);
+
+    EXPECT_EQ(future.get().idErr, TransferManager::ERR_NO_ERROR);
+    for(int i = 0; i < 4; ++i){
+        EXPECT_EQ(listReqs[i]->getData(), m_server.getRoute(getPathBatch(i)).body) << i;
+    }
+}
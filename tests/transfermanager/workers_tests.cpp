@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "transferease/transfermanager.h"
+
+#include "testsserver.h"
+
+using TransferManager = tease::TransferManager;
+using Request = tease::Request;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class WorkersTest : public TransferTest
+{
+protected:
+    void setRoutes() override
+    {
+        /* Requests of very different durations, so that some workers run out of requests first */
+        for(int i = 0; i < NB_ROUTES; ++i){
+            TestsServer::Route route;
+            route.body = BytesArray(1024 + i * 97, static_cast<BytesArray::Byte>(i));
+            route.delayMs = (i % 4 == 0) ? 50 : 0;
+
+            m_server.setRoute(getPath(i), route);
+        }
+    }
+
+    static std::string getPath(int idRoute)
+    {
+        return "/file" + std::to_string(idRoute) + ".bin";
+    }
+
+    Request::List createRequests(int nbReqs) const
+    {
+        Request::List listReqs;
+        for(int i = 0; i < nbReqs; ++i){
+            listReqs.push_back(createDownload(getPath(i)));
+        }
+
+        return listReqs;
+    }
+
+    void verifyRequests(const Request::List &listReqs) const
+    {
+        for(size_t i = 0; i < listReqs.size(); ++i){
+            const std::string path = getPath(static_cast<int>(i));
+
+            EXPECT_EQ(listReqs[i]->getData(), m_server.getRoute(path).body) << path;
+            EXPECT_EQ(m_server.getNbRequests("GET", path), 1) << path;
+        }
+    }
+
+protected:
+    static constexpr int NB_ROUTES = 64;
+};
+
+/*****************************/
+/* Defines test routines
+ * (using TEST_F())          */
+/*****************************/
+
+TEST_F(WorkersTest, singleWorker)
+{
+    TransferManager manager;
+    manager.setNbWorkers(1);
+
+    const Request::List listReqs = createRequests(NB_ROUTES);
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+
+    verifyRequests(listReqs);
+}
+
+TEST_F(WorkersTest, stealRequests)
+{
+    TransferManager manager;
+    manager.setNbWorkers(4);
+    manager.setNbMaxTransfersPerHost(2);
+
+    /* Each request must be performed exactly once, whatever the worker performing it */
+    const Request::List listReqs = createRequests(NB_ROUTES);
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+
+    verifyRequests(listReqs);
+}
+
+TEST_F(WorkersTest, moreWorkersThanRequests)
+{
+    TransferManager manager;
+    manager.setNbWorkers(8);
+
+    const Request::List listReqs = createRequests(3);
+    EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+
+    verifyRequests(listReqs);
+}
+
+TEST_F(WorkersTest, successiveBatches)
+{
+    TransferManager manager;
+    manager.setNbWorkers(4);
+
+    for(int i = 0; i < 3; ++i){
+        m_server.resetNbRequests();
+
+        const Request::List listReqs = createRequests(NB_ROUTES);
+        EXPECT_EQ(transfer(manager, listReqs), TransferManager::ERR_NO_ERROR);
+
+        verifyRequests(listReqs);
+    }
+}